@@ -0,0 +1,160 @@
+#ifndef _ASYNC_CALL_H_
+#define _ASYNC_CALL_H_
+
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Completion callback of the asynchronous exports.
+   *
+   * Called once with the cookie given by the caller, usually on the SDK thread.
+   * On success result is call<>::result_success and value points to the
+   * translated result, or is nullptr when there is none, and is only valid
+   * until the callback returns. On failure result is the error_code of the
+   * exception and error holds its message.
+   */
+  using completion_type = void (*)(std::intptr_t cookie, int result, void* value, int count, const char* error);
+
+  /**
+   * @brief Result of an asynchronous export, handed to the body of an async_call.
+   */
+  class completion {
+  public:
+    completion(completion_type done, std::intptr_t cookie) : done_(done), cookie_(cookie) {}
+
+    void succeed(void* value = nullptr, int count = 0) const {
+      done_(cookie_, call<>::result_success, value, count, nullptr);
+    }
+
+    // Recorded as the last error of the completing thread, whose buffer holds the message
+    void fail(std::exception_ptr e) const {
+      last_error& error = last_error::current();
+      error.set(std::move(e));
+      done_(cookie_, to_underlying(error.code), nullptr, 0, error.message);
+    }
+
+    auto failed() const {
+      return [c = *this](std::exception_ptr&& e) { c.fail(std::move(e)); };
+    }
+
+    /**
+     * @brief Completes once the operation completes, discarding its value.
+     */
+    template<typename T> void attach(dolbyio::comms::async_result<T>&& result) const {
+      if constexpr (std::is_void_v<T>) {
+        std::move(result)
+          .then([c = *this]() { c.succeed(); })
+          .on_error(failed());
+      } else {
+        std::move(result)
+          .then([c = *this](T&&) { c.succeed(); })
+          .on_error(failed());
+      }
+    }
+
+    /**
+     * @brief Completes with translate(scope, value, count) once the operation
+     * completes, the C structs being allocated in the event arena of the SDK thread.
+     */
+    template<typename T, typename Translate> void attach(dolbyio::comms::async_result<T>&& result, Translate translate) const {
+      std::move(result)
+        .then([c = *this, translate](T&& value) {
+          c.complete(value, translate);
+        })
+        .on_error(failed());
+    }
+
+    /**
+     * @brief Completes at once with translate(scope, value, count), for a value
+     * already at hand such as a cached one.
+     */
+    template<typename T, typename Translate> void complete(const T& value, Translate translate) const {
+      event_scope scope;
+      int count = 0;
+      void* translated = nullptr;
+      try {
+        translated = translate(scope, value, count);
+      } catch (...) {
+        fail(std::current_exception());
+        return;
+      }
+
+      succeed(translated, count);
+    }
+
+  private:
+    completion_type done_;
+    std::intptr_t   cookie_;
+  };
+
+  /**
+   * @brief Translates a result into a single F struct, nullptr for an empty optional.
+   */
+  template<typename F> struct as_struct {
+    template<typename T> void* operator()(event_scope& scope, const T& value, int& count) const {
+      F* f = scope.allocate<F>(1);
+      scope.no_alloc_to_c(f, value);
+      count = 1;
+      return f;
+    }
+
+    template<typename T> void* operator()(event_scope& scope, const std::optional<T>& value, int& count) const {
+      return value ? (*this)(scope, *value, count) : nullptr;
+    }
+  };
+
+  /**
+   * @brief Translates a vector result into a contiguous array of F structs.
+   */
+  template<typename F> struct as_array {
+    template<typename T> void* operator()(event_scope& scope, const std::vector<T>& values, int& count) const {
+      F* f = scope.allocate<F>(values.size());
+      for (size_t i = 0; i < values.size(); i++) {
+        scope.no_alloc_to_c(&f[i], values[i]);
+      }
+
+      count = (int)values.size();
+      return f;
+    }
+  };
+
+  /**
+   * @brief Non-blocking counterpart of call, for the exports completing through a completion_type.
+   *
+   * The body starts the operation and attaches it to the completion it is given.
+   * If the body throws before that, result() returns call<>::result_error and the
+   * completion is never called. Mocks complete at once, without a value.
+   */
+  template<typename Exception = std::exception>
+  struct async_call {
+  public:
+    template<typename F> async_call(completion_type done, std::intptr_t cookie, const F& f) {
+#ifndef MOCK
+      try {
+        f(completion(done, cookie));
+        result_ = call<>::result_success;
+      } catch (const Exception& e) {
+        last_error::current().set(e);
+        result_ = call<>::result_error;
+      }
+#else
+      completion(done, cookie).succeed();
+      result_ = call<>::result_success;
+#endif
+    }
+
+    int result() { return result_; }
+
+  private:
+    int result_;
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _ASYNC_CALL_H_
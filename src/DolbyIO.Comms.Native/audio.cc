@@ -9,35 +9,71 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int MuteAsync(bool muted, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->conference().mute(muted));
+    }}.result();
+  }
+
   EXPORT_API int RemoteMute(bool muted, char* participant_id) {
     return call { [&]() {
       wait(sdk->conference().remote_mute(muted, std::string(participant_id)));
     }}.result();
   }
 
+  EXPORT_API int RemoteMuteAsync(bool muted, char* participant_id, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->conference().remote_mute(muted, std::string(participant_id)));
+    }}.result();
+  }
+
   EXPORT_API int StartAudio() {
     return call { [&]() {
       wait(sdk->audio().local().start());
     }}.result();
   }
 
+  EXPORT_API int StartAudioAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->audio().local().start());
+    }}.result();
+  }
+
   EXPORT_API int StopAudio() {
     return call { [&]() {
       wait(sdk->audio().local().stop());
     }}.result();
   }
 
+  EXPORT_API int StopAudioAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->audio().local().stop());
+    }}.result();
+  }
+
     EXPORT_API int StartRemoteAudio(char* participant_id) {
     return call { [&]() {
       wait(sdk->audio().remote().start(std::string(participant_id)));
     }}.result();
   }
 
+  EXPORT_API int StartRemoteAudioAsync(char* participant_id, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->audio().remote().start(std::string(participant_id)));
+    }}.result();
+  }
+
   EXPORT_API int StopRemoteAudio(char* participant_id) {
     return call { [&]() {
       wait(sdk->audio().remote().stop(std::string(participant_id)));
     }}.result();
   }
 
+  EXPORT_API int StopRemoteAudioAsync(char* participant_id, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->audio().remote().stop(std::string(participant_id)));
+    }}.result();
+  }
+
 } // extern "C"
 } // namespace dolbyio::comms::native
\ No newline at end of file
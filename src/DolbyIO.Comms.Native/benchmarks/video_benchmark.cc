@@ -0,0 +1,391 @@
+#include "../rgba_to_yuv.h"
+#include "../video_sink.h"
+#include "../video_source.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Counts the operator new allocations of the whole process, reported per frame.
+// The frame buffers come from malloc, their pool reporting its misses instead.
+static std::atomic<uint64_t> allocation_count{ 0 };
+
+void* operator new(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+
+namespace dolbyio::comms::native::benchmarks {
+
+  using bench_clock = std::chrono::steady_clock;
+
+  struct sample_set {
+    sample_set(int frames) {
+      latencies_us.reserve(frames);
+    }
+
+    std::vector<double> latencies_us;
+    uint64_t            allocations = 0;
+    uint64_t            pool_hits = 0;
+    uint64_t            pool_misses = 0;
+
+    // Adds the buffers acquired from the pool since before
+    void count_pool(const frame_buffer_pool_stats& before, const frame_buffer_pool_stats& after) {
+      pool_hits += after.hits - before.hits;
+      pool_misses += after.misses - before.misses;
+    }
+  };
+
+  static double percentile(const std::vector<double>& sorted, double p) {
+    size_t index = std::min(sorted.size() - 1, (size_t)(p / 100.0 * sorted.size()));
+    return sorted[index];
+  }
+
+  /**
+   * @brief Prints one result as a JSON object on its own line.
+   */
+  static void report(const std::string& benchmark, const std::string& variant, int width, int height, int padding, sample_set& samples) {
+    auto& latencies = samples.latencies_us;
+    std::sort(latencies.begin(), latencies.end());
+
+    double total_us = 0;
+    for (double latency : latencies) {
+      total_us += latency;
+    }
+
+    double fps = total_us > 0 ? latencies.size() * 1000000.0 / total_us : 0;
+    printf("{\"benchmark\":\"%s\",\"variant\":\"%s\",\"width\":%d,\"height\":%d,\"padding\":%d,\"frames\":%zu,"
+           "\"fps\":%.1f,\"megapixels_per_s\":%.1f,\"p50_us\":%.1f,\"p90_us\":%.1f,\"p99_us\":%.1f,\"max_us\":%.1f,"
+           "\"allocations_per_frame\":%.2f,\"pool_hits_per_frame\":%.2f,\"pool_misses_per_frame\":%.2f}\n",
+      benchmark.c_str(), variant.c_str(), width, height, padding, latencies.size(),
+      fps, fps * width * height / 1000000.0,
+      percentile(latencies, 50), percentile(latencies, 90), percentile(latencies, 99), latencies.back(),
+      (double)samples.allocations / latencies.size(),
+      (double)samples.pool_hits / latencies.size(), (double)samples.pool_misses / latencies.size());
+    fflush(stdout);
+  }
+
+  /**
+   * @brief Random I420 or NV12 planes with padded strides.
+   */
+  struct synthetic_planes {
+    synthetic_planes(yuv_chroma_layout layout, int w, int h, int padding) : width(w), height(h) {
+      int chroma_width = (width + 1) / 2;
+      int chroma_height = (height + 1) / 2;
+
+      y_stride = width + padding;
+      uv_stride = (layout == yuv_chroma_layout::i420 ? chroma_width : 2 * chroma_width) + padding;
+
+      size_t chroma_size = (size_t)uv_stride * chroma_height;
+      data.resize((size_t)y_stride * height + 2 * chroma_size);
+
+      std::mt19937 rng(width * 31 + height);
+      for (auto& byte : data) {
+        byte = (uint8_t)rng();
+      }
+
+      y = data.data();
+      u = y + (size_t)y_stride * height;
+      v = u + chroma_size;
+    }
+
+    int                  width, height;
+    int                  y_stride, uv_stride;
+    std::vector<uint8_t> data;
+    const uint8_t*       y;
+    const uint8_t*       u;
+    const uint8_t*       v;
+  };
+
+  static const char* simd_name(yuv_simd simd) {
+    switch (simd) {
+      case yuv_simd::sse2: return "sse2";
+      case yuv_simd::avx2: return "avx2";
+      case yuv_simd::neon: return "neon";
+      default: return "std";
+    }
+  }
+
+  /**
+   * @brief Times a converter on the same frame, the scalar ones by their name
+   * and the vectorized one picked for this CPU.
+   */
+  static void bench_kernel(yuv_chroma_layout layout, yuv_simd simd, int width, int height, int padding, int frames) {
+    synthetic_planes planes(layout, width, height, padding);
+    uint32_t rgb_stride = width * 4 + padding;
+    std::vector<uint8_t> rgb((size_t)rgb_stride * height);
+
+    const char* names[] = { "yuv420_rgb24", "nv12_rgb24", "nv21_rgb24" };
+    std::string name = names[(int)layout];
+
+    sample_set samples(frames);
+    for (int i = 0; i < frames + 2; i++) {
+      uint64_t allocations = allocation_count.load(std::memory_order_relaxed);
+      auto start = bench_clock::now();
+
+      if (simd != yuv_simd::none) {
+        yuv_rgb24(simd, layout, width, height, planes.y, planes.u, planes.v, planes.y_stride, planes.uv_stride,
+          rgb.data(), rgb_stride, ycbcr_type::ycbcr_jpeg);
+      } else if (layout == yuv_chroma_layout::i420) {
+        yuv420_rgb24_std(width, height, planes.y, planes.u, planes.v, planes.y_stride, planes.uv_stride,
+          rgb.data(), rgb_stride, ycbcr_type::ycbcr_jpeg);
+      } else if (layout == yuv_chroma_layout::nv12) {
+        nv12_rgb24_std(width, height, planes.y, planes.u, planes.y_stride, planes.uv_stride,
+          rgb.data(), rgb_stride, ycbcr_type::ycbcr_jpeg);
+      } else {
+        nv21_rgb24_std(width, height, planes.y, planes.u, planes.y_stride, planes.uv_stride,
+          rgb.data(), rgb_stride, ycbcr_type::ycbcr_jpeg);
+      }
+
+      auto elapsed = std::chrono::duration<double, std::micro>(bench_clock::now() - start).count();
+
+      // The first two runs warm the caches up
+      if (i >= 2) {
+        samples.latencies_us.push_back(elapsed);
+        samples.allocations += allocation_count.load(std::memory_order_relaxed) - allocations;
+      }
+    }
+
+    report(name + "_" + simd_name(simd), "", width, height, padding, samples);
+  }
+
+  /**
+   * @brief Times a converter from 32 bit pixels on the same random frame, the
+   * scalar reference and the vectorized one picked for this CPU.
+   */
+  static void bench_encode_kernel(rgb32_order order, yuv_chroma_layout layout, yuv_simd simd, int width, int height, int padding, int frames) {
+    uint32_t rgb_stride = width * 4 + padding;
+    std::vector<uint8_t> rgb((size_t)rgb_stride * height);
+    std::mt19937 rng(width * 31 + height);
+    for (auto& byte : rgb) {
+      byte = (uint8_t)rng();
+    }
+
+    int chroma_width = (width + 1) / 2;
+    int chroma_height = (height + 1) / 2;
+    uint32_t y_stride = width + padding;
+    uint32_t uv_stride = (layout == yuv_chroma_layout::i420 ? chroma_width : 2 * chroma_width) + padding;
+    std::vector<uint8_t> yuv((size_t)y_stride * height + 2 * (size_t)uv_stride * chroma_height);
+    uint8_t* u = yuv.data() + (size_t)y_stride * height;
+    uint8_t* v = u + (size_t)uv_stride * chroma_height;
+
+    const char* orders[] = { "argb", "rgba", "bgra" };
+    const char* layouts[] = { "i420", "nv12", "nv21" };
+    std::string name = std::string(orders[(int)order]) + "_" + layouts[(int)layout];
+
+    sample_set samples(frames);
+    for (int i = 0; i < frames + 2; i++) {
+      uint64_t allocations = allocation_count.load(std::memory_order_relaxed);
+      auto start = bench_clock::now();
+
+      rgb32_yuv(simd, order, layout, width, height, rgb.data(), rgb_stride, yuv.data(), u, v, y_stride, uv_stride, ycbcr_type::ycbcr_601);
+
+      auto elapsed = std::chrono::duration<double, std::micro>(bench_clock::now() - start).count();
+
+      // The first two runs warm the caches up
+      if (i >= 2) {
+        samples.latencies_us.push_back(elapsed);
+        samples.allocations += allocation_count.load(std::memory_order_relaxed) - allocations;
+      }
+    }
+
+    report(name + "_" + simd_name(simd), "", width, height, padding, samples);
+  }
+
+  class synthetic_i420 : public video_frame_i420 {
+  public:
+    synthetic_i420(const synthetic_planes& planes) : planes_(planes) {}
+
+    const uint8_t* get_y() const override { return planes_.y; }
+    const uint8_t* get_u() const override { return planes_.u; }
+    const uint8_t* get_v() const override { return planes_.v; }
+    int stride_y() const override { return planes_.y_stride; }
+    int stride_u() const override { return planes_.uv_stride; }
+    int stride_v() const override { return planes_.uv_stride; }
+
+  private:
+    const synthetic_planes& planes_;
+  };
+
+  /**
+   * @brief Decoded frame viewing shared I420 planes, as handed over by the media engine.
+   */
+  class synthetic_frame : public video_frame {
+  public:
+    synthetic_frame(const synthetic_planes& planes, int64_t timestamp_us)
+      : planes_(planes), i420_(planes), timestamp_us_(timestamp_us) {}
+
+    int width() const override { return planes_.width; }
+    int height() const override { return planes_.height; }
+    int64_t timestamp_us() const override { return timestamp_us_; }
+    video_frame_i420* get_i420_frame() override { return &i420_; }
+#if defined(__APPLE__)
+    video_frame_macos* get_native_frame() override { return nullptr; }
+#endif
+
+  private:
+    const synthetic_planes& planes_;
+    synthetic_i420          i420_;
+    int64_t                 timestamp_us_;
+  };
+
+  static void release_frame(const video_sink_frame* frame) {
+    frame_buffer_pool::release(frame->buffer);
+  }
+
+  /**
+   * @brief Times video_sink::handle_frame on synthetic I420 frames, from the
+   * frame hand over to the return of the delegate.
+   */
+  static void bench_sink(pixel_format format, int width, int height, int target_width, int target_height, int frames) {
+    synthetic_planes planes(yuv_chroma_layout::i420, width, height, 0);
+    video_sink sink(release_frame, format, target_width, target_height);
+
+    const char* names[] = { "argb8888", "rgba8888", "bgra8888", "i420", "nv12", "y8" };
+    std::string variant = names[format];
+    if (target_width > 0) {
+      variant += "_fit_" + std::to_string(target_width) + "x" + std::to_string(target_height);
+    }
+
+    sample_set samples(frames);
+    for (int i = 0; i < frames + 2; i++) {
+      std::unique_ptr<video_frame> frame = std::make_unique<synthetic_frame>(planes, i * 33333);
+
+      uint64_t allocations = allocation_count.load(std::memory_order_relaxed);
+      auto pool_stats = sink.pool().stats();
+      auto start = bench_clock::now();
+
+      sink.handle_frame(std::move(frame));
+
+      auto elapsed = std::chrono::duration<double, std::micro>(bench_clock::now() - start).count();
+
+      // The first two frames fill the buffer pool up
+      if (i >= 2) {
+        samples.latencies_us.push_back(elapsed);
+        samples.allocations += allocation_count.load(std::memory_order_relaxed) - allocations;
+        samples.count_pool(pool_stats, sink.pool().stats());
+      }
+    }
+
+    report("video_sink_handle_frame", variant, width, height, 0, samples);
+  }
+
+  // Stands for the SDK encoder, dropping the frames right away
+  class null_encoder : public dolbyio::comms::video_sink {
+  public:
+    void handle_frame(std::unique_ptr<video_frame>) override {}
+  };
+
+  /**
+   * @brief Times video_source::push of RGBA8888 frames, from the push to the
+   * return of the encoder sink.
+   */
+  static void bench_source(int width, int height, int frames) {
+    uint32_t stride = width * 4;
+    std::vector<uint8_t> rgba((size_t)stride * height);
+    std::mt19937 rng(width * 31 + height);
+    for (auto& byte : rgba) {
+      byte = (uint8_t)rng();
+    }
+
+    null_encoder encoder;
+    video_source source;
+    source.set_sink(&encoder, dolbyio::comms::video_source::config{});
+
+    sample_set samples(frames);
+    for (int i = 0; i < frames + 2; i++) {
+      uint64_t allocations = allocation_count.load(std::memory_order_relaxed);
+      auto pool_stats = source.pool().stats();
+      auto start = bench_clock::now();
+
+      source.push(RGBA8888, width, height, rgba.data(), stride, i * 33333);
+
+      auto elapsed = std::chrono::duration<double, std::micro>(bench_clock::now() - start).count();
+
+      // The first two frames fill the buffer pool up
+      if (i >= 2) {
+        samples.latencies_us.push_back(elapsed);
+        samples.allocations += allocation_count.load(std::memory_order_relaxed) - allocations;
+        samples.count_pool(pool_stats, source.pool().stats());
+      }
+    }
+
+    source.set_sink(nullptr, dolbyio::comms::video_source::config{});
+    report("video_source_push", "rgba8888", width, height, 0, samples);
+  }
+
+  static int run(int frames) {
+    struct size { int width, height, padding; };
+    const size sizes[] = {
+      { 640, 360, 0 },
+      { 1280, 720, 0 },
+      { 1920, 1080, 0 },
+      { 3840, 2160, 0 },
+      { 1279, 719, 0 },   // Odd sizes
+      { 1920, 1080, 64 }, // Padded strides
+    };
+
+    yuv_simd simd = yuv_simd_detect();
+    for (auto layout : { yuv_chroma_layout::i420, yuv_chroma_layout::nv12, yuv_chroma_layout::nv21 }) {
+      for (auto& s : sizes) {
+        bench_kernel(layout, yuv_simd::none, s.width, s.height, s.padding, frames);
+        if (simd != yuv_simd::none) {
+          bench_kernel(layout, simd, s.width, s.height, s.padding, frames);
+        }
+      }
+    }
+
+    // The encode side, for rendered frames and for platform capture buffers
+    for (auto path : { std::pair{ rgb32_order::rgba, yuv_chroma_layout::i420 }, std::pair{ rgb32_order::bgra, yuv_chroma_layout::nv12 } }) {
+      for (auto& s : sizes) {
+        bench_encode_kernel(path.first, path.second, yuv_simd::none, s.width, s.height, s.padding, frames);
+        if (simd != yuv_simd::none) {
+          bench_encode_kernel(path.first, path.second, simd, s.width, s.height, s.padding, frames);
+        }
+      }
+    }
+
+    for (auto& s : { size{ 1280, 720, 0 }, size{ 1920, 1080, 0 } }) {
+      for (auto format : { ARGB8888, RGBA8888, I420, NV12, Y8 }) {
+        bench_sink(format, s.width, s.height, 0, 0, frames);
+      }
+      bench_sink(ARGB8888, s.width, s.height, 640, 360, frames);
+      bench_source(s.width, s.height, frames);
+    }
+
+    return 0;
+  }
+
+} // namespace dolbyio::comms::native::benchmarks
+
+/**
+ * Usage: DolbyIO.Comms.Native.Benchmarks [frames]
+ *
+ * Prints one JSON object per line for every benchmark, see report().
+ */
+int main(int argc, char* argv[]) {
+  int frames = argc > 1 ? std::atoi(argv[1]) : 100;
+  if (frames <= 0) {
+    fprintf(stderr, "Usage: %s [frames]\n", argv[0]);
+    return 1;
+  }
+
+  return dolbyio::comms::native::benchmarks::run(frames);
+}
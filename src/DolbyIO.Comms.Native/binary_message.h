@@ -0,0 +1,384 @@
+#ifndef _BINARY_MESSAGE_H_
+#define _BINARY_MESSAGE_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief LZ4 block format compression, for the binary conference messages.
+   *
+   * The compressor is the greedy single pass of the reference implementation,
+   * trading ratio for speed. The decompressor checks every length and offset
+   * against its buffers, as the blocks come from other participants.
+   */
+  struct lz4_block {
+    /**
+     * @brief Appends the compressed size bytes of src to out.
+     */
+    static void compress(const uint8_t* src, size_t size, std::string& out) {
+      static constexpr size_t min_match = 4;
+      static constexpr size_t last_literals = 5;   // The block always ends with literals
+      static constexpr size_t match_limit = 12;    // No match starts this close to the end
+      static constexpr int hash_bits = 12;
+
+      uint32_t table[1 << hash_bits] = {};         // Position + 1 of the last sequence with the hash
+      size_t anchor = 0;
+
+      if (size > match_limit) {
+        for (size_t i = 0; i < size - match_limit;) {
+          uint32_t sequence = read32(src + i);
+          uint32_t hash = (sequence * 2654435761u) >> (32 - hash_bits);
+          size_t candidate = table[hash];
+          table[hash] = (uint32_t)(i + 1);
+
+          if (candidate == 0 || i - (candidate - 1) > 0xFFFF || read32(src + candidate - 1) != sequence) {
+            i++;
+            continue;
+          }
+
+          size_t match = candidate - 1;
+          size_t length = min_match;
+          while (i + length < size - last_literals && src[match + length] == src[i + length]) {
+            length++;
+          }
+
+          write_sequence(src + anchor, i - anchor, i - match, length - min_match, out);
+          i += length;
+          anchor = i;
+        }
+      }
+
+      write_literals(src + anchor, size - anchor, out);
+    }
+
+    /**
+     * @brief Decompresses a block into exactly size bytes of out.
+     *
+     * @return false if the block is malformed or does not hold size bytes.
+     */
+    static bool decompress(const uint8_t* src, size_t src_size, uint8_t* out, size_t size) {
+      const uint8_t* end = src + src_size;
+      size_t written = 0;
+
+      while (src < end) {
+        uint8_t token = *src++;
+
+        size_t literals = token >> 4;
+        if (literals == 15 && !read_length(src, end, literals)) {
+          return false;
+        }
+
+        if ((size_t)(end - src) < literals || size - written < literals) {
+          return false;
+        }
+
+        std::memcpy(out + written, src, literals);
+        src += literals;
+        written += literals;
+
+        // The last sequence has no match
+        if (src == end) {
+          break;
+        }
+
+        if (end - src < 2) {
+          return false;
+        }
+
+        size_t offset = src[0] | (src[1] << 8);
+        src += 2;
+        if (offset == 0 || offset > written) {
+          return false;
+        }
+
+        size_t length = token & 0x0F;
+        if (length == 15 && !read_length(src, end, length)) {
+          return false;
+        }
+
+        length += 4;
+        if (size - written < length) {
+          return false;
+        }
+
+        // Byte by byte, as the match may overlap what it copies
+        for (size_t i = 0; i < length; i++, written++) {
+          out[written] = out[written - offset];
+        }
+      }
+
+      return written == size;
+    }
+
+  private:
+    static uint32_t read32(const uint8_t* p) {
+      uint32_t v;
+      std::memcpy(&v, p, sizeof(v));
+      return v;
+    }
+
+    static void write_length(size_t length, std::string& out) {
+      for (; length >= 255; length -= 255) {
+        out.push_back((char)255);
+      }
+      out.push_back((char)length);
+    }
+
+    static bool read_length(const uint8_t*& src, const uint8_t* end, size_t& length) {
+      uint8_t b;
+      do {
+        if (src == end) {
+          return false;
+        }
+        b = *src++;
+        length += b;
+      } while (b == 255);
+      return true;
+    }
+
+    static void write_sequence(const uint8_t* literals, size_t count, size_t offset, size_t match_length, std::string& out) {
+      out.push_back((char)((std::min<size_t>(count, 15) << 4) | std::min<size_t>(match_length, 15)));
+      if (count >= 15) {
+        write_length(count - 15, out);
+      }
+
+      out.append((const char*)literals, count);
+      out.push_back((char)(offset & 0xFF));
+      out.push_back((char)(offset >> 8));
+
+      if (match_length >= 15) {
+        write_length(match_length - 15, out);
+      }
+    }
+
+    static void write_literals(const uint8_t* literals, size_t count, std::string& out) {
+      out.push_back((char)(std::min<size_t>(count, 15) << 4));
+      if (count >= 15) {
+        write_length(count - 15, out);
+      }
+
+      out.append((const char*)literals, count);
+    }
+  };
+
+  /**
+   * @brief Z85 encoding, which packs 4 bytes into 5 printable characters that
+   * need no escaping in the JSON the SDK sends the messages in.
+   *
+   * A trailing group of n bytes is written as its first n + 1 characters.
+   */
+  struct z85 {
+    static constexpr const char* alphabet =
+      "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+
+    static size_t encoded_size(size_t size) {
+      return size / 4 * 5 + (size % 4 ? size % 4 + 1 : 0);
+    }
+
+    // Size of the bytes text decodes to, text being of a valid length
+    static size_t decoded_size(size_t length) {
+      return length / 5 * 4 + (length % 5 ? length % 5 - 1 : 0);
+    }
+
+    static void encode(const uint8_t* data, size_t size, std::string& out) {
+      for (size_t i = 0; i < size; i += 4) {
+        size_t n = std::min<size_t>(4, size - i);
+        uint32_t value = 0;
+        for (size_t j = 0; j < 4; j++) {
+          value = (value << 8) | (j < n ? data[i + j] : 0);
+        }
+
+        char group[5];
+        for (int j = 4; j >= 0; j--) {
+          group[j] = alphabet[value % 85];
+          value /= 85;
+        }
+
+        out.append(group, n < 4 ? n + 1 : 5);
+      }
+    }
+
+    /**
+     * @brief Decodes text into out, which holds decoded_size(text.size()) bytes.
+     */
+    static bool decode(std::string_view text, uint8_t* out) {
+      if (text.size() % 5 == 1) {
+        return false;
+      }
+
+      for (size_t i = 0; i < text.size(); i += 5) {
+        size_t n = std::min<size_t>(5, text.size() - i);
+        uint64_t value = 0;
+        for (size_t j = 0; j < 5; j++) {
+          int digit = j < n ? index(text[i + j]) : 84;
+          if (digit < 0) {
+            return false;
+          }
+          value = 85 * value + digit;
+        }
+
+        if (value > 0xFFFFFFFF) {
+          return false;
+        }
+
+        for (size_t j = 0; j + 1 < n; j++) {
+          *out++ = (uint8_t)(value >> (24 - 8 * j));
+        }
+      }
+
+      return true;
+    }
+
+  private:
+    static int index(char c) {
+      static const auto indices = []() {
+        std::array<int8_t, 256> table;
+        table.fill(-1);
+        for (int i = 0; i < 85; i++) {
+          table[(uint8_t)alphabet[i]] = (int8_t)i;
+        }
+        return table;
+      }();
+
+      return indices[(uint8_t)c];
+    }
+  };
+
+  /**
+   * @brief Binary payload carried by a conference message.
+   *
+   * The message is the header, 'z' for a compressed payload or 'r' for a raw
+   * one, the decoded size in decimal digits, a colon and the Z85 encoded
+   * payload. Payloads of at least compress_threshold bytes are compressed when
+   * that makes them smaller.
+   *
+   * Payloads are limited to max_size bytes, so that a remote sender cannot
+   * make the receivers allocate up to 255 times the size of its message.
+   */
+  struct binary_message {
+    static constexpr std::string_view header = "#dolbyio.binary/1#";
+    static constexpr size_t max_size = 1 << 20;
+
+    /**
+     * @throws std::invalid_argument if size exceeds max_size.
+     */
+    static std::string encode(const uint8_t* data, size_t size, size_t compress_threshold) {
+      if (size > max_size) {
+        throw std::invalid_argument("The binary message exceeds 1MB");
+      }
+
+      std::string& compressed = scratch_text();
+      compressed.clear();
+
+      bool compress = compress_threshold > 0 && size >= compress_threshold;
+      if (compress) {
+        lz4_block::compress(data, size, compressed);
+        compress = compressed.size() < size;
+      }
+
+      const uint8_t* payload = compress ? (const uint8_t*)compressed.data() : data;
+      size_t payload_size = compress ? compressed.size() : size;
+
+      std::string message;
+      message.reserve(header.size() + 22 + z85::encoded_size(payload_size));
+      message.append(header);
+      message.push_back(compress ? 'z' : 'r');
+      message.append(std::to_string(size));
+      message.push_back(':');
+      z85::encode(payload, payload_size, message);
+      return message;
+    }
+
+    /**
+     * @brief Gets the size of the payload of message.
+     *
+     * @return -1 if message is not a binary message.
+     */
+    static long long size(std::string_view message) {
+      parsed p;
+      return parse(message, p) ? (long long)p.size : -1;
+    }
+
+    /**
+     * @brief Decodes the payload of message into out, which holds size(message) bytes.
+     */
+    static bool decode(std::string_view message, uint8_t* out) {
+      parsed p;
+      if (!parse(message, p)) {
+        return false;
+      }
+
+      if (!p.compressed) {
+        return z85::decode(p.payload, out);
+      }
+
+      std::vector<uint8_t>& compressed = scratch_bytes();
+      compressed.resize(z85::decoded_size(p.payload.size()));
+      return z85::decode(p.payload, compressed.data())
+          && lz4_block::decompress(compressed.data(), compressed.size(), out, p.size);
+    }
+
+  private:
+    struct parsed {
+      bool             compressed;
+      size_t           size;
+      std::string_view payload;
+    };
+
+    static bool parse(std::string_view message, parsed& p) {
+      if (message.substr(0, header.size()) != header || message.size() < header.size() + 3) {
+        return false;
+      }
+
+      size_t pos = header.size();
+      char kind = message[pos++];
+      if (kind != 'z' && kind != 'r') {
+        return false;
+      }
+
+      size_t size = 0;
+      size_t digits = 0;
+      for (; pos < message.size() && message[pos] >= '0' && message[pos] <= '9' && digits < 9; pos++, digits++) {
+        size = 10 * size + (message[pos] - '0');
+      }
+
+      if (digits == 0 || size > max_size || pos >= message.size() || message[pos] != ':') {
+        return false;
+      }
+
+      p.compressed = kind == 'z';
+      p.size = size;
+      p.payload = message.substr(pos + 1);
+
+      if (p.payload.size() % 5 == 1) {
+        return false;
+      }
+
+      // A raw payload has its exact size, a block at most expands 255 times
+      size_t payload_size = z85::decoded_size(p.payload.size());
+      return p.compressed ? size <= 255 * payload_size : size == payload_size;
+    }
+
+    // Reused by the calling thread, so that steady traffic does not allocate
+    static std::string& scratch_text() {
+      static thread_local std::string text;
+      return text;
+    }
+
+    static std::vector<uint8_t>& scratch_bytes() {
+      static thread_local std::vector<uint8_t> bytes;
+      return bytes;
+    }
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _BINARY_MESSAGE_H_
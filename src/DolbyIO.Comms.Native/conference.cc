@@ -1,4 +1,9 @@
 #include "conference.h"
+#include "binary_message.h"
+#include "message_batcher.h"
+#include "participant_batcher.h"
+#include "participant_roster.h"
+#include "spatial_filter.h"
 
 namespace dolbyio::comms::native {
 extern "C" {
@@ -6,7 +11,8 @@ extern "C" {
  EXPORT_API void AddOnConferenceStatusUpdatedHandler(std::int32_t hash, on_conference_status_updated::type handler) {
     handle<on_conference_status_updated>(sdk->conference(), hash, handler,
       [handler](const on_conference_status_updated::event& e) {
-        handler(to_underlying(e.status), strdup(e.id.c_str()));
+        event_scope scope;
+        handler(to_underlying(e.status), scope.strdup(e.id));
       }
     );
   }
@@ -20,7 +26,8 @@ extern "C" {
   EXPORT_API void AddOnParticipantAddedHandler(std::int32_t hash, on_participant_added::type handler) {
     handle<on_participant_added>(sdk->conference(), hash, handler,
       [handler](const on_participant_added::event& e) {
-        handler(to_c<dolbyio::comms::native::participant>(e.participant));      
+        event_scope scope;
+        handler(scope.to_c<dolbyio::comms::native::participant>(e.participant));
       }
     );
   }
@@ -34,7 +41,8 @@ extern "C" {
   EXPORT_API void AddOnParticipantUpdatedHandler(std::int32_t hash, on_participant_updated::type handler) {
     handle<on_participant_updated>(sdk->conference(), hash, handler,
       [handler](const on_participant_updated::event& e) {
-        handler(to_c<dolbyio::comms::native::participant>(e.participant));      
+        event_scope scope;
+        handler(scope.to_c<dolbyio::comms::native::participant>(e.participant));
       }
     );
   }
@@ -45,17 +53,58 @@ extern "C" {
     }}.result();
   }
 
+  static std::mutex participant_batchers_lock;
+  static std::map<std::int32_t, std::shared_ptr<participant_batcher>> participant_batchers;
+
+  EXPORT_API void AddOnParticipantsBatchHandler(std::int32_t hash, on_participants_batch_updated::type handler, int window_ms) {
+    auto batcher = participant_batcher::create(handler, std::chrono::milliseconds(std::max(window_ms, 0)));
+    {
+      std::lock_guard<std::mutex> lock(participant_batchers_lock);
+      auto& slot = participant_batchers[hash];
+      if (slot) {
+        slot->stop();
+      }
+      slot = batcher;
+    }
+
+    handle<on_participants_batch_added>(sdk->conference(), hash, handler,
+      [batcher](const on_participants_batch_added::event& e) {
+        batcher->push(e.participant);
+      }
+    );
+
+    handle<on_participants_batch_updated>(sdk->conference(), hash, handler,
+      [batcher](const on_participants_batch_updated::event& e) {
+        batcher->push(e.participant);
+      }
+    );
+  }
+
+  EXPORT_API int RemoveOnParticipantsBatchHandler(std::int32_t hash, on_participants_batch_updated::type handler) {
+    return call { [&]() {
+      disconnect_handler<on_participants_batch_added>(hash, handler);
+      disconnect_handler<on_participants_batch_updated>(hash, handler);
+
+      std::lock_guard<std::mutex> lock(participant_batchers_lock);
+      auto it = participant_batchers.find(hash);
+      if (it != participant_batchers.end()) {
+        it->second->stop();
+        participant_batchers.erase(it);
+      }
+    }}.result();
+  }
+
   EXPORT_API void AddOnActiveSpeakerChangeHandler(std::int32_t hash, on_active_speaker_change::type handler) {
     handle<on_active_speaker_change>(sdk->conference(), hash, handler,
       [handler](const on_active_speaker_change::event& e) {
-        char* conf_id = strdup(e.conference_id);
-        std::vector<char*> speakers(e.active_speakers.size());
+        event_scope scope;
+        char** speakers = scope.allocate<char*>(e.active_speakers.size());
 
         for (int i = 0; i < e.active_speakers.size(); i++) {
-          speakers[i] = strdup(e.active_speakers.at(i));
+          speakers[i] = scope.strdup(e.active_speakers.at(i));
         }
 
-        handler(conf_id, e.active_speakers.size(), &speakers[0]);    
+        handler(scope.strdup(e.conference_id), e.active_speakers.size(), speakers);
       }
     );
   }
@@ -69,8 +118,9 @@ extern "C" {
   EXPORT_API void AddOnConferenceMessageReceivedHandler(std::int32_t hash, on_conference_message_received::type handler) {
     handle<on_conference_message_received>(sdk->conference(), hash, handler,
       [handler](const on_conference_message_received::event& e) {
-          auto info = to_c<dolbyio::comms::native::participant_info>(e.sender_info);
-          handler(strdup(e.conference_id), strdup(e.user_id), info, strdup(e.message));
+          event_scope scope;
+          auto info = scope.to_c<dolbyio::comms::native::participant_info>(e.sender_info);
+          handler(scope.strdup(e.conference_id), scope.strdup(e.user_id), info, scope.strdup(e.message));
       }
     );
   }
@@ -81,13 +131,98 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API void AddOnConferenceMessagesReceivedHandler(std::int32_t hash, on_conference_messages_received::type handler) {
+    handle<on_conference_messages_received>(sdk->conference(), hash, handler,
+      [handler](const on_conference_messages_received::event& e) {
+        event_scope scope;
+        auto info = scope.to_c<dolbyio::comms::native::participant_info>(e.sender_info);
+
+        int count = message_frame::count(e.message);
+        if (count < 0) {
+          char* message = scope.strdup(e.message);
+          handler(scope.strdup(e.conference_id), scope.strdup(e.user_id), info, 1, &message);
+          return;
+        }
+
+        char** messages = scope.allocate<char*>(count);
+        int i = 0;
+        message_frame::split(e.message, [&](std::string_view message) {
+          messages[i++] = scope.strdup(message.data(), message.size());
+        });
+
+        handler(scope.strdup(e.conference_id), scope.strdup(e.user_id), info, count, messages);
+      }
+    );
+  }
+
+  EXPORT_API int RemoveOnConferenceMessagesReceivedHandler(std::int32_t hash, on_conference_messages_received::type handler) {
+    return call { [&]() {
+      disconnect_handler<on_conference_messages_received>(hash, handler);
+    }}.result();
+  }
+
+  /**
+   * @brief Calls the handler with every binary message of the received
+   * message, which is either a binary message or a frame of messages.
+   */
+  EXPORT_API void AddOnConferenceBinaryMessageReceivedHandler(std::int32_t hash, on_conference_binary_message_received::type handler) {
+    handle<on_conference_binary_message_received>(sdk->conference(), hash, handler,
+      [handler](const on_conference_binary_message_received::event& e) {
+        event_scope scope;
+        participant_info* info = nullptr;
+        char* conference_id = nullptr;
+        char* user_id = nullptr;
+
+        auto deliver = [&](std::string_view message) {
+          long long size = binary_message::size(message);
+          if (size < 0) {
+            return;
+          }
+
+          // The arena keeps its blocks, so the large payloads go to the heap
+          std::unique_ptr<uint8_t[]> large;
+          uint8_t* data;
+          if ((size_t)size > event_arena::block_size) {
+            large.reset(new uint8_t[size]);
+            data = large.get();
+          } else {
+            data = scope.allocate<uint8_t>(std::max<size_t>(size, 1));
+          }
+
+          if (!binary_message::decode(message, data)) {
+            return;
+          }
+
+          if (!info) {
+            info = scope.to_c<dolbyio::comms::native::participant_info>(e.sender_info);
+            conference_id = scope.strdup(e.conference_id);
+            user_id = scope.strdup(e.user_id);
+          }
+
+          handler(conference_id, user_id, info, data, (int)size);
+        };
+
+        if (message_frame::split(e.message, deliver) < 0) {
+          deliver(e.message);
+        }
+      }
+    );
+  }
+
+  EXPORT_API int RemoveOnConferenceBinaryMessageReceivedHandler(std::int32_t hash, on_conference_binary_message_received::type handler) {
+    return call { [&]() {
+      disconnect_handler<on_conference_binary_message_received>(hash, handler);
+    }}.result();
+  }
+
   EXPORT_API void AddOnConferenceInvitationReceivedHandler(std::int32_t hash, on_conference_invitation_received::type handler) {
     handle<on_conference_invitation_received>(sdk->conference(), hash, handler,
       [handler](const on_conference_invitation_received::event& e) {
+        event_scope scope;
         handler(
-          strdup(e.conference_id), 
-          strdup(e.conference_alias), 
-          to_c<dolbyio::comms::native::participant_info>(e.sender_info)
+          scope.strdup(e.conference_id),
+          scope.strdup(e.conference_alias),
+          scope.to_c<dolbyio::comms::native::participant_info>(e.sender_info)
         );
       }
     );
@@ -102,7 +237,8 @@ extern "C" {
   EXPORT_API void AddOnDvcErrorExceptionHandler(std::int32_t hash, on_dvc_error_exception::type handler) {
     handle<on_dvc_error_exception>(sdk->conference(), handler,
       [handler](const on_dvc_error_exception::event& e) {
-        handler(strdup(e.what()));
+        event_scope scope;
+        handler(scope.strdup(e.what()));
       }
     );
   }
@@ -116,7 +252,8 @@ extern "C" {
   EXPORT_API void AddOnPeerConnectionFailedExceptionHandler(std::int32_t hash, on_peer_connection_failed_exception::type handler) {
     handle<on_peer_connection_failed_exception>(sdk->conference(), hash, handler,
       [handler](const on_peer_connection_failed_exception::event& e) {
-        handler(strdup(e.what()));
+        event_scope scope;
+        handler(scope.strdup(e.what()));
       }
     );
   }
@@ -130,8 +267,9 @@ extern "C" {
   EXPORT_API void AddOnConferenceVideoTrackAddedHandler(std::int32_t hash, on_conference_video_track_added::type handler) {
     handle<on_conference_video_track_added>(sdk->conference(), hash, handler,
       [handler](const on_conference_video_track_added::event& e) {
+        event_scope scope;
         video_track t;
-        no_alloc_to_c(&t, e.track);
+        scope.no_alloc_to_c(&t, e.track);
         handler(t);
       }
     );
@@ -146,8 +284,9 @@ extern "C" {
   EXPORT_API void AddOnConferenceVideoTrackRemovedHandler(std::int32_t hash, on_conference_video_track_removed::type handler) {
     handle<on_conference_video_track_removed>(sdk->conference(), hash, handler,
       [handler](const on_conference_video_track_removed::event& e) {
+        event_scope scope;
         video_track t;
-        no_alloc_to_c(&t, e.track);
+        scope.no_alloc_to_c(&t, e.track);
         handler(t);
       }
     );
@@ -167,6 +306,13 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int CreateAsync(dolbyio::comms::native::conference_options* opts, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      auto options = to_cpp<dolbyio::comms::services::conference::conference_options>(opts);
+      c.attach(sdk->conference().create(options), as_struct<dolbyio::comms::native::conference>{});
+    }}.result();
+  }
+
   EXPORT_API int Join(dolbyio::comms::native::conference* src, dolbyio::comms::native::join_options* opts, dolbyio::comms::native::conference* res) {
     return call { [&]() {
       auto options = to_cpp<dolbyio::comms::services::conference::join_options>(opts);
@@ -176,6 +322,14 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int JoinAsync(dolbyio::comms::native::conference* src, dolbyio::comms::native::join_options* opts, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      auto options = to_cpp<dolbyio::comms::services::conference::join_options>(opts);
+      auto infos = to_cpp<dolbyio::comms::conference_info>(src);
+      c.attach(sdk->conference().join(infos, options), as_struct<dolbyio::comms::native::conference>{});
+    }}.result();
+  }
+
   EXPORT_API int Demo(int audio_style, dolbyio::comms::native::conference* conf) {
     return call { [&]() {
       auto result = wait(sdk->conference().demo((dolbyio::comms::spatial_audio_style)audio_style));
@@ -183,6 +337,12 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int DemoAsync(int audio_style, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->conference().demo((dolbyio::comms::spatial_audio_style)audio_style), as_struct<dolbyio::comms::native::conference>{});
+    }}.result();
+  }
+
   EXPORT_API int Listen(dolbyio::comms::native::conference* ifs, dolbyio::comms::native::listen_options* opts, dolbyio::comms::native::conference* res) {
     return call { [&]() {
       auto options = to_cpp<dolbyio::comms::services::conference::listen_options>(opts);
@@ -192,6 +352,14 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int ListenAsync(dolbyio::comms::native::conference* ifs, dolbyio::comms::native::listen_options* opts, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      auto options = to_cpp<dolbyio::comms::services::conference::listen_options>(opts);
+      auto infos = to_cpp<dolbyio::comms::conference_info>(ifs);
+      c.attach(sdk->conference().listen(infos, options), as_struct<dolbyio::comms::native::conference>{});
+    }}.result();
+  }
+
   EXPORT_API int GetCurrentConference(dolbyio::comms::native::conference* res) {
     return call { [&]() {
       auto infos = wait(sdk->conference().get_current_conference());
@@ -199,6 +367,12 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int GetCurrentConferenceAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->conference().get_current_conference(), as_struct<dolbyio::comms::native::conference>{});
+    }}.result();
+  }
+
   EXPORT_API int GetParticipants(int* size, void** dest) {
     return call { [&]() {
       auto infos = wait(sdk->conference().get_current_conference());
@@ -215,38 +389,300 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int GetParticipantsAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->conference().get_current_conference(),
+        [](event_scope& scope, const dolbyio::comms::conference_info& infos, int& count) {
+          participant* participants = scope.allocate<participant>(infos.participants.size());
+          for (const auto& pair : infos.participants) {
+            scope.no_alloc_to_c(&participants[count++], pair.second);
+          }
+          return (void*)participants;
+        }
+      );
+    }}.result();
+  }
+
+  static participant_roster roster;
+  static std::mutex roster_lock;
+
+  // Starts following the participant events, once per SDK instance as Release()
+  // drops the handlers, seeding the roster with the participants already in the conference
+  static void follow_roster() {
+#ifndef MOCK
+    std::lock_guard<std::mutex> lock(roster_lock);
+    if (handler_registry<on_roster_participant_added>::instance().contains(0)) {
+      return;
+    }
+
+    roster.clear();
+    handle<on_roster_participant_added>(sdk->conference(), nullptr,
+      [](const on_roster_participant_added::event& e) {
+        roster.upsert(e.participant);
+      }
+    );
+
+    handle<on_roster_participant_updated>(sdk->conference(), nullptr,
+      [](const on_roster_participant_updated::event& e) {
+        roster.upsert(e.participant);
+      }
+    );
+
+    handle<on_roster_conference_status_updated>(sdk->conference(), nullptr,
+      [](const on_roster_conference_status_updated::event& e) {
+        if (e.status == dolbyio::comms::conference_status::left ||
+            e.status == dolbyio::comms::conference_status::destroyed ||
+            e.status == dolbyio::comms::conference_status::error) {
+          roster.clear();
+        }
+      }
+    );
+
+    try {
+      auto infos = wait(sdk->conference().get_current_conference());
+      for (const auto& pair : infos.participants) {
+        roster.upsert(pair.second, true);
+      }
+    } catch (...) {
+      // Not in a conference yet, the events fill the roster
+    }
+#endif
+  }
+
+  EXPORT_API int GetParticipantsVersion(std::uint64_t* version) {
+    return call { [&]() {
+      follow_roster();
+      *version = roster.version();
+    }}.result();
+  }
+
+  EXPORT_API int GetParticipantsChanges(std::uint64_t since, participant_roster::delegate_type delegate) {
+    return call { [&]() {
+      follow_roster();
+      roster.changes_since(since, delegate);
+    }}.result();
+  }
+
+  static void send_held_back_spatial_update();
+
+  // Never destroyed, so that no thread is joined while the library unloads
+  static spatial_filter& spatial = *new spatial_filter(send_held_back_spatial_update);
+
+  // Called by the spatial filter once the changes it held back can be sent
+  static void send_held_back_spatial_update() {
+    dolbyio::comms::spatial_audio_batch_update conf;
+    if (sdk && spatial.flush(conf)) {
+      sdk->conference().update_spatial_audio_configuration(std::move(conf))
+        .then([]() {})
+        .on_error([](std::exception_ptr&&) {});
+    }
+  }
+
+  EXPORT_API int SetSpatialFilter(bool enabled, float position_x, float position_y, float position_z,
+                                  float direction_x, float direction_y, float direction_z, double max_rate) {
+    return call { [&]() {
+      spatial.configure(enabled, {position_x, position_y, position_z}, {direction_x, direction_y, direction_z}, max_rate);
+    }}.result();
+  }
+
+  EXPORT_API int GetSpatialFilterStatistics(spatial_filter_statistics* statistics) {
+    return call { [&]() {
+      *statistics = spatial.statistics();
+    }}.result();
+  }
+
+  /**
+   * @brief Applies the positions of count participants, and optionally the
+   * environment and the direction, in one spatial_audio_batch_update once
+   * they went through the spatial filter.
+   *
+   * @param positions The x, y and z of every participant, 3 * count floats.
+   * @param environment The scale, forward, up and right vectors, 12 floats, or nullptr to keep the environment.
+   * @param direction The x, y and z of the direction, or nullptr to keep the direction.
+   */
+  EXPORT_API int UpdateSpatialAudioAsync(int count, const char** user_ids, const float* positions,
+                                         const float* environment, const float* direction,
+                                         completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      dolbyio::comms::spatial_audio_batch_update conf;
+
+      if (spatial.filter(count, user_ids, positions, environment, direction, conf)) {
+        c.attach(sdk->conference().update_spatial_audio_configuration(std::move(conf)));
+      } else {
+        c.succeed();
+      }
+    }}.result();
+  }
+
+  /**
+   * @brief Sends the changes held back by the maximum update rate of the spatial filter right away.
+   */
+  EXPORT_API int FlushSpatialAudioAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      dolbyio::comms::spatial_audio_batch_update conf;
+
+      if (spatial.flush(conf)) {
+        c.attach(sdk->conference().update_spatial_audio_configuration(std::move(conf)));
+      } else {
+        c.succeed();
+      }
+    }}.result();
+  }
+
   EXPORT_API int SetSpatialEnvironment(float scale_x, float scale_y, float scale_z, 
                                       float forward_x, float forward_y, float forward_z,
                                       float up_x, float up_y, float up_z,
                                       float right_x, float right_y, float right_z) {
     return call { [&]() {
       dolbyio::comms::spatial_audio_batch_update conf;
+      const float environment[] = { scale_x, scale_y, scale_z, forward_x, forward_y, forward_z,
+                                    up_x, up_y, up_z, right_x, right_y, right_z };
 
-      conf.set_spatial_environment({scale_x, scale_y, scale_z},
-                                   {forward_x, forward_y, forward_z},
-                                   {up_x, up_y, up_z},
-                                   {right_x, right_y, right_z}
-                                  );
-
-      wait(sdk->conference().update_spatial_audio_configuration(std::move(conf)));
+      if (spatial.filter(0, nullptr, nullptr, environment, nullptr, conf)) {
+        wait(sdk->conference().update_spatial_audio_configuration(std::move(conf)));
+      }
     }}.result();
   }
 
+  EXPORT_API int SetSpatialEnvironmentAsync(float scale_x, float scale_y, float scale_z,
+                                           float forward_x, float forward_y, float forward_z,
+                                           float up_x, float up_y, float up_z,
+                                           float right_x, float right_y, float right_z,
+                                           completion_type done, std::intptr_t cookie) {
+    const float environment[] = { scale_x, scale_y, scale_z, forward_x, forward_y, forward_z,
+                                  up_x, up_y, up_z, right_x, right_y, right_z };
+    return UpdateSpatialAudioAsync(0, nullptr, nullptr, environment, nullptr, done, cookie);
+  }
+
   EXPORT_API int SetSpatialDirection(float x, float y, float z) {
     return call { [&]() {
       dolbyio::comms::spatial_audio_batch_update conf;
-      conf.set_spatial_direction({x, y, z});
+      const float direction[] = { x, y, z };
 
-      wait(sdk->conference().update_spatial_audio_configuration(std::move(conf)));
+      if (spatial.filter(0, nullptr, nullptr, nullptr, direction, conf)) {
+        wait(sdk->conference().update_spatial_audio_configuration(std::move(conf)));
+      }
     }}.result();
   }
 
+  EXPORT_API int SetSpatialDirectionAsync(float x, float y, float z, completion_type done, std::intptr_t cookie) {
+    const float direction[] = { x, y, z };
+    return UpdateSpatialAudioAsync(0, nullptr, nullptr, nullptr, direction, done, cookie);
+  }
+
   EXPORT_API int SetSpatialPosition(const char* user_id, float x, float y, float z) {
     return call { [&]() {
       dolbyio::comms::spatial_audio_batch_update conf;
-      conf.set_spatial_position(user_id, {x, y, z});
+      const float position[] = { x, y, z };
+
+      if (spatial.filter(1, &user_id, position, nullptr, nullptr, conf)) {
+        wait(sdk->conference().update_spatial_audio_configuration(std::move(conf)));
+      }
+    }}.result();
+  }
+
+  EXPORT_API int SetSpatialPositionAsync(const char* user_id, float x, float y, float z, completion_type done, std::intptr_t cookie) {
+    const float position[] = { x, y, z };
+    return UpdateSpatialAudioAsync(1, &user_id, position, nullptr, nullptr, done, cookie);
+  }
+
+  static std::mutex message_batcher_lock;
+  static std::shared_ptr<message_batcher> outgoing_messages;
+
+  static std::shared_ptr<message_batcher> current_message_batcher() {
+    std::lock_guard<std::mutex> lock(message_batcher_lock);
+    return outgoing_messages;
+  }
+
+  static void send_frame(std::string&& frame, std::function<void()> failed) {
+    sdk->conference().send(std::move(frame))
+      .then([]() {})
+      .on_error([failed](std::exception_ptr&&) { failed(); });
+  }
+
+  /**
+   * @brief Enables the batching of QueueMessage, or sends the pending frame
+   * and disables it when max_frame_size is 0.
+   */
+  EXPORT_API int SetMessageBatching(int max_frame_size, int max_delay_ms) {
+    return call { [&]() {
+      std::shared_ptr<message_batcher> batcher;
+      if (max_frame_size > 0) {
+        batcher = message_batcher::create(send_frame, max_frame_size, std::chrono::milliseconds(std::max(max_delay_ms, 0)));
+      }
+
+      std::shared_ptr<message_batcher> previous;
+      {
+        std::lock_guard<std::mutex> lock(message_batcher_lock);
+        previous = std::exchange(outgoing_messages, batcher);
+      }
 
-      wait(sdk->conference().update_spatial_audio_configuration(std::move(conf)));
+      if (previous) {
+        previous->stop();
+      }
+    }}.result();
+  }
+
+  /**
+   * @brief Queues a message into the current frame, or sends it at once
+   * without waiting when batching is disabled.
+   */
+  static void queue_message(std::string&& message) {
+    // The batcher may have been stopped since it was taken
+    auto batcher = current_message_batcher();
+    if (!batcher || !batcher->push(message)) {
+      send_frame(std::move(message), []() {});
+    }
+  }
+
+  EXPORT_API int QueueMessage(const char* message) {
+    return call { [&]() {
+      queue_message(message);
+    }}.result();
+  }
+
+  /**
+   * @brief Queues size bytes of data as a binary message, see QueueMessage.
+   *
+   * @param compress_threshold The smallest payload that is compressed, 0 to never compress.
+   */
+  EXPORT_API int QueueBinaryMessage(const uint8_t* data, int size, int compress_threshold) {
+    return call { [&]() {
+      queue_message(binary_message::encode(data, std::max(size, 0), std::max(compress_threshold, 0)));
+    }}.result();
+  }
+
+  EXPORT_API int SendBinaryMessageAsync(const uint8_t* data, int size, int compress_threshold, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->conference().send(binary_message::encode(data, std::max(size, 0), std::max(compress_threshold, 0))));
+    }}.result();
+  }
+
+  /**
+   * @brief Sends the pending frame, completing once the SDK sent it.
+   */
+  EXPORT_API int FlushMessagesAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      auto batcher = current_message_batcher();
+      bool flushed = batcher && batcher->flush([&](std::string&& frame, std::function<void()> failed) {
+        sdk->conference().send(std::move(frame))
+          .then([c]() { c.succeed(); })
+          .on_error([c, failed](std::exception_ptr&& e) {
+            failed();
+            c.fail(std::move(e));
+          });
+      });
+
+      if (!flushed) {
+        c.succeed();
+      }
+    }}.result();
+  }
+
+  EXPORT_API int GetMessageBatchStatistics(message_batch_statistics* statistics) {
+    return call { [&]() {
+      auto batcher = current_message_batcher();
+      *statistics = batcher ? batcher->statistics() : message_batch_statistics{};
     }}.result();
   }
 
@@ -256,17 +692,68 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int SendMessageAsync(char* message, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->conference().send(std::string(message)));
+    }}.result();
+  }
+
   EXPORT_API int Leave() {
     return call { [&]() {
+      if (auto batcher = current_message_batcher()) {
+        batcher->flush();
+      }
+      spatial.reset();
       wait(sdk->conference().leave());
     }}.result();
   }
 
+  EXPORT_API int LeaveAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      if (auto batcher = current_message_batcher()) {
+        batcher->flush();
+      }
+      spatial.reset();
+      c.attach(sdk->conference().leave());
+    }}.result();
+  }
+
   EXPORT_API int DeclineInvitation(char* conference_id) {
     return call { [&]() {
       wait(sdk->conference().decline_invitation(std::string(conference_id)));
     }}.result();
   }
 
+  EXPORT_API int DeclineInvitationAsync(char* conference_id, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->conference().decline_invitation(std::string(conference_id)));
+    }}.result();
+  }
+
 } // extern "C"
+
+  void release_conference() {
+    {
+      std::lock_guard<std::mutex> lock(participant_batchers_lock);
+      for (auto& [hash, batcher] : participant_batchers) {
+        batcher->stop();
+      }
+      participant_batchers.clear();
+    }
+
+    std::shared_ptr<message_batcher> batcher;
+    {
+      std::lock_guard<std::mutex> lock(message_batcher_lock);
+      batcher = std::exchange(outgoing_messages, nullptr);
+    }
+
+    if (batcher) {
+      batcher->stop();
+    }
+
+    // The flush thread sends through the SDK
+    spatial.stop();
+    spatial.reset();
+  }
+
 } // namespace dolbyio::comms::native
\ No newline at end of file
@@ -127,6 +127,39 @@ namespace dolbyio::comms::native {
     static constexpr const char* name = "on_participant_updated";
   };
 
+  struct on_participants_batch_added {
+    using event = dolbyio::comms::participant_added;
+    using type = void (*)(participant* participants, int count);
+    static constexpr const char* name = "on_participants_batch_added";
+  };
+
+  struct on_participants_batch_updated {
+    using event = dolbyio::comms::participant_updated;
+    using type = void (*)(participant* participants, int count);
+    static constexpr const char* name = "on_participants_batch_updated";
+  };
+
+  /**
+   * @brief Events keeping the participant_roster up to date, registered once per SDK instance.
+   */
+  struct on_roster_participant_added {
+    using event = dolbyio::comms::participant_added;
+    using type = void*;
+    static constexpr const char* name = "on_roster_participant_added";
+  };
+
+  struct on_roster_participant_updated {
+    using event = dolbyio::comms::participant_updated;
+    using type = void*;
+    static constexpr const char* name = "on_roster_participant_updated";
+  };
+
+  struct on_roster_conference_status_updated {
+    using event = dolbyio::comms::conference_status_updated;
+    using type = void*;
+    static constexpr const char* name = "on_roster_conference_status_updated";
+  };
+
   struct on_dvc_error_exception {
     using event = dolbyio::comms::dvc_error_exception;
     using type = void (*)(const char* reason);
@@ -151,6 +184,18 @@ namespace dolbyio::comms::native {
     static constexpr const char* name = "on_conference_message_received";
   };
 
+  struct on_conference_messages_received {
+    using event = dolbyio::comms::conference_message_received;
+    using type = void (*)(char* conference_id, char* user_id, participant_info* info, int count, char* messages[]);
+    static constexpr const char* name = "on_conference_messages_received";
+  };
+
+  struct on_conference_binary_message_received {
+    using event = dolbyio::comms::conference_message_received;
+    using type = void (*)(char* conference_id, char* user_id, participant_info* info, uint8_t* data, int size);
+    static constexpr const char* name = "on_conference_binary_message_received";
+  };
+
   struct on_conference_invitation_received {
     using event = dolbyio::comms::conference_invitation_received;
     using type = void (*)(char* conference_id, char* conference_alias, participant_info* info);
@@ -324,6 +369,12 @@ namespace dolbyio::comms::native {
     }
   };
 
+  /**
+   * @brief Stops the batching threads of the conference service and forgets
+   * its spatial audio state, before the SDK is released.
+   */
+  void release_conference();
+
 } // namespace dolbyio::comms::native
 
 #endif // _CONFERENCE_H_
\ No newline at end of file
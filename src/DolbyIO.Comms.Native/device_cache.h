@@ -0,0 +1,189 @@
+#ifndef _DEVICE_CACHE_H_
+#define _DEVICE_CACHE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sdk.h"
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Devices of one kind as last enumerated, kept up to date from the
+   * device events so that listing and looking devices up does not go through the SDK.
+   *
+   * The devices are indexed by Traits::key, which tells devices apart in the
+   * common case, a lookup then comparing the few devices sharing the key.
+   * Every event bumps the generation of the list so that an enumeration
+   * overtaken by an event, which may or may not include the change, is not
+   * stored: the next lookup enumerates again.
+   */
+  template<typename Device, typename Traits>
+  class device_list {
+  public:
+    uint64_t generation() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return generation_;
+    }
+
+    /**
+     * @brief Stores the devices enumerated from generation, unless an event arrived meanwhile.
+     *
+     * @return Whether the devices were stored.
+     */
+    bool fill(const std::vector<Device>& devices, uint64_t generation) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (generation != generation_) {
+        return false;
+      }
+
+      devices_ = devices;
+      populated_ = true;
+      reindex();
+      return true;
+    }
+
+    /**
+     * @brief Copies the devices, in the order of the enumeration followed by the devices added since.
+     *
+     * @return false if the devices must be enumerated.
+     */
+    bool get(std::vector<Device>& devices) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (populated_) {
+        devices = devices_;
+      }
+
+      return populated_;
+    }
+
+    /**
+     * @brief Finds the device of the given key matching match.
+     *
+     * @return std::nullopt if there is no such device or the devices must be enumerated.
+     */
+    template<typename Match> std::optional<Device> find(const std::string& key, Match match) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto range = index_.equal_range(key);
+      for (auto it = range.first; it != range.second; ++it) {
+        if (match(devices_[it->second])) {
+          return devices_[it->second];
+        }
+      }
+
+      return std::nullopt;
+    }
+
+    /**
+     * @brief Whether a device matches match, looking at every device.
+     */
+    template<typename Match> bool contains(Match match) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return std::any_of(devices_.begin(), devices_.end(), match);
+    }
+
+    /**
+     * @brief Adds a device, or updates it in place when already known.
+     */
+    void upsert(const Device& device) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      generation_++;
+      if (!populated_) {
+        return;
+      }
+
+      auto range = index_.equal_range(Traits::key(device));
+      for (auto it = range.first; it != range.second; ++it) {
+        if (Traits::same(devices_[it->second], device)) {
+          devices_[it->second] = device;
+          return;
+        }
+      }
+
+      // Known under another key, such as a renamed device
+      auto known = std::find_if(devices_.begin(), devices_.end(), [&device](const Device& d) { return Traits::same(d, device); });
+      if (known != devices_.end()) {
+        *known = device;
+        reindex();
+        return;
+      }
+
+      devices_.push_back(device);
+      index_.emplace(Traits::key(device), devices_.size() - 1);
+    }
+
+    /**
+     * @brief Removes the device matching match.
+     */
+    template<typename Match> void erase(Match match) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      generation_++;
+
+      auto it = std::find_if(devices_.begin(), devices_.end(), match);
+      if (it != devices_.end()) {
+        devices_.erase(it);
+        reindex();
+      }
+    }
+
+    /**
+     * @brief Drops the devices, so that the next lookup enumerates them.
+     */
+    void invalidate() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      generation_++;
+      populated_ = false;
+      devices_.clear();
+      index_.clear();
+    }
+
+  private:
+    // Called with the lock held
+    void reindex() {
+      index_.clear();
+      for (size_t i = 0; i < devices_.size(); i++) {
+        index_.emplace(Traits::key(devices_[i]), i);
+      }
+    }
+
+    mutable std::mutex                              mutex_;
+    std::vector<Device>                             devices_;
+    std::unordered_multimap<std::string, size_t>    index_;
+    uint64_t                                        generation_ = 0;
+    bool                                            populated_ = false;
+  };
+
+  /**
+   * @brief Audio devices are keyed by name, which C# passes along with the identity.
+   */
+  struct audio_device_traits {
+    static const std::string& key(const dolbyio::comms::audio_device& device) {
+      return device.name();
+    }
+
+    static bool same(const dolbyio::comms::audio_device& a, const dolbyio::comms::audio_device& b) {
+      return a.get_identity() == b.get_identity();
+    }
+  };
+
+  struct camera_device_traits {
+    static const std::string& key(const dolbyio::comms::camera_device& device) {
+      return device.unique_id;
+    }
+
+    static bool same(const dolbyio::comms::camera_device& a, const dolbyio::comms::camera_device& b) {
+      return a.unique_id == b.unique_id;
+    }
+  };
+
+  using audio_device_list = device_list<dolbyio::comms::audio_device, audio_device_traits>;
+  using camera_device_list = device_list<dolbyio::comms::camera_device, camera_device_traits>;
+
+} // namespace dolbyio::comms::native
+
+#endif // _DEVICE_CACHE_H_
@@ -0,0 +1,142 @@
+#ifndef _DEVICE_HANDLES_H_
+#define _DEVICE_HANDLES_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "sdk.h"
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Interns device identities, handing C# small integer handles that
+   * it compares directly in place of heap allocated identities.
+   *
+   * An identity keeps its handle for as long as the device is present. Removed
+   * devices stay as tombstones, reclaimed oldest first past max_removed, so that
+   * the removal event still translates to the handle and a device plugged
+   * back meanwhile gets its handle back. Handles are never reused, so that
+   * a stale handle cannot designate another device.
+   *
+   * Identities only compare for equality: turning a handle into an identity is
+   * a hash lookup, the other way round compares the identities interned one
+   * by one. This is deliberate, as the SDK identities cannot be hashed, and
+   * the table holds no more than the devices present and max_removed others,
+   * so the scan stays short next to the SDK call that handed the identity.
+   */
+  template<typename Identity>
+  class handle_table {
+  public:
+    using handle = int32_t;
+
+    static constexpr handle no_handle = 0;
+    static constexpr size_t max_removed = 64;
+
+    static handle_table& instance() {
+      static handle_table table;
+      return table;
+    }
+
+    /**
+     * @brief Gets the handle of id, interning it if needed.
+     */
+    handle intern(const Identity& id) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = lookup(id);
+      if (it != entries_.end()) {
+        // Plugged back, so it no longer waits to be reclaimed
+        if (it->second.removed) {
+          it->second.removed = false;
+          removed_.erase(std::find(removed_.begin(), removed_.end(), it->first));
+        }
+        return it->first;
+      }
+
+      handle h = next_++;
+      entries_.emplace(h, entry{ id, false });
+      return h;
+    }
+
+    /**
+     * @brief Gets the handle of id, removed devices included.
+     *
+     * @return no_handle if id was never interned, or was reclaimed.
+     */
+    handle find(const Identity& id) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = lookup(id);
+      return it != entries_.end() ? it->first : no_handle;
+    }
+
+    std::optional<Identity> identity(handle h) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = entries_.find(h);
+      if (it == entries_.end()) {
+        return std::nullopt;
+      }
+
+      return it->second.id;
+    }
+
+    /**
+     * @brief Marks the device of id removed, reclaiming the oldest removed devices past max_removed.
+     */
+    void remove(const Identity& id) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = lookup(id);
+      if (it == entries_.end() || it->second.removed) {
+        return;
+      }
+
+      it->second.removed = true;
+      removed_.push_back(it->first);
+
+      if (removed_.size() > max_removed) {
+        entries_.erase(removed_.front());
+        removed_.pop_front();
+      }
+    }
+
+    size_t size() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return entries_.size();
+    }
+
+  private:
+    struct entry {
+      Identity id;
+      bool     removed;
+    };
+
+    using entry_map = std::unordered_map<handle, entry>;
+
+    // Called with the lock held
+    typename entry_map::iterator lookup(const Identity& id) {
+      for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->second.id == id) {
+          return it;
+        }
+      }
+
+      return entries_.end();
+    }
+
+    typename entry_map::const_iterator lookup(const Identity& id) const {
+      return const_cast<handle_table*>(this)->lookup(id);
+    }
+
+    mutable std::mutex  mutex_;
+    entry_map           entries_;
+    std::deque<handle>  removed_;    // The removed entries, oldest first
+    handle              next_ = no_handle + 1;
+  };
+
+  using device_handles = handle_table<dolbyio::comms::audio_device::identity>;
+
+} // namespace dolbyio::comms::native
+
+#endif // _DEVICE_HANDLES_H_
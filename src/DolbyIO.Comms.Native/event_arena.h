@@ -0,0 +1,120 @@
+#ifndef _EVENT_ARENA_H_
+#define _EVENT_ARENA_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Bump allocator holding the C structs and strings of the events
+   * passed to the C# handlers.
+   *
+   * Every thread dispatching events owns one arena. An event allocates from
+   * it while being translated and gives everything back in one go once the
+   * handler returned, by rewinding the arena to where the event started. The
+   * blocks are kept, so that after the first few events the translation no
+   * longer touches the heap.
+   */
+  class event_arena {
+  public:
+    struct mark {
+      size_t block;
+      size_t offset;
+    };
+
+    static constexpr size_t block_size = 4096;
+
+    /**
+     * @brief Gets the arena of the calling thread.
+     */
+    static event_arena& local() {
+      static thread_local event_arena arena;
+      return arena;
+    }
+
+    /**
+     * @brief Gets the arena the translators of the calling thread allocate
+     * from, nullptr when they allocate with malloc.
+     */
+    static event_arena*& active() {
+      static thread_local event_arena* arena = nullptr;
+      return arena;
+    }
+
+    event_arena() = default;
+    event_arena(const event_arena&) = delete;
+    event_arena& operator=(const event_arena&) = delete;
+
+    /**
+     * @brief Allocates zero initialized memory valid until the arena is rewound past it.
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+      while (block_ < blocks_.size()) {
+        size_t offset = (offset_ + alignment - 1) & ~(alignment - 1);
+        if (offset + size <= blocks_[block_].size) {
+          offset_ = offset + size;
+          uint8_t* p = blocks_[block_].data.get() + offset;
+          memset(p, 0, size);
+          return p;
+        }
+
+        block_++;
+        offset_ = 0;
+      }
+
+      size_t grown = blocks_.empty() ? block_size : 2 * blocks_.back().size;
+      blocks_.push_back(block{ std::unique_ptr<uint8_t[]>(new uint8_t[std::max(grown, size + alignment)]), std::max(grown, size + alignment) });
+      block_ = blocks_.size() - 1;
+      offset_ = 0;
+      return allocate(size, alignment);
+    }
+
+    template<typename T> T* allocate(size_t count = 1) {
+      return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    char* strdup(const char* s, size_t length) {
+      char* copy = static_cast<char*>(allocate(length + 1, 1));
+      memcpy(copy, s, length);
+      return copy;
+    }
+
+    mark position() const {
+      return mark{ block_, offset_ };
+    }
+
+    void rewind(const mark& m) {
+      block_ = m.block;
+      offset_ = m.offset;
+    }
+
+    /**
+     * @brief Gets the number of bytes reserved by the arena.
+     */
+    size_t capacity() const {
+      size_t total = 0;
+      for (const auto& b : blocks_) {
+        total += b.size;
+      }
+      return total;
+    }
+
+  private:
+    struct block {
+      std::unique_ptr<uint8_t[]> data;
+      size_t                     size;
+    };
+
+    std::vector<block> blocks_;
+    size_t             block_ = 0;
+    size_t             offset_ = 0;
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _EVENT_ARENA_H_
@@ -0,0 +1,161 @@
+#ifndef _FRAME_BUFFER_POOL_H_
+#define _FRAME_BUFFER_POOL_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief C# VideoSinkPoolStatistics C struct.
+   */
+  struct frame_buffer_pool_stats {
+    uint64_t hits;
+    uint64_t misses;
+    int32_t  outstanding;
+    int32_t  idle;
+  };
+
+  /**
+   * @brief Pool of frame buffers handed to the managed side.
+   *
+   * Every buffer is preceded by a header holding a reference to the pool it
+   * comes from, so that a buffer released after its video_sink has been deleted
+   * still finds its way back. Idle buffers are keyed by resolution; when more
+   * than max_depth buffers are idle the oldest ones are freed.
+   */
+  class frame_buffer_pool : public std::enable_shared_from_this<frame_buffer_pool> {
+    struct buffer_header {
+      std::shared_ptr<frame_buffer_pool> pool;
+      int    width;
+      int    height;
+      size_t size;
+    };
+
+    static constexpr size_t header_size = (sizeof(buffer_header) + 63) & ~size_t(63);
+
+  public:
+    static constexpr size_t default_max_depth = 4;
+
+    static std::shared_ptr<frame_buffer_pool> create(size_t max_depth = default_max_depth) {
+      return std::shared_ptr<frame_buffer_pool>(new frame_buffer_pool(max_depth));
+    }
+
+    ~frame_buffer_pool() {
+      for (auto header : idle_) {
+        destroy(header);
+      }
+    }
+
+    /**
+     * @brief Gets a buffer of at least size bytes for a frame of the given resolution.
+     *
+     * @return The buffer or nullptr if the allocation failed.
+     */
+    uint8_t* acquire(int width, int height, size_t size) {
+      buffer_header* header = nullptr;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(idle_.begin(), idle_.end(), [&](buffer_header* h) {
+          return h->width == width && h->height == height && h->size == size;
+        });
+
+        if (it != idle_.end()) {
+          header = *it;
+          idle_.erase(it);
+          hits_++;
+        } else {
+          misses_++;
+        }
+        outstanding_++;
+      }
+
+      if (header == nullptr) {
+        void* memory = malloc(header_size + size);
+        if (memory == nullptr) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          outstanding_--;
+          return nullptr;
+        }
+        header = new (memory) buffer_header{ nullptr, width, height, size };
+      }
+
+      header->pool = shared_from_this();
+      return reinterpret_cast<uint8_t*>(header) + header_size;
+    }
+
+    /**
+     * @brief Returns a buffer obtained from acquire() to its pool.
+     */
+    static bool release(uint8_t* buffer) {
+      if (buffer == nullptr) {
+        return false;
+      }
+
+      auto header = reinterpret_cast<buffer_header*>(buffer - header_size);
+      auto pool = std::move(header->pool);
+
+      if (pool) {
+        pool->recycle(header);
+      } else {
+        destroy(header);
+      }
+
+      return true;
+    }
+
+    void max_depth(size_t depth) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      max_depth_ = depth;
+      trim();
+    }
+
+    size_t max_depth() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return max_depth_;
+    }
+
+    frame_buffer_pool_stats stats() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return frame_buffer_pool_stats{ hits_, misses_, outstanding_, (int32_t)idle_.size() };
+    }
+
+  private:
+    frame_buffer_pool(size_t max_depth) : max_depth_(max_depth) {}
+
+    void recycle(buffer_header* header) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      outstanding_--;
+      idle_.push_back(header);
+      trim();
+    }
+
+    void trim() {
+      while (idle_.size() > max_depth_) {
+        destroy(idle_.front());
+        idle_.pop_front();
+      }
+    }
+
+    static void destroy(buffer_header* header) {
+      header->~buffer_header();
+      free(header);
+    }
+
+    std::mutex                 mutex_;
+    std::deque<buffer_header*> idle_;
+    size_t                     max_depth_;
+    uint64_t                   hits_ = 0;
+    uint64_t                   misses_ = 0;
+    int32_t                    outstanding_ = 0;
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _FRAME_BUFFER_POOL_H_
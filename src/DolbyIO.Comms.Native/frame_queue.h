@@ -0,0 +1,232 @@
+#ifndef _FRAME_QUEUE_H_
+#define _FRAME_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace dolbyio::comms::native {
+
+  enum class overflow_policy : int {
+    drop_oldest = 0,
+    drop_newest = 1,
+  };
+
+  /**
+   * @brief Bounded single producer single consumer ring of items stored by
+   * value in their slots.
+   *
+   * An index is owned by whoever advances the head past it, which lets the
+   * producer discard the oldest item when the ring is full without locking:
+   * producer and consumer race on the same compare and swap and exactly one
+   * of them takes the item out of its slot, marking the slot free again.
+   */
+  template<typename T>
+  class spsc_ring {
+  public:
+    spsc_ring(size_t capacity) : slots_(capacity) {}
+
+    size_t capacity() const {
+      return slots_.size();
+    }
+
+    /**
+     * @brief Adds an item, producer side. The item discarded to honour the
+     * overflow policy, the oldest one or the pushed item itself, is moved
+     * into dropped.
+     *
+     * @return Whether the pushed item was queued.
+     */
+    bool push(T&& item, overflow_policy policy, std::optional<T>& dropped) {
+      uint64_t tail = tail_.load(std::memory_order_relaxed);
+
+      // Taking the oldest item out leaves room, unless the head moved meanwhile
+      uint64_t head = head_.load(std::memory_order_acquire);
+      while (tail - head >= slots_.size()) {
+        if (policy == overflow_policy::drop_newest) {
+          dropped = std::move(item);
+          return false;
+        }
+
+        if (head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel)) {
+          dropped = take(head);
+          head++;
+        }
+      }
+
+      // The consumer may have claimed the previous item of this slot and not taken it out yet
+      auto& s = slot(tail);
+      while (s.full.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+
+      s.item = std::move(item);
+      s.full.store(true, std::memory_order_relaxed);
+      tail_.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * @brief Takes the oldest item, consumer side.
+     *
+     * @return false if the ring is empty.
+     */
+    bool pop(T& item) {
+      uint64_t head = head_.load(std::memory_order_acquire);
+      while (head != tail_.load(std::memory_order_acquire)) {
+        if (head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel)) {
+          item = take(head);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool empty() const {
+      return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+  private:
+    struct slot_type {
+      T                 item{};
+      std::atomic<bool> full{ false };
+    };
+
+    slot_type& slot(uint64_t index) {
+      return slots_[index % slots_.size()];
+    }
+
+    // Called by the owner of index
+    T take(uint64_t index) {
+      auto& s = slot(index);
+      T item = std::move(s.item);
+      s.full.store(false, std::memory_order_release);
+      return item;
+    }
+
+    std::vector<slot_type> slots_;
+    alignas(64) std::atomic<uint64_t> head_{ 0 };
+    alignas(64) std::atomic<uint64_t> tail_{ 0 };
+  };
+
+  /**
+   * @brief Hands items pushed by a producer thread to a callback running on a
+   * dedicated delivery thread, the items being moved through the ring.
+   *
+   * The producer never blocks: the consumer mutex is only taken to wake the
+   * delivery thread up when it went to sleep on an empty ring. The queue can be
+   * destroyed from within the callback, in which case the delivery thread
+   * exits as soon as the callback returns.
+   */
+  template<typename T>
+  class delivery_queue {
+  public:
+    using callback_type = std::function<void(T&)>;
+
+    delivery_queue(size_t depth, overflow_policy policy, callback_type deliver, callback_type discard)
+      : state_(std::make_shared<state>(depth, policy, std::move(deliver), std::move(discard))) {
+      thread_ = std::thread([s = state_]() { s->run(); });
+    }
+
+    ~delivery_queue() {
+      {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stopping = true;
+      }
+      state_->wakeup.notify_one();
+
+      if (thread_.get_id() == std::this_thread::get_id()) {
+        thread_.detach();
+      } else {
+        thread_.join();
+      }
+    }
+
+    /**
+     * @brief Queues an item, producer side.
+     *
+     * @return true if an item had to be discarded.
+     */
+    bool push(T item) {
+      std::optional<T> dropped;
+      if (state_->ring.push(std::move(item), state_->policy, dropped)) {
+        // Pairs with the fence in run(), either the delivery thread sees the item or we see it asleep
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (state_->sleeping.load(std::memory_order_relaxed)) {
+          std::lock_guard<std::mutex> lock(state_->mutex);
+          state_->wakeup.notify_one();
+        }
+      }
+
+      if (dropped) {
+        state_->discard(*dropped);
+        return true;
+      }
+
+      return false;
+    }
+
+    size_t depth() const {
+      return state_->ring.capacity();
+    }
+
+    overflow_policy policy() const {
+      return state_->policy;
+    }
+
+  private:
+    // Shared with the delivery thread, which can outlive the queue
+    struct state {
+      state(size_t depth, overflow_policy p, callback_type d, callback_type x)
+        : ring(depth), policy(p), deliver(std::move(d)), discard(std::move(x)) {}
+
+      ~state() {
+        T item;
+        while (ring.pop(item)) {
+          discard(item);
+        }
+      }
+
+      void run() {
+        T item;
+        while (true) {
+          while (!stopping && ring.pop(item)) {
+            deliver(item);
+          }
+
+          std::unique_lock<std::mutex> lock(mutex);
+          sleeping = true;
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          wakeup.wait(lock, [this]() { return stopping || !ring.empty(); });
+          sleeping = false;
+
+          if (stopping) {
+            return;
+          }
+        }
+      }
+
+      spsc_ring<T>            ring;
+      overflow_policy         policy;
+      callback_type           deliver;
+      callback_type           discard;
+
+      std::mutex              mutex;
+      std::condition_variable wakeup;
+      std::atomic<bool>       sleeping{ false };
+      std::atomic<bool>       stopping{ false };
+    };
+
+    std::shared_ptr<state> state_;
+    std::thread            thread_;
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _FRAME_QUEUE_H_
@@ -0,0 +1,68 @@
+#ifndef _FRAME_RATE_LIMITER_H_
+#define _FRAME_RATE_LIMITER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Decides which frames are let through to honour a maximum frame rate.
+   *
+   * Deadlines advance by a fixed interval from the previous one, and a frame
+   * arriving up to a quarter of the interval early is still accepted, so that
+   * capture jitter does not halve the delivered rate (e.g. 30 fps limited to 15).
+   */
+  class frame_rate_limiter {
+  public:
+    /**
+     * @brief Sets the maximum number of frames per second, 0 for no limit.
+     */
+    void max_fps(double fps) {
+      interval_us_ = fps > 0 ? (int64_t)(1000000.0 / fps) : 0;
+      next_due_us_ = 0;
+    }
+
+    double max_fps() const {
+      int64_t interval = interval_us_;
+      return interval > 0 ? 1000000.0 / interval : 0;
+    }
+
+    bool admit() {
+      return admit(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    bool admit(int64_t now_us) {
+      int64_t interval = interval_us_;
+      if (interval <= 0) {
+        return true;
+      }
+
+      int64_t due = next_due_us_.load();
+      do {
+        if (due != 0 && now_us < due - interval / 4) {
+          return false;
+        }
+      } while (!next_due_us_.compare_exchange_weak(due, next_due(due, now_us, interval)));
+
+      return true;
+    }
+
+  private:
+    static int64_t next_due(int64_t due, int64_t now_us, int64_t interval) {
+      // Restart the schedule after a gap instead of letting a burst through
+      if (due == 0 || now_us > due + interval) {
+        return now_us + interval;
+      }
+      return due + interval;
+    }
+
+    std::atomic<int64_t> interval_us_{ 0 };
+    std::atomic<int64_t> next_due_us_{ 0 };
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _FRAME_RATE_LIMITER_H_
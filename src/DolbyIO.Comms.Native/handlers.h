@@ -1,44 +1,268 @@
 #ifndef _HANDLERS_H_
 #define _HANDLERS_H_
 
-#include <map>
-#include <set>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 
-namespace dolbyio::comms::native {  
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Connection of one C# handler to an SDK event.
+   *
+   * The SDK hands the connection over asynchronously, possibly after the
+   * handler was already removed, in which case it is disconnected on arrival.
+   */
+  class handler_registration {
+  public:
+    // Called once add_event_handler() completed
+    void connected(dolbyio::comms::event_handler_id&& id) {
+      id_ = std::move(id);
+
+      int expected = pending;
+      if (!state_.compare_exchange_strong(expected, live, std::memory_order_acq_rel)) {
+        release(std::move(id_));
+      }
+    }
+
+    /**
+     * @brief Marks the handler removed.
+     *
+     * @return The connection to disconnect, nullptr if it is still pending.
+     */
+    dolbyio::comms::event_handler_id remove() {
+      if (state_.exchange(removed, std::memory_order_acq_rel) == live) {
+        return std::move(id_);
+      }
+
+      return nullptr;
+    }
+
+    /**
+     * @brief Disconnects without waiting, keeping the connection alive until done.
+     */
+    static void release(dolbyio::comms::event_handler_id&& id) {
+      if (!id) {
+        return;
+      }
+
+      std::shared_ptr<dolbyio::comms::event_handler_connection> connection(std::move(id));
+      connection->disconnect()
+        .then([connection]() {})
+        .on_error([connection](std::exception_ptr&&) {});
+    }
+
+  private:
+    enum { pending, live, removed };
+
+    std::atomic<int>                 state_{ pending };
+    dolbyio::comms::event_handler_id id_;
+  };
+
+  /**
+   * @brief Links the registries of all the events, so that Release() can
+   * disconnect every handler.
+   */
+  class handler_registry_base {
+  public:
+    /**
+     * @brief Disconnects the handlers of every event, waiting for the SDK.
+     */
+    static void disconnect_all() {
+      for (auto registry = head().load(std::memory_order_acquire); registry; registry = registry->next_) {
+        registry->disconnect();
+      }
+    }
+
+  protected:
+    handler_registry_base() {
+      next_ = head().load(std::memory_order_relaxed);
+      while (!head().compare_exchange_weak(next_, this, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    virtual ~handler_registry_base() = default;
+    virtual void disconnect() = 0;
+
+  private:
+    static std::atomic<handler_registry_base*>& head() {
+      static std::atomic<handler_registry_base*> registries{ nullptr };
+      return registries;
+    }
+
+    handler_registry_base* next_ = nullptr;
+  };
+
+  /**
+   * @brief Handlers of one event, keyed by the hash of the C# delegate.
+   *
+   * The handlers are held in an immutable list swapped atomically on every
+   * change, so that lookups never wait and concurrent adds and removes retry
+   * instead of serializing on a lock.
+   */
+  template<typename Handler>
+  class handler_registry : public handler_registry_base {
+  public:
+    using entries = std::vector<std::pair<std::int32_t, std::shared_ptr<handler_registration>>>;
+
+    static handler_registry& instance() {
+      static handler_registry registry;
+      return registry;
+    }
+
+    /**
+     * @brief Adds the registration of hash.
+     *
+     * @return The registration it replaced, if any.
+     */
+    std::shared_ptr<handler_registration> add(std::int32_t hash, std::shared_ptr<handler_registration> registration) {
+      std::shared_ptr<handler_registration> replaced;
+      update([&](entries& list) {
+        replaced = nullptr;
+        for (auto& entry : list) {
+          if (entry.first == hash) {
+            replaced = std::exchange(entry.second, registration);
+            return;
+          }
+        }
+
+        list.emplace_back(hash, registration);
+      });
+
+      return replaced;
+    }
+
+    /**
+     * @brief Removes the registration of hash.
+     *
+     * @return The registration removed, nullptr if hash is unknown.
+     */
+    std::shared_ptr<handler_registration> take(std::int32_t hash) {
+      std::shared_ptr<handler_registration> taken;
+      update([&](entries& list) {
+        taken = nullptr;
+        for (auto it = list.begin(); it != list.end(); ++it) {
+          if (it->first == hash) {
+            taken = std::move(it->second);
+            list.erase(it);
+            return;
+          }
+        }
+      });
+
+      return taken;
+    }
+
+    /**
+     * @brief Removes the registration of hash, unless it was replaced since.
+     *
+     * @return Whether registration was removed.
+     */
+    bool discard(std::int32_t hash, const std::shared_ptr<handler_registration>& registration) {
+      bool discarded;
+      update([&](entries& list) {
+        discarded = false;
+        for (auto it = list.begin(); it != list.end(); ++it) {
+          if (it->first == hash && it->second == registration) {
+            list.erase(it);
+            discarded = true;
+            return;
+          }
+        }
+      });
+
+      return discarded;
+    }
+
+    bool contains(std::int32_t hash) const {
+      auto list = std::atomic_load_explicit(&entries_, std::memory_order_acquire);
+      for (const auto& entry : *list) {
+        if (entry.first == hash) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    size_t size() const {
+      return std::atomic_load_explicit(&entries_, std::memory_order_acquire)->size();
+    }
+
+  protected:
+    void disconnect() override {
+      auto list = std::atomic_exchange_explicit(&entries_, std::make_shared<const entries>(), std::memory_order_acq_rel);
+      for (const auto& entry : *list) {
+        auto connection = entry.second->remove();
+        if (connection) {
+          wait(connection->disconnect());
+        }
+      }
+    }
+
+  private:
+    handler_registry() = default;
+
+    // Applies f to a copy of the list until the copy replaces an unchanged list
+    template<typename F> void update(F&& f) {
+      auto current = std::atomic_load_explicit(&entries_, std::memory_order_acquire);
+      std::shared_ptr<const entries> next;
+      do {
+        auto copy = std::make_shared<entries>(*current);
+        f(*copy);
+        next = std::move(copy);
+      } while (!std::atomic_compare_exchange_weak_explicit(&entries_, &current, next,
+                                                           std::memory_order_acq_rel, std::memory_order_acquire));
+    }
+
+    std::shared_ptr<const entries> entries_ = std::make_shared<const entries>();
+  };
 
-  extern std::map<std::string, std::map<std::int32_t, dolbyio::comms::event_handler_id>> handlers_map;
-  
   template<typename Handler>
   void disconnect_handler(std::int32_t hash, typename Handler::type handler) {
-    auto result = handlers_map.find(Handler::name);
-    
-    if (result != std::end(handlers_map)) {
-      auto event_handler = result->second.find(hash);
-      if (event_handler != std::end(result->second)) {
-        wait(event_handler->second->disconnect());
+    auto registration = handler_registry<Handler>::instance().take(hash);
+    if (registration) {
+      auto connection = registration->remove();
+      if (connection) {
+        wait(connection->disconnect());
       }
     }
   }
 
+  /**
+   * @brief Subscribes f to the event of Handler without waiting for the SDK,
+   * replacing the handler previously added with the same hash.
+   *
+   * If the SDK refuses the handler, its registration is discarded, so that
+   * adding it again retries, and the failure is recorded as the last error
+   * of the SDK thread, like a failed completion.
+   */
   template<typename Handler, typename Service>
   void handle(Service& service, std::int32_t hash, typename Handler::type handler, std::function<void(const typename Handler::event&)> f) {
 #ifndef MOCK
-    if (handlers_map.find(Handler::name) == handlers_map.end()) {
-      handlers_map.emplace(Handler::name, std::map<std::int32_t, dolbyio::comms::event_handler_id>{});
+    auto registration = std::make_shared<handler_registration>();
+    auto replaced = handler_registry<Handler>::instance().add(hash, registration);
+    if (replaced) {
+      handler_registration::release(replaced->remove());
     }
 
-    auto it = handlers_map.find(Handler::name);
-    if (it != handlers_map.end()) {
-      auto test = reinterpret_cast<std::intptr_t>(handler);
-      it->second.emplace(hash, wait(service.add_event_handler(std::move(f))));
-    }
+    service.add_event_handler(std::move(f))
+      .then([registration](dolbyio::comms::event_handler_id&& id) {
+        registration->connected(std::move(id));
+      })
+      .on_error([hash, registration](std::exception_ptr&& e) {
+        handler_registry<Handler>::instance().discard(hash, registration);
+        registration->remove();
+        last_error::current().set(std::move(e));
+      });
 #endif
   }
-  
+
   template<typename Handler, typename Service>
   void handle(Service& service, typename Handler::type handler, std::function<void(const typename Handler::event&)> f) {
     handle<Handler, Service>(service, 0, handler, f);
   }
 } // namespace dolbyio::comms::native
 
-#endif // _HANDLERS_H_
\ No newline at end of file
+#endif // _HANDLERS_H_
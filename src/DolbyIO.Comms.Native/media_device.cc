@@ -1,15 +1,83 @@
 #include "sdk.h"
 #include "media_device.h"
+#include "device_cache.h"
 #include "handlers.h"
 
 namespace dolbyio::comms::native {
 extern "C" {
 
+  static audio_device_list audio_devices;
+  static camera_device_list video_devices;
+  static std::mutex devices_lock;
+
+  // Starts following the device events, once per SDK instance as Release() drops
+  // the handlers. The devices are enumerated on the first lookup, the handles of
+  // removed audio devices are reclaimed as they go.
+  static void follow_devices() {
+#ifndef MOCK
+    std::lock_guard<std::mutex> lock(devices_lock);
+    if (handler_registry<on_cached_audio_device_added>::instance().contains(0)) {
+      return;
+    }
+
+    audio_devices.invalidate();
+    video_devices.invalidate();
+
+    handle<on_cached_audio_device_added>(sdk->device_management(), nullptr,
+      [](const on_cached_audio_device_added::event& e) {
+        audio_devices.upsert(e.device);
+      }
+    );
+
+    handle<on_cached_audio_device_removed>(sdk->device_management(), nullptr,
+      [](const on_cached_audio_device_removed::event& e) {
+        audio_devices.erase([&e](const dolbyio::comms::audio_device& device) {
+          return device.get_identity() == e.device_id;
+        });
+        device_handles::instance().remove(e.device_id);
+      }
+    );
+
+    // The current device is normally known, otherwise the cache missed a device
+    handle<on_cached_audio_device_changed>(sdk->device_management(), nullptr,
+      [](const on_cached_audio_device_changed::event& e) {
+        if (e.device.has_value() && !audio_devices.contains([&e](const dolbyio::comms::audio_device& device) {
+              return device.get_identity() == e.device.value();
+            })) {
+          audio_devices.invalidate();
+        }
+      }
+    );
+
+    handle<on_cached_video_device_added>(sdk->device_management(), nullptr,
+      [](const on_cached_video_device_added::event& e) {
+        video_devices.upsert(e.device);
+      }
+    );
+
+    handle<on_cached_video_device_changed>(sdk->device_management(), nullptr,
+      [](const on_cached_video_device_changed::event& e) {
+        video_devices.upsert(e.device);
+      }
+    );
+
+    handle<on_cached_video_device_removed>(sdk->device_management(), nullptr,
+      [](const on_cached_video_device_removed::event& e) {
+        video_devices.erase([&e](const camera_device& device) {
+          return device.unique_id == e.uid;
+        });
+      }
+    );
+#endif
+  }
+
   EXPORT_API void AddOnAudioDeviceAddedHandler(std::int32_t hash, on_audio_device_added::type handler) {
+    follow_devices();
     handle<on_audio_device_added>(sdk->device_management(), hash, handler, 
       [handler](const on_audio_device_added::event& e) {
+        event_scope scope;
         audio_device dev;
-        no_alloc_to_c(&dev, e.device);
+        scope.no_alloc_to_c(&dev, e.device);
         handler(dev);
       }
     );
@@ -22,10 +90,11 @@ extern "C" {
   }
 
   EXPORT_API void AddOnAudioDeviceRemovedHandler(std::int32_t hash, on_audio_device_removed::type handler) {
+    follow_devices();
     handle<on_audio_device_removed>(sdk->device_management(), hash, handler, 
       [handler](const on_audio_device_removed::event& e) {
         device_identity id;
-        id.value = (void*)new dolbyio::comms::audio_device::identity(e.device_id);
+        id.value = device_handles::instance().find(e.device_id);
         handler(id);
       }
     );
@@ -38,12 +107,13 @@ extern "C" {
   }
 
   EXPORT_API void AddOnAudioDeviceChangedHandler(std::int32_t hash, on_audio_device_changed::type handler) {
+    follow_devices();
     handle<on_audio_device_changed>(sdk->device_management(), hash, handler, 
       [handler](const on_audio_device_changed::event& e) {
-        device_identity dev;
+        device_identity dev{ device_handles::no_handle };
 
         if (e.device.has_value()) {
-          dev.value = new dolbyio::comms::audio_device::identity(e.device.value());
+          dev.value = device_handles::instance().intern(e.device.value());
         }
 
         handler(dev, !e.device.has_value());
@@ -60,8 +130,9 @@ extern "C" {
   EXPORT_API void AddOnVideoDeviceAddedHandler(std::int32_t hash, on_video_device_added::type handler) {
     handle<on_video_device_added>(sdk->device_management(), hash, handler,
       [handler](const on_video_device_added::event& e) {
+        event_scope scope;
         video_device dev;
-        no_alloc_to_c(&dev, e.device);
+        scope.no_alloc_to_c(&dev, e.device);
         handler(dev);
       }
     );
@@ -76,8 +147,9 @@ extern "C" {
   EXPORT_API void AddOnVideoDeviceChangedHandler(std::int32_t hash, on_video_device_changed::type handler) {
     handle<on_video_device_changed>(sdk->device_management(), hash, handler,
       [handler](const on_video_device_changed::event& e) {
+        event_scope scope;
         video_device dev;
-        no_alloc_to_c(&dev, e.device);
+        scope.no_alloc_to_c(&dev, e.device);
         handler(dev);
       }
     );
@@ -92,7 +164,8 @@ extern "C" {
   EXPORT_API void AddOnVideoDeviceRemovedHandler(std::int32_t hash, on_video_device_removed::type handler) {
     handle<on_video_device_removed>(sdk->device_management(), hash, handler,
       [handler](const on_video_device_removed::event& e) {
-        handler(strdup(e.uid));
+        event_scope scope;
+        handler(scope.strdup(e.uid));
       }
     );
   }
@@ -103,13 +176,87 @@ extern "C" {
     }}.result();
   }
 
-  EXPORT_API bool AudioDeviceEquals(dolbyio::comms::audio_device::identity* id1, dolbyio::comms::audio_device::identity* id2) {
-    return (*id1) == (*id2);
+  static std::vector<dolbyio::comms::audio_device> cached_audio_devices() {
+    follow_devices();
+
+    std::vector<dolbyio::comms::audio_device> devices;
+    if (!audio_devices.get(devices)) {
+      uint64_t generation = audio_devices.generation();
+      devices = wait(sdk->device_management().get_audio_devices());
+      audio_devices.fill(devices, generation);
+    }
+
+    return devices;
+  }
+
+  static auto same_identity(const dolbyio::comms::native::audio_device& dev) {
+    auto identity = device_handles::instance().identity(dev.identity.value);
+    return [identity](const dolbyio::comms::audio_device& device) {
+      return identity.has_value() && device.get_identity() == *identity;
+    };
+  }
+
+  /**
+   * @brief Finds the SDK device of dev in the cache, enumerating the devices
+   * again when the cache misses it.
+   */
+  static std::optional<dolbyio::comms::audio_device> find_audio_device(const dolbyio::comms::native::audio_device& dev) {
+    follow_devices();
+
+    auto match = same_identity(dev);
+    auto device = audio_devices.find(dev.name ? dev.name : "", match);
+    if (device.has_value()) {
+      return device;
+    }
+
+    audio_devices.invalidate();
+    auto devices = cached_audio_devices();
+    auto result = std::find_if(devices.begin(), devices.end(), match);
+    if (result != devices.end()) {
+      return *result;
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Sets the preferred device from the cache, or once the devices were enumerated again on a miss.
+   */
+  static void set_preferred_audio_device_async(const dolbyio::comms::native::audio_device& dev, bool input, const completion& c) {
+    auto set_preferred = [input](const dolbyio::comms::audio_device& device) {
+      return input
+        ? sdk->device_management().set_preferred_input_audio_device(device)
+        : sdk->device_management().set_preferred_output_audio_device(device);
+    };
+
+    follow_devices();
+
+    auto match = same_identity(dev);
+    auto device = audio_devices.find(dev.name ? dev.name : "", match);
+    if (device.has_value()) {
+      c.attach(set_preferred(*device));
+      return;
+    }
+
+    audio_devices.invalidate();
+    uint64_t generation = audio_devices.generation();
+    sdk->device_management().get_audio_devices()
+      .then([c, match, set_preferred, generation](std::vector<dolbyio::comms::audio_device>&& devices) {
+        audio_devices.fill(devices, generation);
+
+        auto result = std::find_if(devices.begin(), devices.end(), match);
+        if (result != std::end(devices)) {
+          c.attach(set_preferred(*result));
+        } else {
+          c.succeed();
+        }
+      })
+      .on_error(c.failed());
   }
 
   EXPORT_API int GetAudioDevices(int* size, dolbyio::comms::native::audio_device** dest) {
     return call { [&]() {
-      auto devices = wait(sdk->device_management().get_audio_devices());
+      auto devices = cached_audio_devices();
       (*dest) = (dolbyio::comms::native::audio_device*) malloc(sizeof(dolbyio::comms::native::audio_device) * devices.size());
       
       std::for_each(devices.begin(), devices.end(), [&devices, dest](const dolbyio::comms::audio_device& device) {
@@ -121,34 +268,56 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int GetAudioDevicesAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      follow_devices();
+
+      std::vector<dolbyio::comms::audio_device> devices;
+      if (audio_devices.get(devices)) {
+        c.complete(devices, as_array<dolbyio::comms::native::audio_device>{});
+        return;
+      }
+
+      uint64_t generation = audio_devices.generation();
+      c.attach(sdk->device_management().get_audio_devices(),
+        [generation](event_scope& scope, const std::vector<dolbyio::comms::audio_device>& devices, int& count) {
+          audio_devices.fill(devices, generation);
+          return as_array<dolbyio::comms::native::audio_device>{}(scope, devices, count);
+        }
+      );
+    }}.result();
+  }
+
   EXPORT_API int SetPreferredAudioInputDevice(dolbyio::comms::native::audio_device dev) {
     return call { [&]() {
-      auto devices = wait(sdk->device_management().get_audio_devices());
-      auto result = std::find_if(devices.begin(), devices.end(), [&dev](const dolbyio::comms::audio_device& device) {
-        dolbyio::comms::audio_device::identity* identity = (dolbyio::comms::audio_device::identity*)dev.identity.value;
-        return device.get_identity() == *identity;
-      });
-
-      if (result != std::end(devices)) {
-        wait(sdk->device_management().set_preferred_input_audio_device(*result));
+      auto device = find_audio_device(dev);
+      if (device.has_value()) {
+        wait(sdk->device_management().set_preferred_input_audio_device(*device));
       }
     }}.result();
   }
 
+  EXPORT_API int SetPreferredAudioInputDeviceAsync(dolbyio::comms::native::audio_device dev, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      set_preferred_audio_device_async(dev, true, c);
+    }}.result();
+  }
+
   EXPORT_API int SetPreferredAudioOutputDevice(dolbyio::comms::native::audio_device dev) {
     return call { [&]() {
-      auto devices = wait(sdk->device_management().get_audio_devices());
-      auto result = std::find_if(devices.begin(), devices.end(), [&dev](const dolbyio::comms::audio_device& device) {
-        dolbyio::comms::audio_device::identity* identity = (dolbyio::comms::audio_device::identity*)dev.identity.value;
-        return device.get_identity() == *identity;
-      });
-
-      if (result != std::end(devices)) {
-        wait(sdk->device_management().set_preferred_output_audio_device(*result));
+      auto device = find_audio_device(dev);
+      if (device.has_value()) {
+        wait(sdk->device_management().set_preferred_output_audio_device(*device));
       }
     }}.result();
   }
 
+  EXPORT_API int SetPreferredAudioOutputDeviceAsync(dolbyio::comms::native::audio_device dev, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      set_preferred_audio_device_async(dev, false, c);
+    }}.result();
+  }
+
   EXPORT_API int GetCurrentAudioInputDevice(dolbyio::comms::native::audio_device* dev) {
     return call { [&]() {
       auto device = wait(sdk->device_management().get_current_audio_input_device());
@@ -159,6 +328,12 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int GetCurrentAudioInputDeviceAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->device_management().get_current_audio_input_device(), as_struct<dolbyio::comms::native::audio_device>{});
+    }}.result();
+  }
+
   EXPORT_API int GetCurrentAudioOutputDevice(dolbyio::comms::native::audio_device* dev) {
     return call { [&]() {
       auto device = wait(sdk->device_management().get_current_audio_output_device());
@@ -169,9 +344,23 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int GetCurrentAudioOutputDeviceAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->device_management().get_current_audio_output_device(), as_struct<dolbyio::comms::native::audio_device>{});
+    }}.result();
+  }
+
   EXPORT_API int GetVideoDevices(int* size, dolbyio::comms::native::video_device** dest) {
     return call { [&]() {
-      auto devices = wait(sdk->device_management().get_video_devices());
+      follow_devices();
+
+      std::vector<camera_device> devices;
+      if (!video_devices.get(devices)) {
+        uint64_t generation = video_devices.generation();
+        devices = wait(sdk->device_management().get_video_devices());
+        video_devices.fill(devices, generation);
+      }
+
       (*dest) = (dolbyio::comms::native::video_device*) malloc(sizeof(dolbyio::comms::native::video_device) * devices.size());
       
       std::for_each(devices.begin(), devices.end(), [&devices, dest](const camera_device& device) {
@@ -183,6 +372,26 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int GetVideoDevicesAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      follow_devices();
+
+      std::vector<camera_device> devices;
+      if (video_devices.get(devices)) {
+        c.complete(devices, as_array<dolbyio::comms::native::video_device>{});
+        return;
+      }
+
+      uint64_t generation = video_devices.generation();
+      c.attach(sdk->device_management().get_video_devices(),
+        [generation](event_scope& scope, const std::vector<camera_device>& devices, int& count) {
+          video_devices.fill(devices, generation);
+          return as_array<dolbyio::comms::native::video_device>{}(scope, devices, count);
+        }
+      );
+    }}.result();
+  }
+
   EXPORT_API int GetCurrentVideoDevice(dolbyio::comms::native::video_device* dev) {
     return call { [&]() {
       auto device = wait(sdk->device_management().get_current_video_device());
@@ -193,6 +402,12 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int GetCurrentVideoDeviceAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->device_management().get_current_video_device(), as_struct<dolbyio::comms::native::video_device>{});
+    }}.result();
+  }
+
   EXPORT_API int GetScreenShareSources(int* size, dolbyio::comms::native::screen_share_source** dest) {
     return call { [&]() {
       auto sources = wait(sdk->device_management().get_screen_share_sources());
@@ -207,13 +422,10 @@ extern "C" {
     }}.result();
   }
 
-  EXPORT_API bool DeleteDeviceIdentity(dolbyio::comms::audio_device::identity* identity) {
-    if (identity) {
-      delete identity;
-      return true;
-    }
-
-    return false;
+  EXPORT_API int GetScreenShareSourcesAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->device_management().get_screen_share_sources(), as_array<dolbyio::comms::native::screen_share_source>{});
+    }}.result();
   }
 
 } // extern "C"
@@ -2,14 +2,15 @@
 #define _MEDIA_DEVICE_H_
 
 #include "sdk.h"
+#include "device_handles.h"
 
 namespace dolbyio::comms::native {
 
   /**
-   * @brief C# DeviceIdentity C struct.
+   * @brief C# DeviceIdentity C struct, holding a device_handles handle.
    */
   struct device_identity {
-    void* value;
+    int32_t value;
   };
 
   /**
@@ -74,6 +75,43 @@ namespace dolbyio::comms::native {
     static constexpr const char* name = "on_video_device_changed";
   };
 
+  // Native handlers keeping the device cache up to date, registered under hash 0
+  struct on_cached_audio_device_added {
+    using event = dolbyio::comms::audio_device_added;
+    using type = void*;
+    static constexpr const char* name = "on_cached_audio_device_added";
+  };
+
+  struct on_cached_audio_device_removed {
+    using event = dolbyio::comms::audio_device_removed;
+    using type = void*;
+    static constexpr const char* name = "on_cached_audio_device_removed";
+  };
+
+  struct on_cached_audio_device_changed {
+    using event = dolbyio::comms::audio_device_changed;
+    using type = void*;
+    static constexpr const char* name = "on_cached_audio_device_changed";
+  };
+
+  struct on_cached_video_device_added {
+    using event = dolbyio::comms::video_device_added;
+    using type = void*;
+    static constexpr const char* name = "on_cached_video_device_added";
+  };
+
+  struct on_cached_video_device_removed {
+    using event = dolbyio::comms::video_device_removed;
+    using type = void*;
+    static constexpr const char* name = "on_cached_video_device_removed";
+  };
+
+  struct on_cached_video_device_changed {
+    using event = dolbyio::comms::video_device_changed;
+    using type = void*;
+    static constexpr const char* name = "on_cached_video_device_changed";
+  };
+
   /**
    * @brief Translator specialisation for dolbyio::comms::dvc_device.
    * 
@@ -82,7 +120,7 @@ namespace dolbyio::comms::native {
   template<typename Traits> 
   struct translator<dolbyio::comms::native::audio_device, dolbyio::comms::audio_device, Traits> {
     static void to_c(typename Traits::c_type* dest, const typename Traits::cpp_type& src) {
-      dest->identity.value = (void *)new dolbyio::comms::audio_device::identity(src.get_identity());
+      dest->identity.value = device_handles::instance().intern(src.get_identity());
       dest->name = strdup(src.name());
       dest->direction = to_underlying(src.direction());
     }
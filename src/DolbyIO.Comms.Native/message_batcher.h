@@ -0,0 +1,268 @@
+#ifndef _MESSAGE_BATCHER_H_
+#define _MESSAGE_BATCHER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Packs several conference messages into one, and splits them back.
+   *
+   * A frame is the header followed by every message as its length in decimal
+   * digits, a colon and its bytes, so that messages may hold any character.
+   * A received message that is not a well-formed frame is a single message.
+   */
+  struct message_frame {
+    static constexpr std::string_view header = "#dolbyio.frame/1#";
+
+    // Bytes a message adds to a frame
+    static size_t encoded_size(size_t length) {
+      size_t digits = 1;
+      for (size_t n = length; n >= 10; n /= 10) {
+        digits++;
+      }
+      return digits + 1 + length;
+    }
+
+    static void append(std::string& frame, std::string_view message) {
+      if (frame.empty()) {
+        frame.append(header);
+      }
+
+      frame.append(std::to_string(message.size()));
+      frame.push_back(':');
+      frame.append(message);
+    }
+
+    /**
+     * @brief Calls f with every message of frame.
+     *
+     * @return The number of messages, -1 if frame is not a frame, in which
+     * case f is never called.
+     */
+    template<typename F> static int split(std::string_view frame, F&& f) {
+      if (count(frame) < 0) {
+        return -1;
+      }
+
+      return parse(frame, f);
+    }
+
+    static int count(std::string_view frame) {
+      auto ignore = [](std::string_view) {};
+      return parse(frame, ignore);
+    }
+
+  private:
+    template<typename F> static int parse(std::string_view frame, F& f) {
+      if (frame.substr(0, header.size()) != header) {
+        return -1;
+      }
+
+      int messages = 0;
+      size_t pos = header.size();
+      while (pos < frame.size()) {
+        size_t length = 0;
+        size_t digits = 0;
+        for (; pos < frame.size() && frame[pos] >= '0' && frame[pos] <= '9' && digits < 9; pos++, digits++) {
+          length = 10 * length + (frame[pos] - '0');
+        }
+
+        if (digits == 0 || pos >= frame.size() || frame[pos] != ':' || frame.size() - pos - 1 < length) {
+          return -1;
+        }
+
+        f(frame.substr(pos + 1, length));
+        pos += 1 + length;
+        messages++;
+      }
+
+      return messages;
+    }
+  };
+
+  /**
+   * @brief C# MessageBatchStatistics struct.
+   */
+  struct message_batch_statistics {
+    uint64_t messages;      // Messages queued
+    uint64_t frames;        // Frames handed to the SDK
+    uint64_t failed_frames; // Frames the SDK failed to send
+  };
+
+  /**
+   * @brief Queues outgoing conference messages into frames, sent once the next
+   * message would not fit in max_frame_size bytes or max_delay after the
+   * first message of the frame was queued.
+   *
+   * A message larger than max_frame_size is sent in a frame of its own. Frames
+   * are sent in order, whether by the queuing thread, the flush thread or an
+   * explicit flush. Once stopped, the batcher refuses messages, which the
+   * caller sends on its own.
+   */
+  class message_batcher : public std::enable_shared_from_this<message_batcher> {
+  public:
+    // Sends a frame without waiting, calling failed if the SDK could not send it
+    using sink_type = std::function<void(std::string&& frame, std::function<void()> failed)>;
+
+    static std::shared_ptr<message_batcher> create(sink_type sink, size_t max_frame_size, std::chrono::milliseconds max_delay) {
+      std::shared_ptr<message_batcher> batcher(new message_batcher(std::move(sink), max_frame_size, max_delay));
+      batcher->thread_ = std::thread([batcher]() { batcher->run(); });
+      return batcher;
+    }
+
+    ~message_batcher() {
+      if (thread_.joinable()) {
+        if (thread_.get_id() == std::this_thread::get_id()) {
+          thread_.detach();
+        } else {
+          thread_.join();
+        }
+      }
+    }
+
+    /**
+     * @brief Queues a message.
+     *
+     * @return false if the batcher was stopped, the message not being queued.
+     */
+    bool push(std::string_view message) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (stopping_) {
+        return false;
+      }
+
+      statistics_.messages++;
+
+      if (!pending_.empty() && pending_.size() + message_frame::encoded_size(message.size()) > max_frame_size_) {
+        send(lock, sink_);
+      }
+
+      if (pending_.empty()) {
+        deadline_ = std::chrono::steady_clock::now() + max_delay_;
+        wakeup_.notify_one();
+      }
+
+      message_frame::append(pending_, message);
+      if (pending_.size() >= max_frame_size_) {
+        send(lock, sink_);
+      }
+
+      return true;
+    }
+
+    /**
+     * @brief Sends the pending frame on the calling thread through send.
+     *
+     * @return Whether there was a frame to send.
+     */
+    template<typename Send> bool flush(Send&& send_frame) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      return send(lock, send_frame);
+    }
+
+    bool flush() {
+      return flush(sink_);
+    }
+
+    /**
+     * @brief Stops the flush thread, then sends the pending frame. Returns
+     * once every frame was handed to the sink, none being sent afterwards.
+     */
+    void stop() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+      }
+      wakeup_.notify_one();
+
+      if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+        thread_.join();
+      }
+
+      std::unique_lock<std::mutex> lock(mutex_);
+      send(lock, sink_);
+      lock.unlock();
+
+      // Waits for the frames the queuing threads are still handing over
+      std::lock_guard<std::mutex> sent(send_mutex_);
+    }
+
+    message_batch_statistics statistics() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      message_batch_statistics statistics = statistics_;
+      statistics.failed_frames = failed_frames_.load(std::memory_order_relaxed);
+      return statistics;
+    }
+
+  private:
+    message_batcher(sink_type sink, size_t max_frame_size, std::chrono::milliseconds max_delay)
+      : sink_(std::move(sink)), max_frame_size_(max_frame_size), max_delay_(max_delay) {}
+
+    void run() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true) {
+        wakeup_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+        wakeup_.wait_until(lock, deadline_, [this]() { return stopping_ || pending_.empty(); });
+
+        if (stopping_) {
+          return;
+        }
+
+        send(lock, sink_);
+      }
+    }
+
+    // Called with the lock held, released while the frame is handed over
+    template<typename Send> bool send(std::unique_lock<std::mutex>& lock, Send& send_frame) {
+      if (pending_.empty()) {
+        return false;
+      }
+
+      std::string frame;
+      frame.swap(pending_);
+      statistics_.frames++;
+
+      // Taken before unlocking, so that the frames are sent in the order they were closed
+      std::unique_lock<std::mutex> ordered(send_mutex_);
+      lock.unlock();
+
+      std::weak_ptr<message_batcher> self = weak_from_this();
+      send_frame(std::move(frame), [self]() {
+        if (auto batcher = self.lock()) {
+          batcher->failed_frames_.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+
+      ordered.unlock();
+      lock.lock();
+      return true;
+    }
+
+    sink_type                              sink_;
+    size_t                                 max_frame_size_;
+    std::chrono::milliseconds              max_delay_;
+    std::thread                            thread_;
+
+    mutable std::mutex                     mutex_;
+    std::mutex                             send_mutex_;
+    std::condition_variable                wakeup_;
+    bool                                   stopping_ = false;
+    std::chrono::steady_clock::time_point  deadline_;
+    std::string                            pending_;
+    message_batch_statistics               statistics_{};
+    std::atomic<uint64_t>                  failed_frames_{ 0 };
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _MESSAGE_BATCHER_H_
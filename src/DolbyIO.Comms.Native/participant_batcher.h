@@ -0,0 +1,142 @@
+#ifndef _PARTICIPANT_BATCHER_H_
+#define _PARTICIPANT_BATCHER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "conference.h"
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Coalesces the participant added and updated events over a time
+   * window and hands them to C# as one array of participant structs.
+   *
+   * Only the latest state of every participant is kept, in the order the
+   * participants first appeared in the window. The window opens with the first
+   * event following a flush, so a burst is delivered at most window after it
+   * started, and a quiet conference costs nothing.
+   */
+  class participant_batcher {
+  public:
+    using delegate_type = void (*)(participant* participants, int count);
+
+    static std::shared_ptr<participant_batcher> create(delegate_type delegate, std::chrono::milliseconds window) {
+      std::shared_ptr<participant_batcher> batcher(new participant_batcher(delegate, window));
+      // The thread co-owns the batcher so that stop() can be called from within the delegate
+      batcher->thread_ = std::thread([batcher]() { batcher->run(); });
+      return batcher;
+    }
+
+    ~participant_batcher() {
+      if (thread_.joinable()) {
+        if (thread_.get_id() == std::this_thread::get_id()) {
+          thread_.detach();
+        } else {
+          thread_.join();
+        }
+      }
+    }
+
+    void push(const dolbyio::comms::participant_info& p) {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      // Late event of a handler replaced or released meanwhile
+      if (stopping_) {
+        return;
+      }
+
+      if (pending_.empty()) {
+        deadline_ = std::chrono::steady_clock::now() + window_;
+        wakeup_.notify_one();
+      }
+
+      auto it = index_.find(p.user_id);
+      if (it != index_.end()) {
+        pending_[it->second] = p;
+      } else {
+        index_.emplace(p.user_id, pending_.size());
+        pending_.push_back(p);
+      }
+    }
+
+    /**
+     * @brief Delivers the pending participants on the calling thread without
+     * waiting for the end of the window.
+     */
+    void flush() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      deliver(lock);
+    }
+
+    /**
+     * @brief Stops the flush thread, discarding the pending participants and
+     * the ones pushed from then on.
+     */
+    void stop() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+      pending_.clear();
+      index_.clear();
+      wakeup_.notify_one();
+    }
+
+  private:
+    participant_batcher(delegate_type delegate, std::chrono::milliseconds window)
+      : delegate_(delegate), window_(window) {}
+
+    void run() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true) {
+        wakeup_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+        wakeup_.wait_until(lock, deadline_, [this]() { return stopping_ || pending_.empty(); });
+
+        if (stopping_) {
+          return;
+        }
+
+        deliver(lock);
+      }
+    }
+
+    // Called with the lock held, released while the delegate runs
+    void deliver(std::unique_lock<std::mutex>& lock) {
+      if (pending_.empty()) {
+        return;
+      }
+
+      std::vector<dolbyio::comms::participant_info> batch;
+      batch.swap(pending_);
+      index_.clear();
+      lock.unlock();
+
+      event_scope scope;
+      participant* participants = scope.allocate<participant>(batch.size());
+      for (size_t i = 0; i < batch.size(); i++) {
+        scope.no_alloc_to_c(&participants[i], batch[i]);
+      }
+
+      delegate_(participants, (int)batch.size());
+      lock.lock();
+    }
+
+    delegate_type                                  delegate_;
+    std::chrono::milliseconds                      window_;
+    std::thread                                    thread_;
+
+    std::mutex                                     mutex_;
+    std::condition_variable                        wakeup_;
+    bool                                           stopping_ = false;
+    std::chrono::steady_clock::time_point          deadline_;
+    std::vector<dolbyio::comms::participant_info>  pending_;
+    std::unordered_map<std::string, size_t>        index_;
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _PARTICIPANT_BATCHER_H_
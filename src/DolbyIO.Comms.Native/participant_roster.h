@@ -0,0 +1,165 @@
+#ifndef _PARTICIPANT_ROSTER_H_
+#define _PARTICIPANT_ROSTER_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "conference.h"
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Copy of the participants of the current conference, kept up to date
+   * from the participant events so that polling it does not go through the SDK.
+   *
+   * Every change stamps the participant with the next roster version. Removed
+   * participants are kept as tombstones so that changes_since() can report them,
+   * up to max_tombstones of them: a caller older than the last dropped tombstone
+   * gets a full snapshot instead of the changes.
+   */
+  class participant_roster {
+  public:
+    using delegate_type = void (*)(uint64_t version, int snapshot, participant* changed, int changed_count, char** removed, int removed_count);
+
+    static constexpr size_t max_tombstones = 1024;
+
+    /**
+     * @brief Adds or updates a participant.
+     *
+     * @param only_if_absent Keeps the current state of a known participant,
+     * used when seeding the roster from a possibly older conference state.
+     */
+    void upsert(const dolbyio::comms::participant_info& p, bool only_if_absent = false) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = entries_.find(p.user_id);
+      if (it == entries_.end()) {
+        it = entries_.emplace(p.user_id, entry{}).first;
+        it->second.id = &it->first;
+      } else if (only_if_absent && !it->second.removed) {
+        return;
+      } else {
+        if (it->second.removed) {
+          tombstones_--;
+        }
+        by_version_.erase(it->second.version);
+      }
+
+      it->second.info = p;
+      it->second.removed = false;
+      stamp(it->second);
+    }
+
+    /**
+     * @brief Removes every participant, when leaving the conference.
+     */
+    void clear() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto& [id, e] : entries_) {
+        if (!e.removed) {
+          by_version_.erase(e.version);
+          e.removed = true;
+          e.info = dolbyio::comms::participant_info{};
+          tombstones_++;
+          stamp(e);
+        }
+      }
+
+      prune();
+    }
+
+    uint64_t version() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return version_;
+    }
+
+    /**
+     * @brief Calls delegate with the participants changed and removed after
+     * version since, oldest change first, or with all the participants when
+     * since is 0 or older than the tombstones kept.
+     *
+     * Nothing is translated when the roster did not change. The delegate is
+     * called on the calling thread, after the roster lock is released, with
+     * structs living in the event arena until it returns.
+     */
+    void changes_since(uint64_t since, delegate_type delegate) const {
+      event_scope scope;
+      participant* changed = nullptr;
+      char** removed = nullptr;
+      int changed_count = 0;
+      int removed_count = 0;
+      uint64_t version;
+      bool snapshot;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        version = version_;
+        snapshot = since == 0 || since < floor_ || since > version_;
+
+        if (since != version_ || snapshot) {
+          auto first = snapshot ? by_version_.begin() : by_version_.upper_bound(since);
+          size_t live = 0;
+          size_t dead = 0;
+          for (auto it = first; it != by_version_.end(); ++it) {
+            it->second->removed ? dead++ : live++;
+          }
+
+          changed = scope.allocate<participant>(live);
+          removed = scope.allocate<char*>(snapshot ? 0 : dead);
+          for (auto it = first; it != by_version_.end(); ++it) {
+            const entry& e = *it->second;
+            if (!e.removed) {
+              scope.no_alloc_to_c(&changed[changed_count++], e.info);
+            } else if (!snapshot) {
+              removed[removed_count++] = scope.strdup(*e.id);
+            }
+          }
+        }
+      }
+
+      delegate(version, snapshot ? 1 : 0, changed, changed_count, removed, removed_count);
+    }
+
+  private:
+    struct entry {
+      dolbyio::comms::participant_info info;
+      const std::string*               id = nullptr;
+      uint64_t                         version = 0;
+      bool                             removed = false;
+    };
+
+    // Called with the lock held
+    void stamp(entry& e) {
+      e.version = ++version_;
+      by_version_.emplace(e.version, &e);
+    }
+
+    // Drops the oldest tombstones past max_tombstones, called with the lock held
+    void prune() {
+      for (auto it = by_version_.begin(); tombstones_ > max_tombstones && it != by_version_.end();) {
+        if (!it->second->removed) {
+          ++it;
+          continue;
+        }
+
+        floor_ = it->first;
+        std::string id = *it->second->id;
+        it = by_version_.erase(it);
+        entries_.erase(id);
+        tombstones_--;
+      }
+    }
+
+    mutable std::mutex                         mutex_;
+    std::unordered_map<std::string, entry>     entries_;
+    std::map<uint64_t, entry*>                 by_version_;
+    uint64_t                                   version_ = 0;
+    uint64_t                                   floor_ = 0;
+    size_t                                     tombstones_ = 0;
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _PARTICIPANT_ROSTER_H_
@@ -0,0 +1,554 @@
+#ifndef _RGBA_TO_YUV_H_
+#define _RGBA_TO_YUV_H_
+
+#include <cstdint>
+
+#include "yuv_to_rgba.h"
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Fixed point coefficients of the conversion of a 32 bit pixel, for
+   * every byte of the pixel so that the byte order costs nothing to the kernels.
+   */
+  struct rgb_to_yuv_params {
+    int16_t y[4];
+    int16_t u[4];
+    int16_t v[4];
+    int32_t y_bias;  // Luma offset and rounding
+    int32_t uv_bias; // Chroma offset and rounding
+  };
+
+  static constexpr int rgb_to_yuv_precision = 14;
+
+  /**
+   * @brief Builds the coefficients of the ycbcr_type matrix, the inverse of the
+   * yuv2rb ones: Kr, Kb, the luma range and the chroma range.
+   */
+  static rgb_to_yuv_params rgb_to_yuv_make_params(ycbcr_type yuv_type, rgb32_order order) {
+    struct matrix { double rf, bf, ymin, ymax, range; };
+    static constexpr matrix matrices[6] = {
+      { 0.299, 0.114, 0.0, 255.0, 255.0 },    // ITU-T T.871 (JPEG)
+      { 0.299, 0.114, 16.0, 235.0, 224.0 },   // ITU-R BT.601-7
+      { 0.2126, 0.0722, 16.0, 235.0, 224.0 }, // ITU-R BT.709-6
+      { 0.2126, 0.0722, 0.0, 255.0, 255.0 },
+      { 0.2627, 0.0593, 16.0, 235.0, 224.0 }, // ITU-R BT.2020
+      { 0.2627, 0.0593, 0.0, 255.0, 255.0 },
+    };
+
+    const matrix& m = matrices[(int)yuv_type];
+    double gf = 1.0 - m.rf - m.bf;
+    double y_scale = (m.ymax - m.ymin) / 255.0;
+    double u_scale = m.range / 255.0 / (2.0 * (1.0 - m.bf));
+    double v_scale = m.range / 255.0 / (2.0 * (1.0 - m.rf));
+
+    auto fixed = [](double value) {
+      return (int16_t)(value * (1 << rgb_to_yuv_precision) + (value < 0 ? -0.5 : 0.5));
+    };
+
+    // Byte offsets of red, green and blue, alpha having no weight
+    int r = order == rgb32_order::bgra ? 2 : (order == rgb32_order::rgba ? 0 : 1);
+    int g = order == rgb32_order::argb ? 2 : 1;
+    int b = order == rgb32_order::bgra ? 0 : (order == rgb32_order::rgba ? 2 : 3);
+
+    rgb_to_yuv_params params = {};
+    params.y[r] = fixed(y_scale * m.rf);
+    params.y[g] = fixed(y_scale * gf);
+    params.y[b] = fixed(y_scale * m.bf);
+    params.u[r] = fixed(-u_scale * m.rf);
+    params.u[g] = fixed(-u_scale * gf);
+    params.u[b] = fixed(u_scale * (1.0 - m.bf));
+    params.v[r] = fixed(v_scale * (1.0 - m.rf));
+    params.v[g] = fixed(-v_scale * gf);
+    params.v[b] = fixed(-v_scale * m.bf);
+    params.y_bias = ((int32_t)m.ymin << rgb_to_yuv_precision) + (1 << (rgb_to_yuv_precision - 1));
+    params.uv_bias = (128 << rgb_to_yuv_precision) + (1 << (rgb_to_yuv_precision - 1));
+    return params;
+  }
+
+  static inline uint8_t rgb_to_yuv_dot(const int16_t* c, int32_t bias, const uint8_t* p) {
+    int value = (c[0] * p[0] + c[1] * p[1] + c[2] * p[2] + c[3] * p[3] + bias) >> rgb_to_yuv_precision;
+    return (uint8_t)(value < 0 ? 0 : (value > 255 ? 255 : value));
+  }
+
+  /**
+   * @brief Scalar reference converter, from 32 bit pixels to I420, NV12 or NV21.
+   *
+   * Chroma is computed from the average of every 2x2 block of pixels, the last
+   * column and row of odd sizes being averaged with themselves. For NV12 and
+   * NV21 u_addr points to the interleaved chroma plane and v_addr is ignored.
+   */
+  static void rgb32_yuv_std(
+    rgb32_order order, yuv_chroma_layout layout,
+    uint32_t width, uint32_t height,
+    const uint8_t* rgb, uint32_t rgb_stride,
+    uint8_t* y_addr, uint8_t* u_addr, uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+    ycbcr_type yuv_type)
+  {
+    const rgb_to_yuv_params p = rgb_to_yuv_make_params(yuv_type, order);
+
+    for (uint32_t y = 0; y < height; y++) {
+      const uint8_t* rgb_ptr = rgb + y * rgb_stride;
+      uint8_t* y_ptr = y_addr + y * y_stride;
+      for (uint32_t x = 0; x < width; x++) {
+        y_ptr[x] = rgb_to_yuv_dot(p.y, p.y_bias, rgb_ptr + 4 * x);
+      }
+    }
+
+    for (uint32_t y = 0; y < (height + 1) / 2; y++) {
+      const uint8_t* row1 = rgb + 2 * y * rgb_stride;
+      const uint8_t* row2 = 2 * y + 1 < height ? row1 + rgb_stride : row1;
+      uint8_t* u_ptr = u_addr + y * uv_stride;
+      uint8_t* v_ptr = layout == yuv_chroma_layout::i420 ? v_addr + y * uv_stride : nullptr;
+
+      for (uint32_t x = 0; x < (width + 1) / 2; x++) {
+        uint32_t x1 = 8 * x;
+        uint32_t x2 = 2 * x + 1 < width ? x1 + 4 : x1;
+
+        uint8_t average[4];
+        for (int i = 0; i < 4; i++) {
+          average[i] = (uint8_t)((row1[x1 + i] + row1[x2 + i] + row2[x1 + i] + row2[x2 + i] + 2) >> 2);
+        }
+
+        uint8_t u = rgb_to_yuv_dot(p.u, p.uv_bias, average);
+        uint8_t v = rgb_to_yuv_dot(p.v, p.uv_bias, average);
+        switch (layout) {
+          case yuv_chroma_layout::i420: u_ptr[x] = u; v_ptr[x] = v; break;
+          case yuv_chroma_layout::nv12: u_ptr[2 * x] = u; u_ptr[2 * x + 1] = v; break;
+          case yuv_chroma_layout::nv21: u_ptr[2 * x] = v; u_ptr[2 * x + 1] = u; break;
+        }
+      }
+    }
+  }
+
+  // Converts what the vector loop did not reach: the columns from done (even) and the last row of an odd height
+  static void rgb32_yuv_tail(
+    rgb32_order order, yuv_chroma_layout layout, uint32_t done,
+    uint32_t width, uint32_t height,
+    const uint8_t* rgb, uint32_t rgb_stride,
+    uint8_t* y_addr, uint8_t* u_addr, uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+    ycbcr_type yuv_type)
+  {
+    bool i420 = layout == yuv_chroma_layout::i420;
+
+    if (done < width) {
+      uint32_t chroma_offset = i420 ? done / 2 : done;
+      rgb32_yuv_std(order, layout, width - done, height, rgb + 4 * done, rgb_stride,
+        y_addr + done, u_addr + chroma_offset, i420 ? v_addr + chroma_offset : nullptr, y_stride, uv_stride, yuv_type);
+    }
+
+    if (height % 2 && done > 0) {
+      uint32_t row = height - 1;
+      uint32_t chroma_row = row / 2;
+      rgb32_yuv_std(order, layout, done, 1, rgb + row * rgb_stride, rgb_stride,
+        y_addr + row * y_stride, u_addr + chroma_row * uv_stride, i420 ? v_addr + chroma_row * uv_stride : nullptr,
+        y_stride, uv_stride, yuv_type);
+    }
+  }
+
+#if defined(YUV_TO_RGBA_X86)
+
+  // Coefficients of bytes 0 and 2 (even) and 1 and 3 (odd) of a pixel, paired for _mm_madd_epi16
+  static inline int32_t rgb_to_yuv_pair(int16_t lo, int16_t hi) {
+    return (int32_t)((uint32_t)(uint16_t)lo | ((uint32_t)(uint16_t)hi << 16));
+  }
+
+  struct rgb_sse2_params {
+    __m128i y_even, y_odd;
+    __m128i u_even, u_odd;
+    __m128i v_even, v_odd;
+    __m128i y_bias;
+    __m128i uv_bias;
+  };
+
+  static inline rgb_sse2_params rgb_sse2_make_params(const rgb_to_yuv_params& p) {
+    return rgb_sse2_params {
+      _mm_set1_epi32(rgb_to_yuv_pair(p.y[0], p.y[2])), _mm_set1_epi32(rgb_to_yuv_pair(p.y[1], p.y[3])),
+      _mm_set1_epi32(rgb_to_yuv_pair(p.u[0], p.u[2])), _mm_set1_epi32(rgb_to_yuv_pair(p.u[1], p.u[3])),
+      _mm_set1_epi32(rgb_to_yuv_pair(p.v[0], p.v[2])), _mm_set1_epi32(rgb_to_yuv_pair(p.v[1], p.v[3])),
+      _mm_set1_epi32(p.y_bias),
+      _mm_set1_epi32(p.uv_bias)
+    };
+  }
+
+  // Weighted sum of 4 pixels split into their even and odd bytes, as 32 bit lanes
+  static inline __m128i rgb_sse2_dot(__m128i even, __m128i odd, __m128i c_even, __m128i c_odd, __m128i bias) {
+    __m128i sum = _mm_add_epi32(_mm_madd_epi16(even, c_even), _mm_madd_epi16(odd, c_odd));
+    return _mm_srai_epi32(_mm_add_epi32(sum, bias), rgb_to_yuv_precision);
+  }
+
+  static inline __m128i rgb_sse2_even(__m128i pixels) {
+    return _mm_and_si128(pixels, _mm_set1_epi16(0xFF));
+  }
+
+  static inline __m128i rgb_sse2_odd(__m128i pixels) {
+    return _mm_srli_epi16(pixels, 8);
+  }
+
+  // Converts and stores the luma of 16 pixels
+  static inline void rgb_sse2_store_luma(const rgb_sse2_params& p, const uint8_t* rgb_ptr, uint8_t* y_ptr) {
+    __m128i y[4];
+    for (int i = 0; i < 4; i++) {
+      __m128i pixels = _mm_loadu_si128((const __m128i*)(rgb_ptr + 16 * i));
+      y[i] = rgb_sse2_dot(rgb_sse2_even(pixels), rgb_sse2_odd(pixels), p.y_even, p.y_odd, p.y_bias);
+    }
+
+    _mm_storeu_si128((__m128i*)y_ptr, _mm_packus_epi16(_mm_packs_epi32(y[0], y[1]), _mm_packs_epi32(y[2], y[3])));
+  }
+
+  // Averages the 2x2 blocks of 8 pixels of two rows, as even and odd bytes of 4 pixels
+  static inline void rgb_sse2_average(const uint8_t* row1, const uint8_t* row2, __m128i& even, __m128i& odd) {
+    __m128i a1 = _mm_loadu_si128((const __m128i*)row1);
+    __m128i b1 = _mm_loadu_si128((const __m128i*)(row1 + 16));
+    __m128i a2 = _mm_loadu_si128((const __m128i*)row2);
+    __m128i b2 = _mm_loadu_si128((const __m128i*)(row2 + 16));
+
+    // Vertical sums, then the left and right pixels of every block added together
+    __m128i a_even = _mm_add_epi16(rgb_sse2_even(a1), rgb_sse2_even(a2));
+    __m128i b_even = _mm_add_epi16(rgb_sse2_even(b1), rgb_sse2_even(b2));
+    __m128i a_odd = _mm_add_epi16(rgb_sse2_odd(a1), rgb_sse2_odd(a2));
+    __m128i b_odd = _mm_add_epi16(rgb_sse2_odd(b1), rgb_sse2_odd(b2));
+
+    even = _mm_add_epi16(
+      _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a_even), _mm_castsi128_ps(b_even), _MM_SHUFFLE(2, 0, 2, 0))),
+      _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a_even), _mm_castsi128_ps(b_even), _MM_SHUFFLE(3, 1, 3, 1))));
+    odd = _mm_add_epi16(
+      _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a_odd), _mm_castsi128_ps(b_odd), _MM_SHUFFLE(2, 0, 2, 0))),
+      _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a_odd), _mm_castsi128_ps(b_odd), _MM_SHUFFLE(3, 1, 3, 1))));
+
+    const __m128i two = _mm_set1_epi16(2);
+    even = _mm_srli_epi16(_mm_add_epi16(even, two), 2);
+    odd = _mm_srli_epi16(_mm_add_epi16(odd, two), 2);
+  }
+
+  template<yuv_chroma_layout Layout>
+  static void rgb32_yuv_sse2(
+    rgb32_order order,
+    uint32_t width, uint32_t height,
+    const uint8_t* rgb, uint32_t rgb_stride,
+    uint8_t* y_addr, uint8_t* u_addr, uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+    ycbcr_type yuv_type)
+  {
+    const rgb_sse2_params p = rgb_sse2_make_params(rgb_to_yuv_make_params(yuv_type, order));
+    const uint32_t done = width & ~15u;
+
+    for (uint32_t y = 0; y + 1 < height; y += 2) {
+      const uint8_t* rgb_ptr1 = rgb + y * rgb_stride;
+      const uint8_t* rgb_ptr2 = rgb_ptr1 + rgb_stride;
+      uint8_t* y_ptr1 = y_addr + y * y_stride;
+      uint8_t* y_ptr2 = y_ptr1 + y_stride;
+      uint8_t* u_ptr = u_addr + (y / 2) * uv_stride;
+      uint8_t* v_ptr = Layout == yuv_chroma_layout::i420 ? v_addr + (y / 2) * uv_stride : nullptr;
+
+      for (uint32_t x = 0; x < done; x += 16) {
+        rgb_sse2_store_luma(p, rgb_ptr1 + 4 * x, y_ptr1 + x);
+        rgb_sse2_store_luma(p, rgb_ptr2 + 4 * x, y_ptr2 + x);
+
+        __m128i even_lo, odd_lo, even_hi, odd_hi;
+        rgb_sse2_average(rgb_ptr1 + 4 * x, rgb_ptr2 + 4 * x, even_lo, odd_lo);
+        rgb_sse2_average(rgb_ptr1 + 4 * x + 32, rgb_ptr2 + 4 * x + 32, even_hi, odd_hi);
+
+        __m128i u = _mm_packs_epi32(
+          rgb_sse2_dot(even_lo, odd_lo, p.u_even, p.u_odd, p.uv_bias),
+          rgb_sse2_dot(even_hi, odd_hi, p.u_even, p.u_odd, p.uv_bias));
+        __m128i v = _mm_packs_epi32(
+          rgb_sse2_dot(even_lo, odd_lo, p.v_even, p.v_odd, p.uv_bias),
+          rgb_sse2_dot(even_hi, odd_hi, p.v_even, p.v_odd, p.uv_bias));
+        u = _mm_packus_epi16(u, u);
+        v = _mm_packus_epi16(v, v);
+
+        if (Layout == yuv_chroma_layout::i420) {
+          _mm_storel_epi64((__m128i*)(u_ptr + x / 2), u);
+          _mm_storel_epi64((__m128i*)(v_ptr + x / 2), v);
+        } else if (Layout == yuv_chroma_layout::nv12) {
+          _mm_storeu_si128((__m128i*)(u_ptr + x), _mm_unpacklo_epi8(u, v));
+        } else {
+          _mm_storeu_si128((__m128i*)(u_ptr + x), _mm_unpacklo_epi8(v, u));
+        }
+      }
+    }
+
+    rgb32_yuv_tail(order, Layout, height > 1 ? done : 0, width, height, rgb, rgb_stride, y_addr, u_addr, v_addr, y_stride, uv_stride, yuv_type);
+  }
+
+  struct rgb_avx2_params {
+    __m256i y_even, y_odd;
+    __m256i u_even, u_odd;
+    __m256i v_even, v_odd;
+    __m256i y_bias;
+    __m256i uv_bias;
+  };
+
+  YUV_TO_RGBA_AVX2_TARGET static inline rgb_avx2_params rgb_avx2_make_params(const rgb_to_yuv_params& p) {
+    return rgb_avx2_params {
+      _mm256_set1_epi32(rgb_to_yuv_pair(p.y[0], p.y[2])), _mm256_set1_epi32(rgb_to_yuv_pair(p.y[1], p.y[3])),
+      _mm256_set1_epi32(rgb_to_yuv_pair(p.u[0], p.u[2])), _mm256_set1_epi32(rgb_to_yuv_pair(p.u[1], p.u[3])),
+      _mm256_set1_epi32(rgb_to_yuv_pair(p.v[0], p.v[2])), _mm256_set1_epi32(rgb_to_yuv_pair(p.v[1], p.v[3])),
+      _mm256_set1_epi32(p.y_bias),
+      _mm256_set1_epi32(p.uv_bias)
+    };
+  }
+
+  YUV_TO_RGBA_AVX2_TARGET static inline __m256i rgb_avx2_dot(__m256i even, __m256i odd, __m256i c_even, __m256i c_odd, __m256i bias) {
+    __m256i sum = _mm256_add_epi32(_mm256_madd_epi16(even, c_even), _mm256_madd_epi16(odd, c_odd));
+    return _mm256_srai_epi32(_mm256_add_epi32(sum, bias), rgb_to_yuv_precision);
+  }
+
+  YUV_TO_RGBA_AVX2_TARGET static inline __m256i rgb_avx2_even(__m256i pixels) {
+    return _mm256_and_si256(pixels, _mm256_set1_epi16(0xFF));
+  }
+
+  YUV_TO_RGBA_AVX2_TARGET static inline __m256i rgb_avx2_odd(__m256i pixels) {
+    return _mm256_srli_epi16(pixels, 8);
+  }
+
+  // Packs two vectors of 32 bit lanes (values 0-7 and 8-15) into 16 bit lanes in order
+  YUV_TO_RGBA_AVX2_TARGET static inline __m256i rgb_avx2_pack32(__m256i a, __m256i b) {
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+  }
+
+  // Converts and stores the luma of 32 pixels
+  YUV_TO_RGBA_AVX2_TARGET static inline void rgb_avx2_store_luma(const rgb_avx2_params& p, const uint8_t* rgb_ptr, uint8_t* y_ptr) {
+    __m256i y[4];
+    for (int i = 0; i < 4; i++) {
+      __m256i pixels = _mm256_loadu_si256((const __m256i*)(rgb_ptr + 32 * i));
+      y[i] = rgb_avx2_dot(rgb_avx2_even(pixels), rgb_avx2_odd(pixels), p.y_even, p.y_odd, p.y_bias);
+    }
+
+    __m256i luma = _mm256_packus_epi16(rgb_avx2_pack32(y[0], y[1]), rgb_avx2_pack32(y[2], y[3]));
+    _mm256_storeu_si256((__m256i*)y_ptr, _mm256_permute4x64_epi64(luma, 0xD8));
+  }
+
+  // Averages the 2x2 blocks of 16 pixels of two rows, as even and odd bytes of 8 pixels in order
+  YUV_TO_RGBA_AVX2_TARGET static inline void rgb_avx2_average(const uint8_t* row1, const uint8_t* row2, __m256i& even, __m256i& odd) {
+    __m256i a1 = _mm256_loadu_si256((const __m256i*)row1);
+    __m256i b1 = _mm256_loadu_si256((const __m256i*)(row1 + 32));
+    __m256i a2 = _mm256_loadu_si256((const __m256i*)row2);
+    __m256i b2 = _mm256_loadu_si256((const __m256i*)(row2 + 32));
+
+    __m256i a_even = _mm256_add_epi16(rgb_avx2_even(a1), rgb_avx2_even(a2));
+    __m256i b_even = _mm256_add_epi16(rgb_avx2_even(b1), rgb_avx2_even(b2));
+    __m256i a_odd = _mm256_add_epi16(rgb_avx2_odd(a1), rgb_avx2_odd(a2));
+    __m256i b_odd = _mm256_add_epi16(rgb_avx2_odd(b1), rgb_avx2_odd(b2));
+
+    // The shuffles work within 128 bit lanes, yielding blocks 0 1 4 5 2 3 6 7
+    const __m256i order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+    even = _mm256_permutevar8x32_epi32(_mm256_add_epi16(
+      _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(a_even), _mm256_castsi256_ps(b_even), _MM_SHUFFLE(2, 0, 2, 0))),
+      _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(a_even), _mm256_castsi256_ps(b_even), _MM_SHUFFLE(3, 1, 3, 1)))), order);
+    odd = _mm256_permutevar8x32_epi32(_mm256_add_epi16(
+      _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(a_odd), _mm256_castsi256_ps(b_odd), _MM_SHUFFLE(2, 0, 2, 0))),
+      _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(a_odd), _mm256_castsi256_ps(b_odd), _MM_SHUFFLE(3, 1, 3, 1)))), order);
+
+    const __m256i two = _mm256_set1_epi16(2);
+    even = _mm256_srli_epi16(_mm256_add_epi16(even, two), 2);
+    odd = _mm256_srli_epi16(_mm256_add_epi16(odd, two), 2);
+  }
+
+  // Converts 16 chroma samples to bytes, in the low 128 bits
+  YUV_TO_RGBA_AVX2_TARGET static inline __m128i rgb_avx2_chroma(__m256i lo, __m256i hi) {
+    __m256i packed = rgb_avx2_pack32(lo, hi);
+    return _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi16(packed, packed), 0x08));
+  }
+
+  template<yuv_chroma_layout Layout>
+  YUV_TO_RGBA_AVX2_TARGET static void rgb32_yuv_avx2(
+    rgb32_order order,
+    uint32_t width, uint32_t height,
+    const uint8_t* rgb, uint32_t rgb_stride,
+    uint8_t* y_addr, uint8_t* u_addr, uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+    ycbcr_type yuv_type)
+  {
+    const rgb_avx2_params p = rgb_avx2_make_params(rgb_to_yuv_make_params(yuv_type, order));
+    const uint32_t done = width & ~31u;
+
+    for (uint32_t y = 0; y + 1 < height; y += 2) {
+      const uint8_t* rgb_ptr1 = rgb + y * rgb_stride;
+      const uint8_t* rgb_ptr2 = rgb_ptr1 + rgb_stride;
+      uint8_t* y_ptr1 = y_addr + y * y_stride;
+      uint8_t* y_ptr2 = y_ptr1 + y_stride;
+      uint8_t* u_ptr = u_addr + (y / 2) * uv_stride;
+      uint8_t* v_ptr = Layout == yuv_chroma_layout::i420 ? v_addr + (y / 2) * uv_stride : nullptr;
+
+      for (uint32_t x = 0; x < done; x += 32) {
+        rgb_avx2_store_luma(p, rgb_ptr1 + 4 * x, y_ptr1 + x);
+        rgb_avx2_store_luma(p, rgb_ptr2 + 4 * x, y_ptr2 + x);
+
+        __m256i even_lo, odd_lo, even_hi, odd_hi;
+        rgb_avx2_average(rgb_ptr1 + 4 * x, rgb_ptr2 + 4 * x, even_lo, odd_lo);
+        rgb_avx2_average(rgb_ptr1 + 4 * x + 64, rgb_ptr2 + 4 * x + 64, even_hi, odd_hi);
+
+        __m128i u = rgb_avx2_chroma(
+          rgb_avx2_dot(even_lo, odd_lo, p.u_even, p.u_odd, p.uv_bias),
+          rgb_avx2_dot(even_hi, odd_hi, p.u_even, p.u_odd, p.uv_bias));
+        __m128i v = rgb_avx2_chroma(
+          rgb_avx2_dot(even_lo, odd_lo, p.v_even, p.v_odd, p.uv_bias),
+          rgb_avx2_dot(even_hi, odd_hi, p.v_even, p.v_odd, p.uv_bias));
+
+        if (Layout == yuv_chroma_layout::i420) {
+          _mm_storeu_si128((__m128i*)(u_ptr + x / 2), u);
+          _mm_storeu_si128((__m128i*)(v_ptr + x / 2), v);
+        } else {
+          __m128i first = Layout == yuv_chroma_layout::nv12 ? u : v;
+          __m128i second = Layout == yuv_chroma_layout::nv12 ? v : u;
+          _mm_storeu_si128((__m128i*)(u_ptr + x), _mm_unpacklo_epi8(first, second));
+          _mm_storeu_si128((__m128i*)(u_ptr + x + 16), _mm_unpackhi_epi8(first, second));
+        }
+      }
+    }
+
+    rgb32_yuv_tail(order, Layout, height > 1 ? done : 0, width, height, rgb, rgb_stride, y_addr, u_addr, v_addr, y_stride, uv_stride, yuv_type);
+  }
+
+#endif // YUV_TO_RGBA_X86
+
+#if defined(YUV_TO_RGBA_NEON)
+
+  // Weighted sum of the 4 bytes of 8 pixels, saturated to 16 bits
+  static inline int16x8_t rgb_neon_dot(const int16x8_t* bytes, const int16_t* c, int32_t bias) {
+    int32x4_t lo = vdupq_n_s32(bias);
+    int32x4_t hi = vdupq_n_s32(bias);
+    for (int i = 0; i < 4; i++) {
+      lo = vmlal_n_s16(lo, vget_low_s16(bytes[i]), c[i]);
+      hi = vmlal_n_s16(hi, vget_high_s16(bytes[i]), c[i]);
+    }
+
+    return vcombine_s16(vqmovn_s32(vshrq_n_s32(lo, rgb_to_yuv_precision)), vqmovn_s32(vshrq_n_s32(hi, rgb_to_yuv_precision)));
+  }
+
+  // Converts and stores the luma of 16 pixels, deinterleaved by vld4q_u8
+  static inline void rgb_neon_store_luma(const rgb_to_yuv_params& p, const uint8x16x4_t& pixels, uint8_t* y_ptr) {
+    int16x8_t lo[4], hi[4];
+    for (int i = 0; i < 4; i++) {
+      lo[i] = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(pixels.val[i])));
+      hi[i] = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(pixels.val[i])));
+    }
+
+    vst1q_u8(y_ptr, vcombine_u8(vqmovun_s16(rgb_neon_dot(lo, p.y, p.y_bias)), vqmovun_s16(rgb_neon_dot(hi, p.y, p.y_bias))));
+  }
+
+  template<yuv_chroma_layout Layout>
+  static void rgb32_yuv_neon(
+    rgb32_order order,
+    uint32_t width, uint32_t height,
+    const uint8_t* rgb, uint32_t rgb_stride,
+    uint8_t* y_addr, uint8_t* u_addr, uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+    ycbcr_type yuv_type)
+  {
+    const rgb_to_yuv_params p = rgb_to_yuv_make_params(yuv_type, order);
+    const uint32_t done = width & ~15u;
+
+    for (uint32_t y = 0; y + 1 < height; y += 2) {
+      const uint8_t* rgb_ptr1 = rgb + y * rgb_stride;
+      const uint8_t* rgb_ptr2 = rgb_ptr1 + rgb_stride;
+      uint8_t* y_ptr1 = y_addr + y * y_stride;
+      uint8_t* y_ptr2 = y_ptr1 + y_stride;
+      uint8_t* u_ptr = u_addr + (y / 2) * uv_stride;
+      uint8_t* v_ptr = Layout == yuv_chroma_layout::i420 ? v_addr + (y / 2) * uv_stride : nullptr;
+
+      for (uint32_t x = 0; x < done; x += 16) {
+        uint8x16x4_t pixels1 = vld4q_u8(rgb_ptr1 + 4 * x);
+        uint8x16x4_t pixels2 = vld4q_u8(rgb_ptr2 + 4 * x);
+
+        rgb_neon_store_luma(p, pixels1, y_ptr1 + x);
+        rgb_neon_store_luma(p, pixels2, y_ptr2 + x);
+
+        // Pairwise sums of both rows, rounded down to the average of every 2x2 block
+        int16x8_t average[4];
+        for (int i = 0; i < 4; i++) {
+          uint16x8_t sum = vpadalq_u8(vpaddlq_u8(pixels1.val[i]), pixels2.val[i]);
+          average[i] = vreinterpretq_s16_u16(vrshrq_n_u16(sum, 2));
+        }
+
+        uint8x8_t u = vqmovun_s16(rgb_neon_dot(average, p.u, p.uv_bias));
+        uint8x8_t v = vqmovun_s16(rgb_neon_dot(average, p.v, p.uv_bias));
+
+        if (Layout == yuv_chroma_layout::i420) {
+          vst1_u8(u_ptr + x / 2, u);
+          vst1_u8(v_ptr + x / 2, v);
+        } else {
+          uint8x8x2_t uv;
+          uv.val[0] = Layout == yuv_chroma_layout::nv12 ? u : v;
+          uv.val[1] = Layout == yuv_chroma_layout::nv12 ? v : u;
+          vst2_u8(u_ptr + x, uv);
+        }
+      }
+    }
+
+    rgb32_yuv_tail(order, Layout, height > 1 ? done : 0, width, height, rgb, rgb_stride, y_addr, u_addr, v_addr, y_stride, uv_stride, yuv_type);
+  }
+
+#endif // YUV_TO_RGBA_NEON
+
+  /**
+   * @brief Converts 32 bit pixels to I420, NV12 or NV21 with an explicit kernel.
+   *
+   * Every kernel produces exactly the output of rgb32_yuv_std. For NV12 and
+   * NV21 u_addr points to the interleaved chroma plane and v_addr is ignored.
+   */
+  static void rgb32_yuv(
+    yuv_simd simd, rgb32_order order, yuv_chroma_layout layout,
+    uint32_t width, uint32_t height,
+    const uint8_t* rgb, uint32_t rgb_stride,
+    uint8_t* y_addr, uint8_t* u_addr, uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+    ycbcr_type yuv_type)
+  {
+    if (width == 0 || height == 0) {
+      return;
+    }
+
+    using kernel_type = void (*)(rgb32_order, uint32_t, uint32_t, const uint8_t*, uint32_t, uint8_t*, uint8_t*, uint8_t*, uint32_t, uint32_t, ycbcr_type);
+    kernel_type kernel = nullptr;
+
+    switch (simd) {
+#if defined(YUV_TO_RGBA_X86)
+      case yuv_simd::sse2:
+        kernel = layout == yuv_chroma_layout::i420 ? rgb32_yuv_sse2<yuv_chroma_layout::i420>
+          : layout == yuv_chroma_layout::nv12 ? rgb32_yuv_sse2<yuv_chroma_layout::nv12>
+          : rgb32_yuv_sse2<yuv_chroma_layout::nv21>;
+        break;
+      case yuv_simd::avx2:
+        kernel = layout == yuv_chroma_layout::i420 ? rgb32_yuv_avx2<yuv_chroma_layout::i420>
+          : layout == yuv_chroma_layout::nv12 ? rgb32_yuv_avx2<yuv_chroma_layout::nv12>
+          : rgb32_yuv_avx2<yuv_chroma_layout::nv21>;
+        break;
+#endif
+#if defined(YUV_TO_RGBA_NEON)
+      case yuv_simd::neon:
+        kernel = layout == yuv_chroma_layout::i420 ? rgb32_yuv_neon<yuv_chroma_layout::i420>
+          : layout == yuv_chroma_layout::nv12 ? rgb32_yuv_neon<yuv_chroma_layout::nv12>
+          : rgb32_yuv_neon<yuv_chroma_layout::nv21>;
+        break;
+#endif
+      default:
+        break;
+    }
+
+    if (kernel && yuv_simd_supported(simd)) {
+      kernel(order, width, height, rgb, rgb_stride, y_addr, u_addr, v_addr, y_stride, uv_stride, yuv_type);
+    } else {
+      rgb32_yuv_std(order, layout, width, height, rgb, rgb_stride, y_addr, u_addr, v_addr, y_stride, uv_stride, yuv_type);
+    }
+  }
+
+  static void rgb32_i420(
+    rgb32_order order, uint32_t width, uint32_t height,
+    const uint8_t* rgb, uint32_t rgb_stride,
+    uint8_t* y_addr, uint8_t* u_addr, uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+    ycbcr_type yuv_type)
+  {
+    rgb32_yuv(yuv_simd_detect(), order, yuv_chroma_layout::i420, width, height, rgb, rgb_stride, y_addr, u_addr, v_addr, y_stride, uv_stride, yuv_type);
+  }
+
+  static void rgb32_nv12(
+    rgb32_order order, uint32_t width, uint32_t height,
+    const uint8_t* rgb, uint32_t rgb_stride,
+    uint8_t* y_addr, uint8_t* uv_addr, uint32_t y_stride, uint32_t uv_stride,
+    ycbcr_type yuv_type)
+  {
+    rgb32_yuv(yuv_simd_detect(), order, yuv_chroma_layout::nv12, width, height, rgb, rgb_stride, y_addr, uv_addr, nullptr, y_stride, uv_stride, yuv_type);
+  }
+
+} // namespace dolbyio::comms::native
+
+#endif // _RGBA_TO_YUV_H_
@@ -1,21 +1,20 @@
 #include <iostream>
 
 #include "sdk.h"
+#include "conference.h"
 #include "handlers.h"
 
 namespace dolbyio::comms::native {
 
-std::map<std::string, std::map<std::int32_t, dolbyio::comms::event_handler_id>> handlers_map;
-
 dolbyio::comms::sdk* sdk = nullptr;
-std::string error = "";
 
 extern "C" {
 
   EXPORT_API void AddOnSignalingChannelExceptionHandler(std::int32_t hash, on_signaling_channel_exception::type handler) {
     handle<on_signaling_channel_exception>(*sdk, hash, handler,
       [handler](const on_signaling_channel_exception::event& e) {
-        handler(strdup(e.what()));
+        event_scope scope;
+        handler(scope.strdup(e.what()));
       }
     );
   }
@@ -29,7 +28,8 @@ extern "C" {
   EXPORT_API void AddOnInvalidTokenExceptionHandler(std::int32_t hash, on_invalid_token_exception::type handler) {
     handle<on_invalid_token_exception>(*sdk, hash, handler,
       [handler](const on_invalid_token_exception::event& e) {
-        handler(strdup(e.reason()), strdup(e.description()));
+        event_scope scope;
+        handler(scope.strdup(e.reason()), scope.strdup(e.description()));
       }
     );
   }
@@ -69,15 +69,16 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int RegisterComponentVersionAsync(const char* name, const char* version, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->register_component_version(std::string(name), std::string(version)));
+    }}.result();
+  }
+
   EXPORT_API int Release() {
     return call { [&]() {
-      for (const auto& [key, value] : handlers_map) {
-        for (const auto& [key2, value2] : value) {
-          wait(value2->disconnect());
-        }
-      }
-
-      handlers_map.clear();
+      handler_registry_base::disconnect_all();
+      release_conference();
 
       // Releasing sdk
       if (sdk) {
@@ -88,7 +89,28 @@ extern "C" {
   }
 
   EXPORT_API char* GetLastErrorMsg() {
-    return strdup(error);
+    return strdup(last_error::current().message);
+  }
+
+  EXPORT_API int GetLastErrorCode() {
+    return to_underlying(last_error::current().code);
+  }
+
+  /**
+   * @brief Copies the last error message of the calling thread into buffer,
+   * truncated to size - 1 characters and null-terminated.
+   *
+   * @return The length of the whole message.
+   */
+  EXPORT_API int GetLastErrorMessage(char* buffer, int size) {
+    const last_error& error = last_error::current();
+    if (buffer && size > 0) {
+      size_t copied = std::min(error.length, (size_t)size - 1);
+      std::memcpy(buffer, error.message, copied);
+      buffer[copied] = '\0';
+    }
+
+    return (int)error.length;
   }
 
 } // extern "C"
@@ -11,9 +11,11 @@
 
 #include <dolbyio/comms/sdk.h>
 #include <map>
+#include "event_arena.h"
 #include "utils.h"
 #include "handlers.h"
 #include "translators.h"
+#include "async_call.h"
 
 namespace dolbyio::comms::native {
 
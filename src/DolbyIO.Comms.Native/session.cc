@@ -12,11 +12,24 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int OpenAsync(dolbyio::comms::native::user_info* u, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      auto user = to_cpp<dolbyio::comms::services::session::user_info>(u);
+      c.attach(sdk->session().open(std::move(user)), as_struct<dolbyio::comms::native::user_info>{});
+    }}.result();
+  }
+
   EXPORT_API int Close() {
     return call { [&]() {
       wait(sdk->session().close());
     }}.result();
   }
 
+  EXPORT_API int CloseAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->session().close());
+    }}.result();
+  }
+
 } // extern "C"
 } // namespace dolbyio::comms::native
\ No newline at end of file
@@ -0,0 +1,408 @@
+#ifndef _SHM_FRAME_RING_H_
+#define _SHM_FRAME_RING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Ring of video frames in a named shared memory segment, written by
+   * one video_sink and mapped by any number of local reader processes.
+   *
+   * The segment starts with a shm_ring_header followed by slot_count slots of
+   * slot_stride bytes, each made of a shm_slot_header and of the frame planes.
+   * Every slot is guarded by a sequence lock: the writer makes the sequence odd
+   * while the slot is being written and sets it to 2 * (frame_number + 1) once
+   * the frame is complete. Readers access the planes in place and check that
+   * the sequence did not change once they are done with them.
+   *
+   * Readers mapping the segment without this header must follow the layout of
+   * shm_ring_header and shm_slot_header, which is fixed for a given version.
+   *
+   * The layout is read once, when the segment is mapped, and every frame is
+   * checked against it before being handed out, so that a writer corrupting
+   * the segment cannot make a reader access memory outside of it.
+   */
+  class shm_frame_ring {
+  public:
+    static constexpr uint32_t magic = 0x564F4944; // "DIOV"
+    static constexpr uint32_t version = 1;
+
+    struct shm_ring_header {
+      uint32_t              magic;
+      uint32_t              version;
+      uint32_t              slot_count;
+      uint32_t              slot_size;   // Bytes available for the planes of a slot
+      uint32_t              slot_stride; // Bytes between two slots
+      uint32_t              reserved;
+      std::atomic<uint64_t> write_count; // Frames published so far
+      uint8_t               padding[32];
+    };
+
+    /**
+     * @brief C# VideoFrameRingInfo C struct.
+     */
+    struct shm_frame_info {
+      uint64_t frame_number;
+      int64_t  timestamp_us;
+      int32_t  width;
+      int32_t  height;
+      int32_t  format;
+      int32_t  plane_count;
+      int32_t  strides[3];
+      uint32_t offsets[3]; // From the start of the slot payload
+      uint32_t size;
+    };
+
+    struct shm_slot_header {
+      std::atomic<uint64_t> sequence;
+      shm_frame_info        info;
+      uint8_t               padding[56];
+    };
+
+    static_assert(sizeof(shm_ring_header) == 64, "The ring header layout is shared with other processes");
+    static_assert(sizeof(shm_slot_header) == 128, "The slot header layout is shared with other processes");
+
+    /**
+     * @brief Creates the segment, replacing any stale segment of the same name.
+     *
+     * On Windows a segment lives as long as a process maps it, so the segment
+     * of a previous ring still mapped by a reader is reused when it has the
+     * same layout, its frame numbers continuing where they stopped.
+     *
+     * @throws std::runtime_error if the segment cannot be created, or on
+     * Windows if a segment of another layout is still mapped under the name.
+     */
+    static std::unique_ptr<shm_frame_ring> create(const std::string& name, uint32_t slot_count, uint32_t slot_size) {
+      if (slot_count == 0 || slot_size == 0) {
+        throw std::runtime_error("The shared memory ring needs at least one slot of one byte");
+      }
+
+      uint32_t slot_stride = (uint32_t)((sizeof(shm_slot_header) + slot_size + 63) & ~size_t(63));
+      size_t size = sizeof(shm_ring_header) + (size_t)slot_count * slot_stride;
+
+      std::unique_ptr<shm_frame_ring> ring(new shm_frame_ring(name, true));
+      ring->map(size);
+
+      auto header = ring->header();
+      if (ring->existing_) {
+        if (header->magic != magic || header->version != version || header->slot_count != slot_count ||
+            header->slot_size != slot_size || header->slot_stride != slot_stride) {
+          throw std::runtime_error("The shared memory " + name + " is in use with another layout");
+        }
+
+        ring->layout(slot_count, slot_size, slot_stride);
+        return ring;
+      }
+
+      ring->layout(slot_count, slot_size, slot_stride);
+      header->magic = magic;
+      header->version = version;
+      header->slot_count = slot_count;
+      header->slot_size = slot_size;
+      header->slot_stride = slot_stride;
+      header->write_count.store(0, std::memory_order_release);
+
+      return ring;
+    }
+
+    /**
+     * @brief Maps an existing segment, reader side.
+     *
+     * @throws std::runtime_error if the segment does not exist or is not a frame ring.
+     */
+    static std::unique_ptr<shm_frame_ring> open(const std::string& name) {
+      std::unique_ptr<shm_frame_ring> ring(new shm_frame_ring(name, false));
+      ring->map(0);
+
+      if (ring->size_ < sizeof(shm_ring_header)) {
+        throw std::runtime_error("Not a video frame ring: " + name);
+      }
+
+      auto header = ring->header();
+      uint32_t slot_count = header->slot_count;
+      uint32_t slot_size = header->slot_size;
+      uint32_t slot_stride = header->slot_stride;
+      if (header->magic != magic || header->version != version || slot_count == 0 ||
+          slot_stride < sizeof(shm_slot_header) + (size_t)slot_size ||
+          ring->size_ < sizeof(shm_ring_header) + (size_t)slot_count * slot_stride) {
+        throw std::runtime_error("Not a video frame ring: " + name);
+      }
+
+      ring->layout(slot_count, slot_size, slot_stride);
+      return ring;
+    }
+
+    ~shm_frame_ring() {
+#if defined(_WIN32)
+      if (memory_) UnmapViewOfFile(memory_);
+      if (mapping_) CloseHandle(mapping_);
+#else
+      if (memory_) munmap(memory_, size_);
+      if (owner_ && owns_name()) shm_unlink(path().c_str());
+#endif
+    }
+
+    uint32_t slot_size() const {
+      return slot_size_;
+    }
+
+    /**
+     * @brief Starts writing the next frame, writer side.
+     *
+     * @return The payload of the slot or nullptr if the frame does not fit in a slot.
+     */
+    uint8_t* begin_write(size_t size) {
+      auto header = this->header();
+      if (size > slot_size_) {
+        return nullptr;
+      }
+
+      uint64_t frame_number = header->write_count.load(std::memory_order_relaxed);
+      auto slot = this->slot(frame_number);
+      slot->sequence.store(2 * frame_number + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      return payload(slot);
+    }
+
+    /**
+     * @brief Publishes the frame started by begin_write(), writer side.
+     */
+    void end_write(int width, int height, int format, int plane_count, uint8_t* const planes[3], const int strides[3], size_t size, int64_t timestamp_us) {
+      auto header = this->header();
+      uint64_t frame_number = header->write_count.load(std::memory_order_relaxed);
+      auto slot = this->slot(frame_number);
+
+      auto& info = slot->info;
+      info.frame_number = frame_number;
+      info.timestamp_us = timestamp_us;
+      info.width = width;
+      info.height = height;
+      info.format = format;
+      info.plane_count = plane_count;
+      info.size = (uint32_t)size;
+      for (int i = 0; i < 3; i++) {
+        info.strides[i] = i < plane_count ? strides[i] : 0;
+        info.offsets[i] = i < plane_count ? (uint32_t)(planes[i] - payload(slot)) : 0;
+      }
+
+      slot->sequence.store(2 * (frame_number + 1), std::memory_order_release);
+      header->write_count.store(frame_number + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Locates the newest complete frame, reader side.
+     *
+     * @param after_frame_number Only frames with a greater number are returned, -1 for any.
+     * @param info Receives a copy of the frame description.
+     * @return The payload of the slot holding the frame, valid as long as
+     * validate() returns true for info, or nullptr if no newer frame is available.
+     */
+    const uint8_t* read_latest(int64_t after_frame_number, shm_frame_info& info) const {
+      auto header = this->header();
+      for (int attempt = 0; attempt < 4; attempt++) {
+        uint64_t count = header->write_count.load(std::memory_order_acquire);
+        if (count == 0 || (int64_t)(count - 1) <= after_frame_number) {
+          return nullptr;
+        }
+
+        auto slot = this->slot(count - 1);
+        if (slot->sequence.load(std::memory_order_acquire) != 2 * count) {
+          continue;
+        }
+
+        info = slot->info;
+        if (info.frame_number == count - 1 && in_bounds(info) && validate(info)) {
+          return payload(slot);
+        }
+      }
+
+      return nullptr;
+    }
+
+    /**
+     * @brief Checks that the frame described by info, as returned by
+     * read_latest(), has not been overwritten since.
+     */
+    bool validate(const shm_frame_info& info) const {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return slot(info.frame_number)->sequence.load(std::memory_order_relaxed) == 2 * (info.frame_number + 1);
+    }
+
+  private:
+    shm_frame_ring(const std::string& name, bool owner) : name_(name), owner_(owner) {
+      if (name.empty() || name.find_first_of("/\\") != std::string::npos) {
+        throw std::runtime_error("Invalid shared memory name: " + name);
+      }
+    }
+
+    std::string path() const {
+#if defined(_WIN32)
+      return "Local\\" + name_;
+#else
+      return "/" + name_;
+#endif
+    }
+
+    // Creates the segment with the given size when owning it, maps it whole otherwise
+    void map(size_t size) {
+#if defined(_WIN32)
+      if (owner_) {
+        mapping_ = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+          (DWORD)((uint64_t)size >> 32), (DWORD)size, path().c_str());
+      } else {
+        mapping_ = OpenFileMappingA(FILE_MAP_READ, FALSE, path().c_str());
+      }
+
+      // Checked at once, before another call resets the last error
+      existing_ = owner_ && GetLastError() == ERROR_ALREADY_EXISTS;
+
+      if (mapping_ == nullptr) {
+        throw std::runtime_error("Cannot open the shared memory " + name_);
+      }
+
+      // An existing segment keeps its size, which may be smaller than requested
+      memory_ = MapViewOfFile(mapping_, owner_ ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, existing_ ? 0 : size);
+      if (memory_ == nullptr) {
+        throw std::runtime_error("Cannot map the shared memory " + name_);
+      }
+
+      MEMORY_BASIC_INFORMATION info;
+      VirtualQuery(memory_, &info, sizeof(info));
+      size_ = owner_ && !existing_ ? size : info.RegionSize;
+      if (size_ < size) {
+        throw std::runtime_error("The shared memory " + name_ + " is in use with another size");
+      }
+#else
+      int fd;
+      if (owner_) {
+        shm_unlink(path().c_str());
+        fd = shm_open(path().c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        struct stat st;
+        if (fd >= 0 && (ftruncate(fd, size) != 0 || fstat(fd, &st) != 0)) {
+          close(fd);
+          shm_unlink(path().c_str());
+          fd = -1;
+        } else if (fd >= 0) {
+          device_ = st.st_dev;
+          inode_ = st.st_ino;
+        }
+      } else {
+        fd = shm_open(path().c_str(), O_RDONLY, 0);
+        struct stat st;
+        if (fd >= 0 && fstat(fd, &st) == 0) {
+          size = st.st_size;
+        }
+      }
+
+      if (fd < 0) {
+        throw std::runtime_error("Cannot open the shared memory " + name_);
+      }
+
+      void* memory = size > 0 ? mmap(nullptr, size, owner_ ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+      close(fd);
+
+      if (memory == MAP_FAILED) {
+        if (owner_) shm_unlink(path().c_str());
+        owner_ = false;
+        throw std::runtime_error("Cannot map the shared memory " + name_);
+      }
+
+      memory_ = memory;
+      size_ = size;
+#endif
+    }
+
+#if !defined(_WIN32)
+    // Whether the name still designates this segment, and not a segment created
+    // since under the same name, such as when a sink re-enables the same ring
+    bool owns_name() const {
+      int fd = shm_open(path().c_str(), O_RDONLY, 0);
+      if (fd < 0) {
+        return false;
+      }
+
+      struct stat st;
+      bool same = fstat(fd, &st) == 0 && st.st_dev == device_ && st.st_ino == inode_;
+      close(fd);
+      return same;
+    }
+#endif
+
+    shm_ring_header* header() const {
+      return reinterpret_cast<shm_ring_header*>(memory_);
+    }
+
+    // Called once the layout was checked against the size of the mapping
+    void layout(uint32_t slot_count, uint32_t slot_size, uint32_t slot_stride) {
+      slot_count_ = slot_count;
+      slot_size_ = slot_size;
+      slot_stride_ = slot_stride;
+    }
+
+    // Whether the planes described by info lie within the payload of their
+    // slot, the first plane having height rows and the chroma planes half
+    bool in_bounds(const shm_frame_info& info) const {
+      if (info.size > slot_size_ || info.plane_count < 0 || info.plane_count > 3 || info.height < 0) {
+        return false;
+      }
+
+      for (int i = 0; i < info.plane_count; i++) {
+        uint64_t rows = i == 0 ? (uint64_t)info.height : ((uint64_t)info.height + 1) / 2;
+        if (info.strides[i] < 0 || info.offsets[i] + (uint64_t)info.strides[i] * rows > info.size) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    shm_slot_header* slot(uint64_t frame_number) const {
+      return reinterpret_cast<shm_slot_header*>((uint8_t*)memory_ + sizeof(shm_ring_header) +
+        (size_t)(frame_number % slot_count_) * slot_stride_);
+    }
+
+    static uint8_t* payload(shm_slot_header* slot) {
+      return reinterpret_cast<uint8_t*>(slot) + sizeof(shm_slot_header);
+    }
+
+    std::string name_;
+    bool        owner_;
+    bool        existing_ = false; // Whether create() found the segment already there
+    void*       memory_ = nullptr;
+    size_t      size_ = 0;
+    uint32_t    slot_count_ = 0;
+    uint32_t    slot_size_ = 0;
+    uint32_t    slot_stride_ = 0;
+#if defined(_WIN32)
+    HANDLE      mapping_ = nullptr;
+#else
+    dev_t       device_ = 0;
+    ino_t       inode_ = 0;
+#endif
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _SHM_FRAME_RING_H_
@@ -0,0 +1,322 @@
+#ifndef _SPATIAL_FILTER_H_
+#define _SPATIAL_FILTER_H_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief C# SpatialFilterStatistics C struct.
+   */
+  struct spatial_filter_statistics {
+    uint64_t submitted; // Positions, directions and environments passed to the filter
+    uint64_t forwarded; // Sent to the SDK
+    uint64_t elided;    // Dropped as redundant, below the thresholds or superseded
+    uint64_t deferred;  // Calls held back by the maximum update rate
+  };
+
+  /**
+   * @brief Spatial audio state last sent to the SDK, used to drop the updates
+   * that would not change it.
+   *
+   * A position or direction is only sent when it moved by more than the
+   * threshold of an axis away from the value last sent, so that slow drifts
+   * still get through once they add up. Changes arriving sooner than the
+   * maximum update rate allows are kept, the latest one per participant, and
+   * sent along with the next call past the interval, or by flush() once the
+   * interval passed when no call comes.
+   */
+  class spatial_filter {
+  public:
+    using clock = std::chrono::steady_clock;
+    using vec3 = std::array<float, 3>;
+    using environment = std::array<float, 12>;
+
+    spatial_filter() = default;
+
+    /**
+     * @brief Calls on_deferred on a flush thread of its own once the changes
+     * held back by the maximum update rate can be sent, for it to send them
+     * through flush(). The thread starts with the first change held back.
+     */
+    explicit spatial_filter(std::function<void()> on_deferred) : on_deferred_(std::move(on_deferred)) {}
+
+    ~spatial_filter() {
+      stop();
+    }
+
+    /**
+     * @brief Stops the flush thread, returning once on_deferred is no longer
+     * running. The thread starts again with the next change held back.
+     */
+    void stop() {
+      std::thread thread;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        deferred_ = false;
+        thread = std::move(thread_);
+      }
+      wakeup_.notify_one();
+
+      if (thread.joinable()) {
+        if (thread.get_id() == std::this_thread::get_id()) {
+          thread.detach();
+        } else {
+          thread.join();
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = false;
+    }
+
+    /**
+     * @brief Sets the thresholds and the rate, a disabled filter forwarding everything.
+     *
+     * @param max_rate Maximum number of updates per second, 0 for no limit.
+     */
+    void configure(bool enabled, const vec3& position_threshold, const vec3& direction_threshold, double max_rate) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      enabled_ = enabled;
+      position_threshold_ = position_threshold;
+      direction_threshold_ = direction_threshold;
+      interval_ = max_rate > 0
+        ? std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / max_rate))
+        : clock::duration::zero();
+    }
+
+    /**
+     * @brief Forgets the state sent, when leaving the conference it applied to.
+     */
+    void reset() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      sent_positions_.clear();
+      pending_positions_.clear();
+      sent_direction_.reset();
+      pending_direction_.reset();
+      sent_environment_.reset();
+      pending_environment_.reset();
+      next_update_ = clock::time_point{};
+      deferred_ = false;
+    }
+
+    /**
+     * @brief Filters an update, positions holding 3 floats per user id and
+     * environment and direction being optional.
+     *
+     * @return Whether update was filled with changes to send to the SDK.
+     */
+    template<typename Update>
+    bool filter(int count, const char* const* user_ids, const float* positions, const float* environment_values, const float* direction,
+                Update& update, clock::time_point now = clock::now()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      for (int i = 0; i < count; i++) {
+        const float* p = positions + 3 * i;
+        submit_position(user_ids[i], vec3{ p[0], p[1], p[2] });
+      }
+
+      if (direction) {
+        submit(vec3{ direction[0], direction[1], direction[2] }, sent_direction_, pending_direction_, direction_threshold_);
+      }
+
+      if (environment_values) {
+        environment e;
+        std::copy(environment_values, environment_values + e.size(), e.begin());
+        submit(e, sent_environment_, pending_environment_, environment{});
+      }
+
+      if (!pending()) {
+        return false;
+      }
+
+      if (enabled_ && now < next_update_) {
+        statistics_.deferred++;
+        defer();
+        return false;
+      }
+
+      send(update, now);
+      return true;
+    }
+
+    /**
+     * @brief Fills update with the changes held back by the maximum update
+     * rate, without waiting for the end of the interval.
+     *
+     * @return Whether update was filled with changes to send to the SDK.
+     */
+    template<typename Update>
+    bool flush(Update& update, clock::time_point now = clock::now()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!pending()) {
+        return false;
+      }
+
+      send(update, now);
+      return true;
+    }
+
+    spatial_filter_statistics statistics() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return statistics_;
+    }
+
+  private:
+    // Called with the lock held
+    bool pending() const {
+      return !pending_positions_.empty() || pending_direction_ || pending_environment_;
+    }
+
+    // Called with the lock held, fills update with the pending changes
+    template<typename Update>
+    void send(Update& update, clock::time_point now) {
+      if (pending_environment_) {
+        const auto& e = *pending_environment_;
+        update.set_spatial_environment({e[0], e[1], e[2]}, {e[3], e[4], e[5]}, {e[6], e[7], e[8]}, {e[9], e[10], e[11]});
+        sent_environment_ = std::exchange(pending_environment_, std::nullopt);
+        statistics_.forwarded++;
+      }
+
+      if (pending_direction_) {
+        const auto& d = *pending_direction_;
+        update.set_spatial_direction({d[0], d[1], d[2]});
+        sent_direction_ = std::exchange(pending_direction_, std::nullopt);
+        statistics_.forwarded++;
+      }
+
+      for (const auto& [id, p] : pending_positions_) {
+        update.set_spatial_position(id, {p[0], p[1], p[2]});
+        sent_positions_[id] = p;
+        statistics_.forwarded++;
+      }
+
+      pending_positions_.clear();
+      next_update_ = now + interval_;
+      deferred_ = false;
+    }
+
+    // Called with the lock held, wakes the flush thread up for the changes held back
+    void defer() {
+      // Held back until the next call or flush while stopping
+      if (!on_deferred_ || stopping_) {
+        return;
+      }
+
+      deferred_ = true;
+      if (!thread_.joinable()) {
+        thread_ = std::thread([this]() { run(); });
+      } else {
+        wakeup_.notify_one();
+      }
+    }
+
+    void run() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true) {
+        wakeup_.wait(lock, [this]() { return stopping_ || deferred_; });
+        wakeup_.wait_until(lock, next_update_, [this]() { return stopping_ || !deferred_; });
+
+        if (stopping_) {
+          return;
+        }
+
+        // Sent meanwhile by a call past the interval otherwise
+        if (deferred_ && clock::now() >= next_update_) {
+          deferred_ = false;
+          lock.unlock();
+          on_deferred_();
+          lock.lock();
+        }
+      }
+    }
+
+    template<size_t N>
+    static bool moved(const std::array<float, N>& from, const std::array<float, N>& to, const std::array<float, N>& threshold) {
+      for (size_t i = 0; i < N; i++) {
+        if (std::fabs(to[i] - from[i]) > threshold[i]) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Called with the lock held, queues value unless it matches the value sent
+    template<size_t N>
+    void submit(const std::array<float, N>& value, const std::optional<std::array<float, N>>& sent,
+                std::optional<std::array<float, N>>& pending, const std::array<float, N>& threshold) {
+      statistics_.submitted++;
+      if (pending) {
+        statistics_.elided++;
+        pending.reset();
+      }
+
+      if (!enabled_ || !sent || moved(*sent, value, threshold)) {
+        pending = value;
+      } else {
+        statistics_.elided++;
+      }
+    }
+
+    // Called with the lock held
+    void submit_position(const char* user_id, const vec3& position) {
+      statistics_.submitted++;
+
+      auto queued = pending_positions_.find(user_id);
+      if (queued != pending_positions_.end()) {
+        statistics_.elided++;
+      }
+
+      auto sent = sent_positions_.find(user_id);
+      if (!enabled_ || sent == sent_positions_.end() || moved(sent->second, position, position_threshold_)) {
+        if (queued != pending_positions_.end()) {
+          queued->second = position;
+        } else {
+          pending_positions_.emplace(user_id, position);
+        }
+      } else {
+        statistics_.elided++;
+        if (queued != pending_positions_.end()) {
+          pending_positions_.erase(queued);
+        }
+      }
+    }
+
+    mutable std::mutex                      mutex_;
+    bool                                    enabled_ = false;
+    vec3                                    position_threshold_{};
+    vec3                                    direction_threshold_{};
+    clock::duration                         interval_ = clock::duration::zero();
+    clock::time_point                       next_update_{};
+
+    std::unordered_map<std::string, vec3>   sent_positions_;
+    std::unordered_map<std::string, vec3>   pending_positions_;
+    std::optional<vec3>                     sent_direction_;
+    std::optional<vec3>                     pending_direction_;
+    std::optional<environment>              sent_environment_;
+    std::optional<environment>              pending_environment_;
+    spatial_filter_statistics               statistics_{};
+
+    std::function<void()>                   on_deferred_;
+    std::thread                             thread_;
+    std::condition_variable                 wakeup_;
+    bool                                    deferred_ = false;
+    bool                                    stopping_ = false;
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _SPATIAL_FILTER_H_
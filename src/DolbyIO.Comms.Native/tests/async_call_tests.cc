@@ -0,0 +1,41 @@
+#include "../sdk.h"
+#include "../conference.h"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dolbyio::comms::native::tests {
+extern "C" {
+
+  /**
+   * @brief Completes an asynchronous call from another thread, as the SDK
+   * thread does, with an array of participants or with an error.
+   */
+  EXPORT_API int AsyncCallTest(int participants, bool fail, completion_type done, std::intptr_t cookie) {
+    completion c(done, cookie);
+    std::thread sdk_thread([c, participants, fail]() {
+      if (fail) {
+        c.fail(std::make_exception_ptr(std::runtime_error("Async failure")));
+        return;
+      }
+
+      std::vector<dolbyio::comms::participant_info> infos;
+      for (int i = 0; i < participants; i++) {
+        struct dolbyio::comms::participant_info::info info { "name" + std::to_string(i), "externalId", "http://avatar.url" };
+        infos.emplace_back("user" + std::to_string(i), dolbyio::comms::participant_type::user, dolbyio::comms::participant_status::on_air, info, true, false);
+      }
+
+      event_scope scope;
+      int count = 0;
+      void* value = as_array<participant>{}(scope, infos, count);
+      c.succeed(value, count);
+    });
+
+    sdk_thread.detach();
+    return call<>::result_success;
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
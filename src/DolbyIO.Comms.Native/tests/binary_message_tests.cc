@@ -0,0 +1,53 @@
+#include "../sdk.h"
+#include "../binary_message.h"
+
+#include <vector>
+
+namespace dolbyio::comms::native::tests {
+extern "C" {
+
+  /**
+   * @brief Encodes size bytes of data into a binary message, then decodes it into out.
+   *
+   * @return The length of the message, -1 if it did not decode to size bytes.
+   */
+  EXPORT_API int BinaryMessageTest(const uint8_t* data, int size, int compress_threshold, uint8_t* out) {
+    std::string message = binary_message::encode(data, size, compress_threshold);
+    if (binary_message::size(message) != size || !binary_message::decode(message, out)) {
+      return -1;
+    }
+
+    return (int)message.size();
+  }
+
+  /**
+   * @brief Checks that payloads over binary_message::max_size are neither sent nor decoded.
+   *
+   * @return 0 on success, or the number of the first failing check.
+   */
+  EXPORT_API int BinaryMessageLimitTest() {
+    std::vector<uint8_t> zeros(binary_message::max_size + 1);
+    try {
+      binary_message::encode(zeros.data(), zeros.size(), 256);
+      return 1;
+    } catch (const std::invalid_argument&) {
+    }
+
+    std::string message = binary_message::encode(zeros.data(), binary_message::max_size, 256);
+    if (binary_message::size(message) != (long long)binary_message::max_size) {
+      return 2;
+    }
+
+    // The same block claiming one more byte, which it could still expand to
+    std::string forged = message;
+    size_t digits = forged.find(':') - binary_message::header.size() - 1;
+    forged.replace(binary_message::header.size() + 1, digits, std::to_string(binary_message::max_size + 1));
+    if (binary_message::size(forged) != -1 || binary_message::decode(forged, zeros.data())) {
+      return 3;
+    }
+
+    return 0;
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
@@ -0,0 +1,127 @@
+#include "../sdk.h"
+#include "../device_cache.h"
+#include "../device_handles.h"
+
+#include <string>
+
+namespace dolbyio::comms::native::tests {
+extern "C" {
+
+  static camera_device test_camera(int i, const std::string& name = "Camera") {
+    return camera_device{ name + " " + std::to_string(i), "cam" + std::to_string(i) };
+  }
+
+  /**
+   * @brief Fills a camera list with an enumeration overtaken by a plug event,
+   * then with a fresh one of devices cameras, before plugging a camera,
+   * renaming camera 1 and unplugging camera 0.
+   *
+   * @param stale_filled Whether the overtaken enumeration was stored.
+   * @param renamed_index The position of camera 1 in the list, -1 if it was not renamed.
+   * @param unplugged_found Whether camera 0 can still be looked up.
+   * @return The number of cameras listed.
+   */
+  EXPORT_API int DeviceCacheTest(int devices, bool* stale_filled, int* renamed_index, bool* unplugged_found) {
+    camera_device_list list;
+    std::vector<camera_device> enumerated;
+    for (int i = 0; i < devices; i++) {
+      enumerated.push_back(test_camera(i));
+    }
+
+    uint64_t generation = list.generation();
+    list.upsert(test_camera(devices));
+    *stale_filled = list.fill(enumerated, generation);
+
+    list.fill(enumerated, list.generation());
+    list.upsert(test_camera(devices));
+    list.upsert(test_camera(1, "Renamed"));
+    list.erase([](const camera_device& device) { return device.unique_id == "cam0"; });
+
+    auto same_id = [](const std::string& id) {
+      return [id](const camera_device& device) { return device.unique_id == id; };
+    };
+    *unplugged_found = list.find("cam0", same_id("cam0")).has_value();
+
+    std::vector<camera_device> cached;
+    list.get(cached);
+    *renamed_index = -1;
+    for (size_t i = 0; i < cached.size(); i++) {
+      if (cached[i].display_name == "Renamed 1" && list.find("cam1", same_id("cam1"))->display_name == "Renamed 1") {
+        *renamed_index = (int)i;
+      }
+    }
+
+    return (int)cached.size();
+  }
+
+  /**
+   * @brief Interns a microphone and a speaker, unplugs and plugs the microphone
+   * back, then plugs and unplugs storm other devices one after the other.
+   *
+   * @param stable Whether the microphone kept its handle, distinct from the speaker one.
+   * @param kept_on_removal Whether the removed microphone still translated to its handle.
+   * @param reclaimed Whether the first device of the storm was reclaimed.
+   * @return The number of identities left in the table.
+   */
+  EXPORT_API int DeviceHandlesTest(int storm, bool* stable, bool* kept_on_removal, bool* reclaimed) {
+    handle_table<std::string> handles;
+
+    auto mic = handles.intern("mic");
+    auto speaker = handles.intern("speaker");
+    *stable = mic != speaker && handles.intern("mic") == mic && handles.identity(mic) == std::string("mic");
+
+    handles.remove("mic");
+    *kept_on_removal = handles.find("mic") == mic;
+    *stable = *stable && handles.intern("mic") == mic;
+
+    handle_table<std::string>::handle first = handle_table<std::string>::no_handle;
+    for (int i = 0; i < storm; i++) {
+      auto h = handles.intern("usb" + std::to_string(i));
+      if (i == 0) {
+        first = h;
+      }
+      handles.remove("usb" + std::to_string(i));
+    }
+
+    *reclaimed = handles.find("usb0") == handle_table<std::string>::no_handle && !handles.identity(first).has_value();
+    return (int)handles.size();
+  }
+
+  /**
+   * @brief Unplugs a microphone, plugs it back and unplugs it again, followed
+   * by as many other devices as the table keeps once removed.
+   *
+   * @return 0 on success, or the number of the first failing check.
+   */
+  EXPORT_API int DeviceHandlesReplugTest() {
+    using table = handle_table<std::string>;
+    table handles;
+
+    auto mic = handles.intern("mic");
+    handles.remove("mic");
+    if (handles.intern("mic") != mic) {
+      return 1;
+    }
+
+    handles.remove("mic");
+    for (size_t i = 1; i < table::max_removed; i++) {
+      handles.intern("usb" + std::to_string(i));
+      handles.remove("usb" + std::to_string(i));
+    }
+
+    // The microphone is the oldest of max_removed removed devices, all kept
+    if (handles.find("mic") != mic || handles.size() != table::max_removed) {
+      return 2;
+    }
+
+    handles.intern("usb0");
+    handles.remove("usb0");
+    if (handles.find("mic") != table::no_handle || handles.find("usb1") == table::no_handle) {
+      return 3;
+    }
+
+    return 0;
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
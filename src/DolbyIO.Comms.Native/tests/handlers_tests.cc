@@ -0,0 +1,95 @@
+#include "../sdk.h"
+
+#include <thread>
+#include <vector>
+
+namespace dolbyio::comms::native::tests {
+
+  struct on_registry_test {
+    using type = void*;
+    static constexpr const char* name = "on_registry_test";
+  };
+
+extern "C" {
+
+  /**
+   * @brief Adds handlers from several threads at once, each thread then
+   * removing the even hashes it added while another thread looks them up.
+   *
+   * @return The number of handlers in an unexpected state afterwards.
+   */
+  EXPORT_API int HandlerRegistryTest(int threads, int handlers) {
+    auto& registry = handler_registry<on_registry_test>::instance();
+    std::atomic<bool> done{ false };
+    std::vector<std::thread> workers;
+
+    std::thread reader([&]() {
+      while (!done.load()) {
+        for (int hash = 0; hash < threads * handlers; hash++) {
+          registry.contains(hash);
+        }
+      }
+    });
+
+    for (int t = 0; t < threads; t++) {
+      workers.emplace_back([&registry, t, handlers]() {
+        for (int i = 0; i < handlers; i++) {
+          registry.add(t * handlers + i, std::make_shared<handler_registration>());
+        }
+
+        for (int i = 0; i < handlers; i += 2) {
+          registry.take(t * handlers + i);
+        }
+      });
+    }
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    done = true;
+    reader.join();
+
+    int failures = 0;
+    for (int hash = 0; hash < threads * handlers; hash++) {
+      bool expected = hash % handlers % 2 == 1;
+      if (registry.contains(hash) != expected) {
+        failures++;
+      }
+      registry.take(hash);
+    }
+
+    return failures + (int)registry.size();
+  }
+
+  /**
+   * @brief Discards registrations the way a refused subscription does.
+   *
+   * @return 0 on success, or the number of the first failing check.
+   */
+  EXPORT_API int HandlerDiscardTest() {
+    auto& registry = handler_registry<on_registry_test>::instance();
+    auto first = std::make_shared<handler_registration>();
+    auto second = std::make_shared<handler_registration>();
+
+    registry.add(0, first);
+    if (!registry.discard(0, first) || registry.contains(0)) {
+      return 1;
+    }
+
+    // A refusal arriving after the handler was replaced keeps the replacement
+    registry.add(0, first);
+    registry.add(0, second);
+    if (registry.discard(0, first) || !registry.contains(0)) {
+      return 2;
+    }
+
+    if (!registry.discard(0, second) || registry.discard(0, second) || registry.size() != 0) {
+      return 3;
+    }
+
+    return 0;
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
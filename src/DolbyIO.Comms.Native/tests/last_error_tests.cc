@@ -0,0 +1,56 @@
+#include "../sdk.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dolbyio::comms::native::tests {
+extern "C" {
+
+  /**
+   * @brief Fails on several threads at once, each thread then checking that
+   * it still reads its own error, then fails on the calling thread with an
+   * std::invalid_argument holding a message longer than the error buffer.
+   *
+   * @return The number of threads that read another thread's error.
+   */
+  EXPORT_API int LastErrorTest(int threads) {
+    std::atomic<int> failures{ 0 };
+    std::atomic<int> ready{ 0 };
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; t++) {
+      workers.emplace_back([&, t]() {
+        std::string message = "Thread " + std::to_string(t);
+        if (t % 2) {
+          last_error::current().set(std::invalid_argument(message));
+        } else {
+          last_error::current().set(std::runtime_error(message));
+        }
+
+        // Every thread has failed before any of them checks
+        ready++;
+        while (ready.load() < threads) {
+          std::this_thread::yield();
+        }
+
+        const last_error& error = last_error::current();
+        error_code expected = t % 2 ? error_code::invalid_argument : error_code::unknown;
+        if (error.code != expected || error.length != message.size() || message != error.message) {
+          failures++;
+        }
+      });
+    }
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    last_error::current().set(std::invalid_argument(std::string(2 * last_error::max_message, 'e')));
+    return failures.load();
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
@@ -0,0 +1,94 @@
+#include "../sdk.h"
+#include "../message_batcher.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dolbyio::comms::native::tests {
+extern "C" {
+
+  using messages_delegate_type = void (*)(int count, char* messages[]);
+
+  /**
+   * @brief Queues messages, some of them looking like the framing itself,
+   * into frames of max_frame_size bytes, then splits every frame back and
+   * hands its messages to delegate. The flush delay is long enough for
+   * the frames to be closed by size only, and by the final stop.
+   *
+   * @return The number of frames sent, -1 if one of them is larger than
+   * max_frame_size while holding several messages.
+   */
+  EXPORT_API int MessageBatcherTest(messages_delegate_type delegate, int messages, int max_frame_size) {
+    std::vector<std::string> frames;
+    std::mutex frames_lock;
+
+    auto batcher = message_batcher::create([&](std::string&& frame, std::function<void()>) {
+      std::lock_guard<std::mutex> lock(frames_lock);
+      frames.push_back(std::move(frame));
+    }, max_frame_size, std::chrono::hours(1));
+
+    for (int i = 0; i < messages; i++) {
+      batcher->push(i % 3 ? "message" + std::to_string(i) : "12:" + std::to_string(i) + std::string(message_frame::header));
+    }
+
+    batcher->stop();
+
+    std::lock_guard<std::mutex> lock(frames_lock);
+    for (const auto& frame : frames) {
+      event_scope scope;
+      int count = message_frame::count(frame);
+      if (count > 1 && frame.size() > (size_t)max_frame_size) {
+        return -1;
+      }
+
+      char** split = scope.allocate<char*>(count);
+      int i = 0;
+      message_frame::split(frame, [&](std::string_view message) {
+        split[i++] = scope.strdup(message.data(), message.size());
+      });
+
+      delegate(count, split);
+    }
+
+    return (int)frames.size();
+  }
+
+  /**
+   * @brief Stops a batcher while its flush thread hands a frame to a slow
+   * sink, with another frame pending, then queues a message again.
+   *
+   * @return 0 if stop() returned after both frames were sent and the last
+   * message was refused, the number of the failing check otherwise.
+   */
+  EXPORT_API int MessageBatcherStopTest() {
+    std::atomic<int> sending{ 0 };
+    std::atomic<int> sent{ 0 };
+
+    auto batcher = message_batcher::create([&](std::string&&, std::function<void()>) {
+      sending++;
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      sent++;
+    }, 1024, std::chrono::milliseconds(1));
+
+    batcher->push("flushed");
+    while (sending == 0) {
+      std::this_thread::yield();
+    }
+
+    batcher->push("pending");
+    batcher->stop();
+    if (sent != 2) {
+      return 1;
+    }
+
+    if (batcher->push("late") || sending != 2) {
+      return 2;
+    }
+
+    return 0;
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
@@ -0,0 +1,80 @@
+#include "../sdk.h"
+#include "../participant_batcher.h"
+
+#include <string>
+#include <thread>
+
+namespace dolbyio::comms::native::tests {
+
+  static dolbyio::comms::participant_info make_participant(int i, int status) {
+    struct dolbyio::comms::participant_info::info info { "name" + std::to_string(i), "externalId", "http://avatar.url" };
+    return dolbyio::comms::participant_info(
+      "user" + std::to_string(i),
+      dolbyio::comms::participant_type::user,
+      (dolbyio::comms::participant_status)status,
+      info,
+      true,
+      false
+    );
+  }
+
+  static int stopped_batch_participants;
+
+  static void on_stopped_batch(participant*, int count) {
+    stopped_batch_participants += count;
+  }
+
+extern "C" {
+
+  /**
+   * @brief Pushes several rounds of updates for every participant, the status
+   * of round r being r % 5, then waits for the batch.
+   *
+   * @param wait_window_ms How long to let the flush thread deliver the batch,
+   * 0 to flush synchronously with a window too long to ever expire.
+   */
+  EXPORT_API void ParticipantBatchTest(on_participants_batch_updated::type handler, int participants, int rounds, int wait_window_ms) {
+    auto window = std::chrono::milliseconds(wait_window_ms > 0 ? wait_window_ms : 60000);
+    auto batcher = participant_batcher::create(handler, window);
+
+    for (int round = 0; round < rounds; round++) {
+      for (int i = 0; i < participants; i++) {
+        batcher->push(make_participant(i, round % 5));
+      }
+    }
+
+    if (wait_window_ms > 0) {
+      std::this_thread::sleep_for(window * 5);
+    } else {
+      batcher->flush();
+    }
+
+    batcher->stop();
+  }
+
+  /**
+   * @brief Pushes participants to a batcher with a 10 ms window, stops it,
+   * then pushes and flushes again, as a subscription outliving its batcher would.
+   *
+   * @return The number of participants delivered, which must be 0.
+   */
+  EXPORT_API int ParticipantBatchStopTest(int participants) {
+    stopped_batch_participants = 0;
+    auto batcher = participant_batcher::create(&on_stopped_batch, std::chrono::milliseconds(10));
+
+    for (int i = 0; i < participants; i++) {
+      batcher->push(make_participant(i, 0));
+    }
+    batcher->stop();
+
+    for (int i = 0; i < participants; i++) {
+      batcher->push(make_participant(i, 1));
+    }
+    batcher->flush();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return stopped_batch_participants;
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
@@ -0,0 +1,51 @@
+#include "../sdk.h"
+#include "../participant_roster.h"
+
+#include <string>
+
+namespace dolbyio::comms::native::tests {
+extern "C" {
+
+  static dolbyio::comms::participant_info roster_participant(int i, int status) {
+    struct dolbyio::comms::participant_info::info info { "name" + std::to_string(i), "externalId", "http://avatar.url" };
+    return dolbyio::comms::participant_info(
+      "user" + std::to_string(i),
+      dolbyio::comms::participant_type::user,
+      (dolbyio::comms::participant_status)status,
+      info,
+      true,
+      false
+    );
+  }
+
+  /**
+   * @brief Queries a roster four times: a snapshot of the participants, the
+   * changes after updating the first updated of them to status 2, the changes
+   * when nothing happened, then the changes after leaving the conference.
+   */
+  EXPORT_API void ParticipantRosterTest(participant_roster::delegate_type delegate, int participants, int updated) {
+    participant_roster roster;
+
+    for (int i = 0; i < participants; i++) {
+      roster.upsert(roster_participant(i, 1));
+    }
+
+    roster.changes_since(0, delegate);
+    uint64_t version = roster.version();
+
+    for (int i = 0; i < updated; i++) {
+      roster.upsert(roster_participant(i, 2));
+      roster.upsert(roster_participant(i, 1), true);
+    }
+
+    roster.changes_since(version, delegate);
+    version = roster.version();
+
+    roster.changes_since(version, delegate);
+
+    roster.clear();
+    roster.changes_since(version, delegate);
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
@@ -0,0 +1,140 @@
+#include "../sdk.h"
+#include "../rgba_to_yuv.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace dolbyio::comms::native::tests {
+extern "C" {
+
+  /**
+   * @brief Converts a random frame of 32 bit pixels with every vectorized kernel
+   * available on this CPU and compares the result with the scalar reference converter.
+   *
+   * @param layout The chroma layout (0: I420, 1: NV12, 2: NV21).
+   * @param order The byte order of the pixels (0: ARGB, 1: RGBA, 2: BGRA).
+   * @param width The frame width.
+   * @param height The frame height.
+   * @param padding Extra bytes added to every plane stride.
+   * @param type The ycbcr_type matrix.
+   * @return The number of bytes that differ from the scalar output.
+   */
+  EXPORT_API int RgbaToYuvSimdTest(int layout, int order, int width, int height, int padding, int type) {
+    auto chroma_layout = (yuv_chroma_layout)layout;
+    auto byte_order = (rgb32_order)order;
+    auto matrix = (ycbcr_type)type;
+
+    uint32_t rgb_stride = width * 4 + padding;
+    uint32_t y_stride = width + padding;
+    uint32_t uv_stride = (chroma_layout == yuv_chroma_layout::i420 ? (width + 1) / 2 : 2 * ((width + 1) / 2)) + padding;
+    uint32_t uv_height = (height + 1) / 2;
+
+    std::mt19937 rng(width * 31 + height * 17 + layout * 7 + order * 5 + type);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    std::vector<uint8_t> rgb(rgb_stride * height);
+    for (auto& b : rgb) b = dist(rng);
+
+    // Make sure the saturated colours are covered
+    if (width >= 2 && height >= 2) {
+      for (int i = 0; i < 4; i++) {
+        rgb[i] = 255;
+        rgb[4 + i] = 255;
+        rgb[rgb_stride + i] = 0;
+        rgb[rgb_stride + 4 + i] = 0;
+      }
+    }
+
+    std::vector<uint8_t> reference(y_stride * height + 2 * uv_stride * uv_height, 0x5A);
+    uint8_t* u_reference = reference.data() + y_stride * height;
+    rgb32_yuv(yuv_simd::none, byte_order, chroma_layout, width, height, rgb.data(), rgb_stride,
+      reference.data(), u_reference, u_reference + uv_stride * uv_height, y_stride, uv_stride, matrix);
+
+    int mismatches = 0;
+    for (yuv_simd simd : { yuv_simd::sse2, yuv_simd::avx2, yuv_simd::neon }) {
+      if (!yuv_simd_supported(simd)) {
+        continue;
+      }
+
+      std::vector<uint8_t> result(reference.size(), 0x5A);
+      uint8_t* u_result = result.data() + y_stride * height;
+      rgb32_yuv(simd, byte_order, chroma_layout, width, height, rgb.data(), rgb_stride,
+        result.data(), u_result, u_result + uv_stride * uv_height, y_stride, uv_stride, matrix);
+
+      for (size_t i = 0; i < result.size(); i++) {
+        if (result[i] != reference[i]) {
+          mismatches++;
+        }
+      }
+    }
+
+    return mismatches;
+  }
+
+  /**
+   * @brief Converts a frame of random 2x2 blocks of a single colour to YUV with
+   * the fastest kernel and back to ARGB with yuv_rgb24.
+   *
+   * @return The largest difference between a colour channel and the original.
+   */
+  EXPORT_API int RgbaToYuvRoundTripTest(int layout, int order, int width, int height, int type) {
+    auto chroma_layout = (yuv_chroma_layout)layout;
+    auto byte_order = (rgb32_order)order;
+    auto matrix = (ycbcr_type)type;
+
+    // Byte offsets of red, green and blue
+    int r = order == 2 ? 2 : (order == 1 ? 0 : 1);
+    int g = order == 0 ? 2 : 1;
+    int b = order == 2 ? 0 : (order == 1 ? 2 : 3);
+
+    uint32_t rgb_stride = width * 4;
+    uint32_t uv_stride = chroma_layout == yuv_chroma_layout::i420 ? (width + 1) / 2 : 2 * ((width + 1) / 2);
+    uint32_t uv_height = (height + 1) / 2;
+
+    std::mt19937 rng(width * 13 + height * 11 + layout * 7 + order * 5 + type);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    std::vector<uint8_t> rgb(rgb_stride * height);
+    for (int y = 0; y < height; y += 2) {
+      for (int x = 0; x < width; x += 2) {
+        uint8_t color[4] = { (uint8_t)dist(rng), (uint8_t)dist(rng), (uint8_t)dist(rng), (uint8_t)dist(rng) };
+        // The blocks of the last row and column of an odd sized frame are cut
+        for (int i = 0; i < 4; i++) {
+          if (y + i / 2 < height && x + i % 2 < width) {
+            uint8_t* pixel = rgb.data() + (y + i / 2) * rgb_stride + 4 * (x + i % 2);
+            std::memcpy(pixel, color, 4);
+          }
+        }
+      }
+    }
+
+    std::vector<uint8_t> yuv(width * height + 2 * uv_stride * uv_height);
+    uint8_t* u_plane = yuv.data() + width * height;
+    uint8_t* v_plane = u_plane + uv_stride * uv_height;
+    rgb32_yuv(yuv_simd_detect(), byte_order, chroma_layout, width, height, rgb.data(), rgb_stride,
+      yuv.data(), u_plane, v_plane, width, uv_stride, matrix);
+
+    std::vector<uint8_t> argb(rgb_stride * height);
+    yuv_rgb24(yuv_simd::none, chroma_layout, width, height, yuv.data(), u_plane, v_plane, width, uv_stride,
+      argb.data(), rgb_stride, matrix);
+
+    // yuv_rgb24 leaves the last row and column of odd sizes untouched
+    int max_error = 0;
+    for (int y = 0; y < (height & ~1); y++) {
+      for (int x = 0; x < (width & ~1); x++) {
+        const uint8_t* source = rgb.data() + y * rgb_stride + 4 * x;
+        const uint8_t* result = argb.data() + y * rgb_stride + 4 * x;
+        max_error = std::max(max_error, std::abs(source[r] - result[1]));
+        max_error = std::max(max_error, std::abs(source[g] - result[2]));
+        max_error = std::max(max_error, std::abs(source[b] - result[3]));
+      }
+    }
+
+    return max_error;
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
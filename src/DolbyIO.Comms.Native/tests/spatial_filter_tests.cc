@@ -0,0 +1,160 @@
+#include "../sdk.h"
+#include "../spatial_filter.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace dolbyio::comms::native::tests {
+extern "C" {
+
+  // Counts the changes the filter forwards, standing in for spatial_audio_batch_update
+  struct counting_update {
+    int positions = 0;
+    int directions = 0;
+    spatial_filter::vec3 last{};
+
+    void set_spatial_position(const std::string&, const spatial_filter::vec3& p) { positions++; last = p; }
+    void set_spatial_direction(const spatial_filter::vec3& d) { directions++; last = d; }
+    void set_spatial_environment(const spatial_filter::vec3&, const spatial_filter::vec3&,
+                                 const spatial_filter::vec3&, const spatial_filter::vec3&) {}
+  };
+
+  /**
+   * @brief Moves two participants through a filter with a threshold of 0.5
+   * and 10 updates per second, at fixed times: both at the origin, then one
+   * of them slightly and the other one by 1, then the second one twice within
+   * the interval, then the first one slightly again once the interval passed.
+   *
+   * @return The number of positions forwarded.
+   */
+  EXPORT_API int SpatialFilterTest(spatial_filter_statistics* statistics) {
+    spatial_filter filter;
+    filter.configure(true, {0.5f, 0.5f, 0.5f}, {1.0f, 1.0f, 1.0f}, 10);
+
+    const char* ids[] = { "user0", "user1" };
+    auto start = spatial_filter::clock::now();
+    counting_update update;
+
+    const float origin[] = { 0, 0, 0, 0, 0, 0 };
+    filter.filter(2, ids, origin, nullptr, nullptr, update, start);
+
+    const float moved[] = { 0.1f, 0, 0, 1, 0, 0 };
+    filter.filter(2, ids, moved, nullptr, nullptr, update, start + std::chrono::milliseconds(200));
+
+    const float further[] = { 2, 0, 0 };
+    filter.filter(1, ids + 1, further, nullptr, nullptr, update, start + std::chrono::milliseconds(250));
+
+    const float furthest[] = { 3, 0, 0 };
+    filter.filter(1, ids + 1, furthest, nullptr, nullptr, update, start + std::chrono::milliseconds(260));
+
+    const float drifted[] = { 0.2f, 0, 0 };
+    filter.filter(1, ids, drifted, nullptr, nullptr, update, start + std::chrono::milliseconds(400));
+
+    *statistics = filter.statistics();
+    return update.positions;
+  }
+
+  /**
+   * @brief Moves a participant twice in a row through a filter allowing 5
+   * updates per second, waiting for the flush thread to send the second
+   * move, then turns twice within the interval, flushing the latest turn explicitly.
+   *
+   * @return 0 if both trailing changes were sent, the number of the failing check otherwise.
+   */
+  EXPORT_API int SpatialFilterFlushTest() {
+    std::mutex mutex;
+    std::condition_variable flushed;
+    counting_update deferred;
+
+    std::unique_ptr<spatial_filter> filter;
+    filter = std::make_unique<spatial_filter>([&]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      filter->flush(deferred);
+      flushed.notify_one();
+    });
+    filter->configure(true, {0.5f, 0.5f, 0.5f}, {0.5f, 0.5f, 0.5f}, 5);
+
+    const char* id = "user0";
+    counting_update update;
+    const float origin[] = { 0, 0, 0 };
+    const float moved[] = { 1, 0, 0 };
+    filter->filter(1, &id, origin, nullptr, nullptr, update);
+    filter->filter(1, &id, moved, nullptr, nullptr, update);
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      flushed.wait_for(lock, std::chrono::seconds(2), [&]() { return deferred.positions > 0; });
+      if (update.positions != 1 || deferred.positions != 1 || deferred.last != spatial_filter::vec3{ 1, 0, 0 }) {
+        return 1;
+      }
+    }
+
+    const float turned[] = { 1, 0, 0 };
+    const float turned_back[] = { -1, 0, 0 };
+    filter->filter(0, nullptr, nullptr, nullptr, turned, update);
+    filter->filter(0, nullptr, nullptr, nullptr, turned_back, update);
+    filter->flush(update);
+    if (update.directions != 1 || update.last != spatial_filter::vec3{ -1, 0, 0 }) {
+      return 2;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Holds a move back in a filter allowing 5 updates per second, stops
+   * the flush thread before the end of the interval, then holds another move
+   * back once stopped.
+   *
+   * @return 0 if nothing was sent while stopped and the second move was sent
+   * by the thread started again, the number of the failing check otherwise.
+   */
+  EXPORT_API int SpatialFilterStopTest() {
+    std::mutex mutex;
+    std::condition_variable flushed;
+    counting_update deferred;
+
+    std::unique_ptr<spatial_filter> filter;
+    filter = std::make_unique<spatial_filter>([&]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      filter->flush(deferred);
+      flushed.notify_one();
+    });
+    filter->configure(true, {0.5f, 0.5f, 0.5f}, {0.5f, 0.5f, 0.5f}, 5);
+
+    const char* id = "user0";
+    counting_update update;
+    const float origin[] = { 0, 0, 0 };
+    const float moved[] = { 1, 0, 0 };
+    filter->filter(1, &id, origin, nullptr, nullptr, update);
+    filter->filter(1, &id, moved, nullptr, nullptr, update);
+    filter->stop();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (deferred.positions != 0) {
+        return 1;
+      }
+    }
+
+    // Sends the move kept while stopped, then holds the next one back
+    const float further[] = { 2, 0, 0 };
+    filter->filter(1, &id, further, nullptr, nullptr, update);
+    const float furthest[] = { 3, 0, 0 };
+    filter->filter(1, &id, furthest, nullptr, nullptr, update);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    flushed.wait_for(lock, std::chrono::seconds(2), [&]() { return deferred.positions > 0; });
+    if (update.positions != 2 || deferred.positions != 1 || deferred.last != spatial_filter::vec3{ 3, 0, 0 }) {
+      return 2;
+    }
+
+    return 0;
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
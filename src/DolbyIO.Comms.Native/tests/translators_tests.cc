@@ -54,6 +54,39 @@ extern "C" {
     no_alloc_to_c(result, participant);
   }
 
+  /**
+   * @brief Dispatches the same participant event several times through an
+   * event_scope, as the participant handlers do.
+   *
+   * @return The number of bytes the arena of the thread grew by after the first event.
+   */
+  EXPORT_API int EventScopeTest(on_participant_updated::type handler, int events) {
+    struct dolbyio::comms::participant_info::info info { "Anonymous", "externalId", "http://avatar.url" };
+
+    dolbyio::comms::participant_info participant (
+      "userId",
+      dolbyio::comms::participant_type::user,
+      dolbyio::comms::participant_status::connecting,
+      info,
+      true,
+      true
+    );
+
+    size_t capacity = 0;
+    for (int i = 0; i < events; i++) {
+      {
+        event_scope scope;
+        handler(scope.to_c<dolbyio::comms::native::participant>(participant));
+      }
+
+      if (i == 0) {
+        capacity = event_arena::local().capacity();
+      }
+    }
+
+    return (int)(event_arena::local().capacity() - capacity);
+  }
+
   EXPORT_API void AudioDeviceTest(audio_device* result) {
 
     //dolbyio::comms::audio_device dev({'U', 'I', 'D'}, "dummy device", dvc_device::direction::output, audio_device::platform::macos, "ID");
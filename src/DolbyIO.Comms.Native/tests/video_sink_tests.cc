@@ -0,0 +1,547 @@
+#include "../sdk.h"
+#include "../frame_buffer_pool.h"
+#include "../frame_queue.h"
+#include "../frame_rate_limiter.h"
+#include "../shm_frame_ring.h"
+#include "../video_sink.h"
+#include "../video_formats.h"
+#include "../video_source.h"
+#include "../worker_pool.h"
+#include "../yuv_scale.h"
+#include "../yuv_to_rgba.h"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dolbyio::comms::native::tests {
+
+  static std::atomic<bool> delegate_running{ false };
+  static std::atomic<bool> delegate_unblocked{ false };
+
+  // Stands for a slow delegate, blocking until the test unblocks it
+  static void blocking_delegate(const video_sink_frame* frame) {
+    delegate_running = true;
+    while (!delegate_unblocked) {
+      std::this_thread::yield();
+    }
+    frame_buffer_pool::release(frame->buffer);
+  }
+
+  static video_sink* deleted_sink;
+  static std::atomic<bool> sink_deleted{ false };
+
+  // Stands for a C# OnFrame disposing of its sink
+  static void deleting_delegate(const video_sink_frame* frame) {
+    frame_buffer_pool::release(frame->buffer);
+    delete std::exchange(deleted_sink, nullptr);
+    sink_deleted = true;
+  }
+
+extern "C" {
+
+  /**
+   * @brief Runs two rounds of three 640x360 frames through a pool of the given
+   * depth, keeping one frame of the second round outstanding when sampling the statistics.
+   */
+  EXPORT_API void FrameBufferPoolTest(int depth, frame_buffer_pool_stats* stats) {
+    auto pool = frame_buffer_pool::create(depth);
+    size_t size = 640 * 360 * 4;
+    std::vector<uint8_t*> buffers;
+
+    for (int round = 0; round < 2; round++) {
+      for (int i = 0; i < 3; i++) {
+        buffers.push_back(pool->acquire(640, 360, size));
+      }
+
+      for (size_t i = round; i < buffers.size(); i++) {
+        frame_buffer_pool::release(buffers[i]);
+      }
+
+      buffers.resize(round);
+    }
+
+    *stats = pool->stats();
+
+    for (auto buffer : buffers) {
+      frame_buffer_pool::release(buffer);
+    }
+  }
+
+  /**
+   * @brief Converts a random I420 frame band by band on the shared worker pool
+   * and compares the result with a single pass conversion.
+   *
+   * @return The number of bytes that differ from the single pass output.
+   */
+  EXPORT_API int RowBandConversionTest(int threads, int width, int height) {
+    uint32_t uv_stride = (width + 1) / 2;
+    uint32_t rgb_stride = width * 4;
+
+    std::mt19937 rng(width * 31 + height * 17 + threads);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    std::vector<uint8_t> y_plane(width * height);
+    std::vector<uint8_t> u_plane(uv_stride * ((height + 1) / 2));
+    std::vector<uint8_t> v_plane(u_plane.size());
+
+    for (auto& b : y_plane) b = dist(rng);
+    for (auto& b : u_plane) b = dist(rng);
+    for (auto& b : v_plane) b = dist(rng);
+
+    std::vector<uint8_t> reference(rgb_stride * height);
+    yuv420_rgb24(width, height, y_plane.data(), u_plane.data(), v_plane.data(),
+      width, uv_stride, reference.data(), rgb_stride, ycbcr_type::ycbcr_jpeg);
+
+    auto& pool = worker_pool::shared();
+    int previous_threads = pool.threads();
+    size_t previous_min_pixel_count = pool.min_pixel_count();
+    pool.threads(threads);
+    pool.min_pixel_count(0);
+
+    std::vector<uint8_t> result(rgb_stride * height);
+    pool.for_each_row_band(width, height, [&](int row_begin, int row_end) {
+      yuv420_rgb24(width, row_end - row_begin,
+        y_plane.data() + row_begin * width,
+        u_plane.data() + row_begin / 2 * uv_stride,
+        v_plane.data() + row_begin / 2 * uv_stride,
+        width, uv_stride, result.data() + row_begin * rgb_stride, rgb_stride, ycbcr_type::ycbcr_jpeg);
+    });
+
+    pool.threads(previous_threads);
+    pool.min_pixel_count(previous_min_pixel_count);
+
+    int mismatches = 0;
+    for (size_t i = 0; i < result.size(); i++) {
+      if (result[i] != reference[i]) {
+        mismatches++;
+      }
+    }
+
+    return mismatches;
+  }
+
+  /**
+   * @brief Checks the helpers producing the I420 and NV12 sink outputs.
+   *
+   * @return 0 on success, otherwise the number of the first failing check.
+   */
+  EXPORT_API int PixelFormatHelpersTest() {
+    // 3x2 chroma planes with a padded stride of 4
+    const uint8_t u[8] = { 1, 2, 3, 0, 4, 5, 6, 0 };
+    const uint8_t v[8] = { 7, 8, 9, 0, 10, 11, 12, 0 };
+
+    uint8_t uv[12];
+    i420_to_nv12_chroma(3, 2, u, v, 4, uv, 6);
+    const uint8_t expected_uv[12] = { 1, 7, 2, 8, 3, 9, 4, 10, 5, 11, 6, 12 };
+    if (memcmp(uv, expected_uv, sizeof(uv)) != 0) {
+      return 1;
+    }
+
+    uint8_t u_out[6], v_out[6];
+    nv12_to_i420_chroma(3, 2, uv, 6, u_out, v_out, 3);
+    const uint8_t expected_u[6] = { 1, 2, 3, 4, 5, 6 };
+    const uint8_t expected_v[6] = { 7, 8, 9, 10, 11, 12 };
+    if (memcmp(u_out, expected_u, sizeof(u_out)) != 0 || memcmp(v_out, expected_v, sizeof(v_out)) != 0) {
+      return 2;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Downscales and converts a random frame in one pass, and compares the
+   * result with a plane downscale followed by the scalar conversion.
+   *
+   * @param layout The source chroma layout (0: I420, 1: NV12).
+   * @param width The fitted output width.
+   * @param height The fitted output height.
+   * @return The number of bytes that differ between both outputs.
+   */
+  EXPORT_API int ScaleConvertTest(int layout, int src_width, int src_height, int max_width, int max_height, int* width, int* height) {
+    auto chroma_layout = (yuv_chroma_layout)layout;
+    yuv_fit_size(src_width, src_height, max_width, max_height, *width, *height);
+
+    uint32_t y_stride = src_width + 7;
+    uint32_t uv_stride = (chroma_layout == yuv_chroma_layout::i420 ? (src_width + 1) / 2 : 2 * ((src_width + 1) / 2)) + 5;
+    uint32_t uv_height = (src_height + 1) / 2;
+
+    std::mt19937 rng(src_width * 31 + src_height * 17 + max_width * 7 + layout);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    std::vector<uint8_t> y_plane(y_stride * src_height);
+    std::vector<uint8_t> u_plane(uv_stride * uv_height);
+    std::vector<uint8_t> v_plane(uv_stride * uv_height);
+
+    for (auto& b : y_plane) b = dist(rng);
+    for (auto& b : u_plane) b = dist(rng);
+    for (auto& b : v_plane) b = dist(rng);
+
+    uint32_t w = *width, h = *height, chroma_width = (w + 1) / 2, chroma_height = (h + 1) / 2;
+    std::vector<uint8_t> scaled_y(w * h), scaled_u(chroma_width * chroma_height), scaled_v(chroma_width * chroma_height);
+    yuv_scale_maps maps(src_width, src_height, w, h);
+    yuv_scale_planes(chroma_layout, maps,
+      y_plane.data(), u_plane.data(), v_plane.data(), y_stride, uv_stride,
+      scaled_y.data(), scaled_u.data(), scaled_v.data(), w, chroma_width);
+
+    std::vector<uint8_t> reference(w * h * 4);
+    yuv_rgb24(yuv_simd::none, yuv_chroma_layout::i420, w, h,
+      scaled_y.data(), scaled_u.data(), scaled_v.data(), w, chroma_width,
+      reference.data(), w * 4, ycbcr_type::ycbcr_jpeg);
+
+    std::vector<uint8_t> result(w * h * 4);
+    yuv_scale_rgb24(yuv_simd_detect(), chroma_layout, maps,
+      y_plane.data(), u_plane.data(), v_plane.data(), y_stride, uv_stride,
+      0, h, result.data(), w * 4, ycbcr_type::ycbcr_jpeg);
+
+    int mismatches = 0;
+    for (size_t i = 0; i < result.size(); i++) {
+      if (result[i] != reference[i]) {
+        mismatches++;
+      }
+    }
+
+    return mismatches;
+  }
+
+  /**
+   * @brief Feeds frames with alternating early and late arrival times to a limiter.
+   *
+   * @return The number of frames let through.
+   */
+  EXPORT_API int FrameRateLimiterTest(double max_fps, double input_fps, int frames, int jitter_us) {
+    frame_rate_limiter limiter;
+    limiter.max_fps(max_fps);
+
+    int admitted = 0;
+    for (int i = 0; i < frames; i++) {
+      int64_t now_us = 1000000 + (int64_t)(i * 1000000.0 / input_fps) + (i % 2 ? jitter_us : -jitter_us);
+      if (limiter.admit(now_us)) {
+        admitted++;
+      }
+    }
+
+    return admitted;
+  }
+
+  /**
+   * @brief Pushes numbered items through a delivery queue with a consumer
+   * sleeping consumer_delay_us for every item.
+   *
+   * @return 0 if every item was either delivered in order or discarded exactly
+   * once, otherwise the number of the first failing check.
+   */
+  EXPORT_API int DeliveryQueueTest(int depth, int policy, int items, int consumer_delay_us, int* delivered, int* dropped) {
+    std::atomic<int> delivered_count{ 0 }, discarded_count{ 0 }, last{ -1 };
+    std::atomic<bool> ordered{ true };
+    int dropped_count = 0;
+
+    {
+      delivery_queue<int> queue(depth, (overflow_policy)policy,
+        [&](int& item) {
+          if (item <= last.exchange(item)) {
+            ordered = false;
+          }
+          delivered_count++;
+          if (consumer_delay_us > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(consumer_delay_us));
+          }
+        },
+        [&](int&) {
+          discarded_count++;
+        });
+
+      for (int i = 0; i < items; i++) {
+        if (queue.push(i)) {
+          dropped_count++;
+        }
+      }
+
+      // Let the delivery thread drain what is left
+      for (int i = 0; i < 1000 && delivered_count + dropped_count < items; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+
+    *delivered = delivered_count;
+    *dropped = dropped_count;
+
+    if (!ordered) {
+      return 1;
+    }
+
+    if (dropped_count > discarded_count) {
+      return 2;
+    }
+
+    if (delivered_count + discarded_count != items) {
+      return 3;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Hands frames to a sink dropping frames while busy, the first frame
+   * blocking the delegate until the others were handed over. The delegate
+   * runs on another thread in sync mode and on the delivery thread in async mode.
+   *
+   * @param stats Receives the statistics once the frames were handed over.
+   * @return 0 once a frame went through again after the delegate returned, 1 if none did.
+   */
+  EXPORT_API int DropIfBusyTest(bool async, int frames, video_sink_stats* stats) {
+    const int width = 64, height = 32;
+    delegate_running = false;
+    delegate_unblocked = false;
+
+    video_sink sink(blocking_delegate, ARGB8888);
+    sink.drop_if_busy(true);
+    if (async) {
+      sink.async_delivery(2, overflow_policy::drop_oldest);
+    }
+
+    auto next_frame = [&](int i) {
+      uint8_t* buffer = sink.pool().acquire(width, height, pooled_i420_frame::size(width, height));
+      memset(buffer, 0x80, pooled_i420_frame::size(width, height));
+      return std::make_unique<pooled_i420_frame>(buffer, width, height, i * 33333);
+    };
+
+    std::thread first([&]() { sink.handle_frame(next_frame(0)); });
+    while (!delegate_running) {
+      std::this_thread::yield();
+    }
+
+    for (int i = 1; i < frames; i++) {
+      sink.handle_frame(next_frame(i));
+    }
+
+    *stats = sink.stats();
+    delegate_unblocked = true;
+    first.join();
+
+    // The delivery thread releases the flag right after the delegate returned
+    for (int i = 0; i < 1000; i++) {
+      sink.handle_frame(next_frame(frames + i));
+      if (sink.stats().delivered > stats->delivered) {
+        return 0;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return 1;
+  }
+
+  /**
+   * @brief Hands a frame to a sink dropping frames while busy and delivering
+   * them asynchronously, its delegate deleting the sink from the delivery thread.
+   *
+   * @return 0 once the delegate deleted the sink, 1 if it never ran.
+   */
+  EXPORT_API int DeleteSinkFromDelegateTest() {
+    const int width = 64, height = 32;
+    sink_deleted = false;
+
+    deleted_sink = new video_sink(deleting_delegate, ARGB8888);
+    deleted_sink->drop_if_busy(true);
+    deleted_sink->async_delivery(2, overflow_policy::drop_oldest);
+
+    uint8_t* buffer = deleted_sink->pool().acquire(width, height, pooled_i420_frame::size(width, height));
+    memset(buffer, 0x80, pooled_i420_frame::size(width, height));
+    deleted_sink->handle_frame(std::make_unique<pooled_i420_frame>(buffer, width, height, 0));
+
+    for (int i = 0; i < 1000 && !sink_deleted; i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Lets the detached delivery thread finish with the sink gone
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return sink_deleted ? 0 : 1;
+  }
+
+  /**
+   * @brief Writes frames filled with their frame number into a shared memory
+   * ring while a reader, with its own mapping, checks them in place.
+   *
+   * @param validated Receives the number of frames read and validated.
+   * @return The number of validated frames whose content was torn, or -1 if
+   * the ring could not be created or opened.
+   */
+  EXPORT_API int SharedMemoryRingTest(int slot_count, int frames, int* validated) {
+    const int width = 64, height = 32, stride = width * 4;
+    std::string name = "dolbyio_ring_test_" + std::to_string(slot_count);
+
+    std::unique_ptr<shm_frame_ring> writer, reader;
+    try {
+      writer = shm_frame_ring::create(name, slot_count, stride * height);
+      reader = shm_frame_ring::open(name);
+    } catch (const std::exception&) {
+      return -1;
+    }
+
+    std::atomic<bool> done{ false };
+    std::thread producer([&]() {
+      for (int i = 0; i < frames; i++) {
+        uint8_t* planes[3] = { writer->begin_write(stride * height), nullptr, nullptr };
+        int strides[3] = { stride, 0, 0 };
+        memset(planes[0], i & 0xFF, stride * height);
+        writer->end_write(width, height, 0, 1, planes, strides, stride * height, i * 1000);
+        std::this_thread::yield();
+      }
+      done = true;
+    });
+
+    int torn = 0;
+    *validated = 0;
+    int64_t last = -1;
+    while (!done || last < frames - 1) {
+      shm_frame_ring::shm_frame_info info;
+      const uint8_t* payload = reader->read_latest(last, info);
+      if (payload == nullptr) {
+        if (done && reader->read_latest(last, info) == nullptr) {
+          break;
+        }
+        continue;
+      }
+
+      const uint8_t* plane = payload + info.offsets[0];
+      bool uniform = info.timestamp_us == (int64_t)info.frame_number * 1000;
+      for (int i = 0; i < info.strides[0] * info.height; i++) {
+        uniform = uniform && plane[i] == (info.frame_number & 0xFF);
+      }
+
+      if (reader->validate(info)) {
+        (*validated)++;
+        if (!uniform) {
+          torn++;
+        }
+      }
+
+      last = (int64_t)info.frame_number;
+    }
+
+    producer.join();
+    return torn;
+  }
+
+  /**
+   * @brief Replaces a shared memory ring with a ring of the same name, the way
+   * a sink enabling the same ring again does, and opens it once the first
+   * ring was destroyed. On Windows, where the first segment lives on while
+   * mapped, the replacing ring must have the same layout.
+   *
+   * @return 0 on success, otherwise the number of the first failing check.
+   */
+  EXPORT_API int SharedMemoryRecreateTest() {
+    const std::string name = "dolbyio_ring_recreate_test";
+
+    std::unique_ptr<shm_frame_ring> writer, reader;
+#if defined(_WIN32)
+    const uint32_t slot_size = 1024;
+#else
+    const uint32_t slot_size = 2048;
+#endif
+
+    try {
+      auto previous = shm_frame_ring::create(name, 2, 1024);
+#if defined(_WIN32)
+      try {
+        shm_frame_ring::create(name, 3, 2048);
+        return 5;
+      } catch (const std::runtime_error&) {
+      }
+      writer = shm_frame_ring::create(name, 2, slot_size);
+#else
+      writer = shm_frame_ring::create(name, 3, slot_size);
+#endif
+    } catch (const std::exception&) {
+      return 1;
+    }
+
+    try {
+      reader = shm_frame_ring::open(name);
+    } catch (const std::exception&) {
+      return 2;
+    }
+
+    if (reader->slot_size() != slot_size) {
+      return 3;
+    }
+
+    uint8_t* planes[3] = { writer->begin_write(16), nullptr, nullptr };
+    int strides[3] = { 16, 0, 0 };
+    writer->end_write(4, 1, 0, 1, planes, strides, 16, 0);
+
+    shm_frame_ring::shm_frame_info info;
+    if (reader->read_latest(-1, info) == nullptr) {
+      return 4;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Publishes frames whose planes lie outside of their slot, the way a
+   * corrupted writer would, between two valid frames.
+   *
+   * @return 0 on success, otherwise the number of the first failing check.
+   */
+  EXPORT_API int SharedMemoryBoundsTest() {
+    const std::string name = "dolbyio_ring_bounds_test";
+
+    std::unique_ptr<shm_frame_ring> writer, reader;
+    try {
+      writer = shm_frame_ring::create(name, 2, 1024);
+      reader = shm_frame_ring::open(name);
+    } catch (const std::exception&) {
+      return 1;
+    }
+
+    auto publish = [&](size_t offset, int stride, int height, size_t size) {
+      uint8_t* payload = writer->begin_write(0);
+      uint8_t* planes[3] = { payload + offset, nullptr, nullptr };
+      int strides[3] = { stride, 0, 0 };
+      writer->end_write(stride, height, 0, 1, planes, strides, size, 0);
+    };
+
+    shm_frame_ring::shm_frame_info info;
+    publish(0, 16, 4, 64);
+    if (reader->read_latest(-1, info) == nullptr) {
+      return 2;
+    }
+
+    // Larger than a slot, plane past the frame, rows past the frame
+    publish(0, 16, 4, 4096);
+    publish(2048, 16, 1, 64);
+    publish(0, 1024, 2, 1024);
+    publish(0, -16, 4, 64);
+    if (reader->read_latest(info.frame_number, info) != nullptr) {
+      return 3;
+    }
+
+    publish(960, 16, 4, 1024);
+    if (reader->read_latest(-1, info) == nullptr || info.offsets[0] != 960) {
+      return 4;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Gets the size of the structs shared with C#: 0 for video_sink_frame,
+   * 1 for video_sink_frame_metadata, 2 for video_sink_stats and 3 for shm_frame_info.
+   */
+  EXPORT_API int VideoSinkStructSizeTest(int which) {
+    switch (which) {
+      case 0: return sizeof(video_sink_frame);
+      case 1: return sizeof(video_sink_frame_metadata);
+      case 2: return sizeof(video_sink_stats);
+      case 3: return sizeof(shm_frame_ring::shm_frame_info);
+      default: return -1;
+    }
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
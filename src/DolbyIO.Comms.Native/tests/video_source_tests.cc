@@ -0,0 +1,181 @@
+#include "../sdk.h"
+#include "../frame_buffer_pool.h"
+#include "../video_formats.h"
+#include "../video_frame_handler.h"
+#include "../video_sink.h"
+#include "../video_source.h"
+
+#include <cstring>
+#include <vector>
+
+namespace dolbyio::comms::native::tests {
+
+  // Stands for the SDK encoder, keeping the last frame tightly packed
+  class i420_capture_sink : public dolbyio::comms::video_sink {
+  public:
+    explicit i420_capture_sink(uint8_t* i420) : i420_(i420) {}
+
+    void handle_frame(std::unique_ptr<video_frame> frame) override {
+      timestamps.push_back(frame->timestamp_us());
+
+      int width = frame->width();
+      int height = frame->height();
+      int chroma_width = (width + 1) / 2;
+      int chroma_height = (height + 1) / 2;
+      auto i420 = frame->get_i420_frame();
+
+      uint8_t* u = i420_ + width * height;
+      uint8_t* v = u + chroma_width * chroma_height;
+      copy_plane(i420->get_y(), i420->stride_y(), i420_, width, width, height);
+      copy_plane(i420->get_u(), i420->stride_u(), u, chroma_width, chroma_width, chroma_height);
+      copy_plane(i420->get_v(), i420->stride_v(), v, chroma_width, chroma_width, chroma_height);
+    }
+
+    std::vector<int64_t> timestamps;
+
+  private:
+    uint8_t* i420_;
+  };
+
+  // Non owning frame, standing for the SDK handing a camera frame to the preview
+  class frame_view : public dolbyio::comms::video_frame {
+  public:
+    explicit frame_view(pooled_i420_frame& frame) : frame_(frame) {}
+
+    int width() const override { return frame_.width(); }
+    int height() const override { return frame_.height(); }
+    int64_t timestamp_us() const override { return frame_.timestamp_us(); }
+    dolbyio::comms::video_frame_i420* get_i420_frame() override { return frame_.get_i420_frame(); }
+
+#if defined(__APPLE__)
+    dolbyio::comms::video_frame_macos* get_native_frame() override { return nullptr; }
+#endif
+
+  private:
+    pooled_i420_frame& frame_;
+  };
+
+  // Last frame delivered to the preview sink
+  static video_sink_frame preview_frame;
+  static int preview_frames;
+
+  static void on_preview_frame(const video_sink_frame* frame, const video_sink_frame_metadata*) {
+    preview_frame = *frame;
+    preview_frame.buffer = nullptr;
+    preview_frames++;
+    frame_buffer_pool::release(frame->buffer);
+  }
+
+extern "C" {
+
+  /**
+   * @brief Pushes a frame to a source without a sink, then frames times to a
+   * source feeding a fake encoder, copying the last frame received into i420.
+   *
+   * @return The number of frames received with a timestamp other than the one pushed.
+   */
+  EXPORT_API int VideoSourceTest(int format, int width, int height, const uint8_t* data, int stride, int frames,
+                                 uint8_t* i420, video_source_stats* stats, frame_buffer_pool_stats* pool_stats) {
+    video_source source;
+    i420_capture_sink sink(i420);
+
+    source.push((pixel_format)format, width, height, data, stride, 0);
+    source.set_sink(&sink, dolbyio::comms::video_source::config{});
+
+    for (int i = 0; i < frames; i++) {
+      source.push((pixel_format)format, width, height, data, stride, 1000 + 16667 * (int64_t)i);
+    }
+
+    source.set_sink(nullptr, dolbyio::comms::video_source::config{});
+    *stats = source.stats();
+    *pool_stats = source.pool().stats();
+
+    int mismatches = frames - (int)sink.timestamps.size();
+    for (size_t i = 0; i < sink.timestamps.size(); i++) {
+      if (sink.timestamps[i] != 1000 + 16667 * (int64_t)i) {
+        mismatches++;
+      }
+    }
+
+    return mismatches;
+  }
+
+  /**
+   * @brief Hands frames times a 1280x720 camera frame to the sink of a handler,
+   * an ARGB8888 sink, with the given preview policy.
+   *
+   * @return The number of bytes of the camera frame modified by the preview.
+   */
+  EXPORT_API int PreviewTapTest(bool enabled, int format, int width, int height, double max_fps, int frames,
+                                video_sink_frame* last, int* delivered, video_sink_stats* stats) {
+    auto pool = frame_buffer_pool::create();
+    std::vector<uint8_t> reference(pooled_i420_frame::size(1280, 720));
+    for (size_t i = 0; i < reference.size(); i++) {
+      reference[i] = (uint8_t)(i * 7);
+    }
+
+    video_sink sink(&on_preview_frame);
+    video_frame_handler handler;
+    handler.sink(&sink);
+    handler.preview().policy(enabled, (pixel_format)format, width, height, max_fps);
+
+    preview_frames = 0;
+    int modified = 0;
+    for (int i = 0; i < frames; i++) {
+      uint8_t* buffer = pool->acquire(1280, 720, reference.size());
+      std::memcpy(buffer, reference.data(), reference.size());
+
+      // Kept aside, as the encoder would get it after the preview
+      pooled_i420_frame camera(buffer, 1280, 720, i);
+      handler.sink()->handle_frame(std::make_unique<frame_view>(camera));
+
+      for (size_t j = 0; j < reference.size(); j++) {
+        modified += buffer[j] != reference[j];
+      }
+    }
+
+    *last = preview_frame;
+    *delivered = preview_frames;
+    *stats = sink.stats();
+    return modified;
+  }
+
+  /**
+   * @brief Deletes frames the way the SDK does, through their video_frame base,
+   * checking that the next frame reuses the memory of the last one deleted.
+   *
+   * @return 0 if the frames were recycled, the number of the failing check otherwise.
+   */
+  EXPORT_API int PooledFrameRecycleTest() {
+    auto pool = frame_buffer_pool::create();
+    auto make_frame = [&](int64_t timestamp_us) {
+      return std::make_unique<pooled_i420_frame>(pool->acquire(16, 16, pooled_i420_frame::size(16, 16)), 16, 16, timestamp_us);
+    };
+
+    std::unique_ptr<dolbyio::comms::video_frame> frame = make_frame(0);
+    void* first = frame.get();
+    frame.reset();
+
+    frame = make_frame(1);
+    if (frame.get() != first) {
+      return 1;
+    }
+
+    // Past the free list, the frames go back to the heap
+    std::vector<std::unique_ptr<pooled_i420_frame>> frames;
+    for (size_t i = 0; i < 2 * pooled_i420_frame::max_free; i++) {
+      frames.push_back(make_frame(i));
+    }
+    frames.clear();
+    frame.reset();
+
+    frame = make_frame(2);
+    if (frame->timestamp_us() != 2 || pool->stats().outstanding != 1) {
+      return 2;
+    }
+
+    return 0;
+  }
+
+} // extern "C"
+} // namespace dolbyio::comms::native::tests
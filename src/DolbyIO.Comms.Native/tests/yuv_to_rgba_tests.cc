@@ -0,0 +1,130 @@
+#include "../sdk.h"
+#include "../yuv_to_rgba.h"
+
+#include <random>
+#include <vector>
+
+namespace dolbyio::comms::native::tests {
+extern "C" {
+
+  /**
+   * @brief Converts a random frame with every vectorized kernel available on this CPU
+   * and compares the result with the scalar reference converter.
+   *
+   * @param layout The chroma layout (0: I420, 1: NV12, 2: NV21).
+   * @param width The frame width.
+   * @param height The frame height.
+   * @param padding Extra bytes added to every plane stride.
+   * @param type The ycbcr_type matrix.
+   * @return The number of bytes that differ from the scalar output.
+   */
+  EXPORT_API int YuvToRgbaSimdTest(int layout, int width, int height, int padding, int type) {
+    auto chroma_layout = (yuv_chroma_layout)layout;
+    auto matrix = (ycbcr_type)type;
+
+    uint32_t y_stride = width + padding;
+    uint32_t uv_stride = (chroma_layout == yuv_chroma_layout::i420 ? (width + 1) / 2 : 2 * ((width + 1) / 2)) + padding;
+    uint32_t uv_height = (height + 1) / 2;
+    uint32_t rgb_stride = width * 4 + padding;
+
+    std::mt19937 rng(width * 31 + height * 17 + layout * 7 + type);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    std::vector<uint8_t> y_plane(y_stride * height);
+    std::vector<uint8_t> u_plane(uv_stride * uv_height);
+    std::vector<uint8_t> v_plane(uv_stride * uv_height);
+
+    for (auto& b : y_plane) b = dist(rng);
+    for (auto& b : u_plane) b = dist(rng);
+    for (auto& b : v_plane) b = dist(rng);
+
+    // Make sure the extremes of every plane are covered
+    if (!y_plane.empty()) { y_plane.front() = 0; y_plane.back() = 255; }
+    if (!u_plane.empty()) { u_plane.front() = 255; u_plane.back() = 0; }
+    if (!v_plane.empty()) { v_plane.front() = 0; v_plane.back() = 255; }
+
+    std::vector<uint8_t> reference(rgb_stride * height, 0x5A);
+    yuv_rgb24(yuv_simd::none, chroma_layout, width, height,
+      y_plane.data(), u_plane.data(), v_plane.data(), y_stride, uv_stride,
+      reference.data(), rgb_stride, matrix);
+
+    int mismatches = 0;
+    for (yuv_simd simd : { yuv_simd::sse2, yuv_simd::avx2, yuv_simd::neon }) {
+      if (!yuv_simd_supported(simd)) {
+        continue;
+      }
+
+      std::vector<uint8_t> result(rgb_stride * height, 0x5A);
+      yuv_rgb24(simd, chroma_layout, width, height,
+        y_plane.data(), u_plane.data(), v_plane.data(), y_stride, uv_stride,
+        result.data(), rgb_stride, matrix);
+
+      for (size_t i = 0; i < result.size(); i++) {
+        if (result[i] != reference[i]) {
+          mismatches++;
+        }
+      }
+    }
+
+    return mismatches;
+  }
+
+  /**
+   * @brief Converts a random frame to the given byte order with the scalar
+   * converter and every vectorized kernel available on this CPU, and compares
+   * every pixel with the ARGB8888 output of the scalar converter.
+   *
+   * @param order The rgb32_order (1: RGBA, 2: BGRA).
+   * @return The number of bytes that differ from the reordered ARGB8888 output.
+   */
+  EXPORT_API int YuvToRgbaOrderTest(int order, int layout, int width, int height) {
+    auto byte_order = (rgb32_order)order;
+    auto chroma_layout = (yuv_chroma_layout)layout;
+
+    uint32_t uv_stride = chroma_layout == yuv_chroma_layout::i420 ? (width + 1) / 2 : 2 * ((width + 1) / 2);
+    uint32_t uv_height = (height + 1) / 2;
+    uint32_t rgb_stride = width * 4;
+
+    std::mt19937 rng(width * 31 + height * 17 + layout * 7 + order);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    std::vector<uint8_t> y_plane(width * height);
+    std::vector<uint8_t> u_plane(uv_stride * uv_height);
+    std::vector<uint8_t> v_plane(uv_stride * uv_height);
+
+    for (auto& b : y_plane) b = dist(rng);
+    for (auto& b : u_plane) b = dist(rng);
+    for (auto& b : v_plane) b = dist(rng);
+
+    std::vector<uint8_t> argb(rgb_stride * height);
+    yuv_rgb24(yuv_simd::none, chroma_layout, width, height,
+      y_plane.data(), u_plane.data(), v_plane.data(), width, uv_stride,
+      argb.data(), rgb_stride, ycbcr_type::ycbcr_jpeg);
+
+    const rgb32_offsets& argb_offsets = rgb32_layouts[(int)rgb32_order::argb];
+    const rgb32_offsets& offsets = rgb32_layouts[order];
+
+    int mismatches = 0;
+    for (yuv_simd simd : { yuv_simd::none, yuv_simd::sse2, yuv_simd::avx2, yuv_simd::neon }) {
+      if (!yuv_simd_supported(simd)) {
+        continue;
+      }
+
+      std::vector<uint8_t> result(rgb_stride * height);
+      yuv_rgb24(simd, chroma_layout, width, height,
+        y_plane.data(), u_plane.data(), v_plane.data(), width, uv_stride,
+        result.data(), rgb_stride, ycbcr_type::ycbcr_jpeg, byte_order);
+
+      for (size_t i = 0; i < result.size(); i += 4) {
+        mismatches += result[i + offsets.a] != argb[i + argb_offsets.a];
+        mismatches += result[i + offsets.r] != argb[i + argb_offsets.r];
+        mismatches += result[i + offsets.g] != argb[i + argb_offsets.g];
+        mismatches += result[i + offsets.b] != argb[i + argb_offsets.b];
+      }
+    }
+
+    return mismatches;
+  }
+
+}
+} // namespace dolbyio::comms::native::tests
@@ -53,6 +53,70 @@ namespace dolbyio::comms::native {
     translator<F, T>::to_c(f, t);
   }
 
+  /**
+   * @brief Translates the payload of an event into the event arena of the
+   * calling thread, and releases it all when the scope ends.
+   *
+   * Create the scope in the event lambda, before translating, and keep it
+   * alive until the C# handler returned. Only the translations made through
+   * the scope use the arena: the SDK calls made by the handler itself still
+   * return malloc'ed memory, which the C# marshaller frees.
+   */
+  class event_scope {
+  public:
+    event_scope() : arena_(event_arena::local()), mark_(arena_.position()) {}
+
+    ~event_scope() {
+      arena_.rewind(mark_);
+    }
+
+    template<typename F, typename T> F* to_c(const T& t) {
+      static_assert(has_to_c_method<translator<F, T>>::value, "Implement to_c method");
+      activation active(arena_);
+      F* f = arena_.allocate<F>();
+      translator<F, T>::to_c(f, t);
+      return f;
+    }
+
+    template<typename F, typename T> void no_alloc_to_c(F* f, const T& t) {
+      activation active(arena_);
+      native::no_alloc_to_c(f, t);
+    }
+
+    char* strdup(const std::string& s) {
+      return arena_.strdup(s.c_str(), s.size());
+    }
+
+    char* strdup(const char* s) {
+      return arena_.strdup(s, strlen(s));
+    }
+
+    char* strdup(const char* s, size_t length) {
+      return arena_.strdup(s, length);
+    }
+
+    template<typename T> T* allocate(size_t count) {
+      return arena_.allocate<T>(count);
+    }
+
+  private:
+    // Routes the strdup calls of the translators to the arena
+    struct activation {
+      activation(event_arena& arena) : previous_(event_arena::active()) {
+        event_arena::active() = &arena;
+      }
+
+      ~activation() {
+        event_arena::active() = previous_;
+      }
+
+      event_arena* previous_;
+    };
+
+    event_arena&      arena_;
+    event_arena::mark mark_;
+  };
+
   template<typename F, typename T> void no_alloc_to_cpp(T& t, F* f) {
     static_assert(has_to_cpp_method<translator<F, T>>::value, "Implement to_c method");
     translator<F, T>::to_cpp(t, f);
@@ -1,15 +1,113 @@
 #ifndef _UTILS_H_
 #define _UTILS_H_
 
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+
 namespace dolbyio::comms::native {
 
-  extern std::string error;
+  /**
+   * @brief C# ErrorCode enum, the category of the last error.
+   */
+  enum class error_code : int {
+    none = 0,
+    unknown,                // Not an SDK exception
+    sdk,                    // dolbyio::comms::exception without a more specific category
+    io,
+    network,
+    signaling_channel,
+    invalid_token,
+    conference,
+    conference_state,
+    media_engine,
+    peer_connection_failed,
+    dvc,
+    security_check,
+    invalid_argument,
+  };
+
+  /**
+   * @brief Last error of the calling thread.
+   *
+   * Each thread keeps its own, so that exports called in parallel do not
+   * report each other's failures, and the message is copied into a fixed
+   * buffer, truncated if needed, so that failing does not allocate.
+   */
+  struct last_error {
+    static constexpr size_t max_message = 1024;
+
+    error_code code = error_code::none;
+    size_t     length = 0;
+    char       message[max_message] = {};
+
+    static last_error& current() {
+      static thread_local last_error error;
+      return error;
+    }
+
+    void set(error_code c, const char* what) {
+      code = c;
+      length = 0;
+      if (what) {
+        length = std::min(std::strlen(what), max_message - 1);
+        std::memcpy(message, what, length);
+      }
+      message[length] = '\0';
+    }
+
+    // The most derived categories come first
+    void set(const std::exception& e) {
+      if (dynamic_cast<const dolbyio::comms::signaling_channel_exception*>(&e)) {
+        set(error_code::signaling_channel, e.what());
+      } else if (dynamic_cast<const dolbyio::comms::invalid_token_exception*>(&e)) {
+        set(error_code::invalid_token, e.what());
+      } else if (dynamic_cast<const dolbyio::comms::network_exception*>(&e)) {
+        set(error_code::network, e.what());
+      } else if (dynamic_cast<const dolbyio::comms::io_exception*>(&e)) {
+        set(error_code::io, e.what());
+      } else if (dynamic_cast<const dolbyio::comms::conference_state_exception*>(&e)) {
+        set(error_code::conference_state, e.what());
+      } else if (dynamic_cast<const dolbyio::comms::conference_exception*>(&e)) {
+        set(error_code::conference, e.what());
+      } else if (dynamic_cast<const dolbyio::comms::peer_connection_failed_exception*>(&e)) {
+        set(error_code::peer_connection_failed, e.what());
+      } else if (dynamic_cast<const dolbyio::comms::media_engine_exception*>(&e)) {
+        set(error_code::media_engine, e.what());
+      } else if (dynamic_cast<const dolbyio::comms::dvc_exception*>(&e)) {
+        set(error_code::dvc, e.what());
+      } else if (dynamic_cast<const dolbyio::comms::security_check_exception*>(&e)) {
+        set(error_code::security_check, e.what());
+      } else if (dynamic_cast<const dolbyio::comms::exception*>(&e)) {
+        set(error_code::sdk, e.what());
+      } else if (dynamic_cast<const std::invalid_argument*>(&e)) {
+        set(error_code::invalid_argument, e.what());
+      } else {
+        set(error_code::unknown, e.what());
+      }
+    }
+
+    void set(std::exception_ptr e) {
+      try {
+        std::rethrow_exception(e);
+      } catch (const std::exception& ex) {
+        set(ex);
+      } catch (...) {
+        set(error_code::unknown, "Unknown error");
+      }
+    }
+  };
 
   template <typename E> constexpr auto to_underlying(E e) noexcept {
       return static_cast<std::underlying_type_t<E>>(e);
   }
 
+  // Copies into the event arena while an event is being translated, see event_scope
   static char* strdup(const std::string& s) {
+    if (event_arena* arena = event_arena::active()) {
+      return arena->strdup(s.c_str(), s.size());
+    }
     return std::strcpy((char*)malloc(s.size() + 1), s.c_str());
   }
 
@@ -31,7 +129,7 @@ namespace dolbyio::comms::native {
         f();
         result_ = result_success;
       } catch (const Exception& e) {
-        error = e.what();
+        last_error::current().set(e);
         result_ = result_error;
       }
 #else
@@ -17,6 +17,16 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int SetVideoSinkAsync(video_track track, video_sink* sink, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      dolbyio::comms::video_track cpp_track;
+      no_alloc_to_cpp(cpp_track, &track);
+
+      auto shared = std::shared_ptr<dolbyio::comms::native::video_sink>(sink, null_deleter{});
+      c.attach(sdk->video().remote().set_video_sink(cpp_track, shared));
+    }}.result();
+  }
+
     EXPORT_API int SetNullVideoSink(video_track track) {
       return call { [&]() {
         dolbyio::comms::video_track cpp_track;
@@ -37,12 +47,28 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int StartVideoAsync(video_device device, dolbyio::comms::native::video_frame_handler* handler, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      camera_device input;
+      no_alloc_to_cpp(input, &device);
+
+      auto shared = std::shared_ptr<dolbyio::comms::native::video_frame_handler>(handler, null_deleter{});
+      c.attach(sdk->video().local().start(input, shared));
+    }}.result();
+  }
+
   EXPORT_API int StopVideo() {
     return call { [&]() {
       wait(sdk->video().local().stop());
     }}.result();
   }
 
+  EXPORT_API int StopVideoAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->video().local().stop());
+    }}.result();
+  }
+
   EXPORT_API int StartScreenShare(dolbyio::comms::native::screen_share_source src, dolbyio::comms::native::video_frame_handler* handler) {
     return call { [&]() {
       dolbyio::comms::screen_share_source source;
@@ -53,11 +79,27 @@ extern "C" {
     }}.result();
   }
 
+  EXPORT_API int StartScreenShareAsync(dolbyio::comms::native::screen_share_source src, dolbyio::comms::native::video_frame_handler* handler, completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      dolbyio::comms::screen_share_source source;
+      no_alloc_to_cpp(source, &src);
+
+      auto shared = std::shared_ptr<dolbyio::comms::native::video_frame_handler>(handler, null_deleter{});
+      c.attach(sdk->conference().start_screen_share(source, shared));
+    }}.result();
+  }
+
   EXPORT_API int StopScreenShare() {
    return call { []() {
     wait(sdk->conference().stop_screen_share());
    }}.result(); 
   }
 
+  EXPORT_API int StopScreenShareAsync(completion_type done, std::intptr_t cookie) {
+    return async_call { done, cookie, [&](const completion& c) {
+      c.attach(sdk->conference().stop_screen_share());
+    }}.result();
+  }
+
 } // extern "C"
 } // namespace dolbyio::comms::native
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef _VIDEO_FORMATS_H_
+#define _VIDEO_FORMATS_H_
+
+#include <cstdint>
+#include <cstring>
+
+namespace dolbyio::comms::native {
+
+  enum pixel_format {
+    ARGB8888 = 0x00,
+    RGBA8888 = 0x01,
+    BGRA8888 = 0x02,
+    I420     = 0x03,
+    NV12     = 0x04,
+    Y8       = 0x05,
+  };
+
+  static bool is_valid_pixel_format(int format) {
+    return format >= ARGB8888 && format <= Y8;
+  }
+
+  /**
+   * @brief Gets the size of a plane of a tightly packed frame.
+   */
+  static void plane_size(pixel_format format, int width, int height, int plane, int& row_bytes, int& rows) {
+    int chroma_width = (width + 1) / 2;
+    int chroma_height = (height + 1) / 2;
+
+    switch (format) {
+      case ARGB8888:
+      case RGBA8888:
+      case BGRA8888:
+        row_bytes = width * 4;
+        rows = height;
+        break;
+      case I420:
+        row_bytes = plane == 0 ? width : chroma_width;
+        rows = plane == 0 ? height : chroma_height;
+        break;
+      case NV12:
+        row_bytes = plane == 0 ? width : 2 * chroma_width;
+        rows = plane == 0 ? height : chroma_height;
+        break;
+      default:
+        row_bytes = width;
+        rows = height;
+        break;
+    }
+  }
+
+  static void copy_plane(const uint8_t* src, uint32_t src_stride, uint8_t* dst, uint32_t dst_stride, uint32_t row_bytes, uint32_t rows) {
+    for (uint32_t y = 0; y < rows; y++) {
+      memcpy(dst + y * dst_stride, src + y * src_stride, row_bytes);
+    }
+  }
+
+  /**
+   * @brief Interleaves the U and V planes of an I420 frame into an NV12 chroma plane.
+   */
+  static void i420_to_nv12_chroma(
+    uint32_t chroma_width, uint32_t chroma_height,
+    const uint8_t* u_addr, const uint8_t* v_addr, uint32_t uv_stride,
+    uint8_t* dst, uint32_t dst_stride)
+  {
+    for (uint32_t y = 0; y < chroma_height; y++) {
+      const uint8_t* u_ptr = u_addr + y * uv_stride;
+      const uint8_t* v_ptr = v_addr + y * uv_stride;
+      uint8_t* dst_ptr = dst + y * dst_stride;
+      for (uint32_t x = 0; x < chroma_width; x++) {
+        dst_ptr[2 * x] = u_ptr[x];
+        dst_ptr[2 * x + 1] = v_ptr[x];
+      }
+    }
+  }
+
+  /**
+   * @brief Splits an NV12 chroma plane into the U and V planes of an I420 frame.
+   */
+  static void nv12_to_i420_chroma(
+    uint32_t chroma_width, uint32_t chroma_height,
+    const uint8_t* uv_addr, uint32_t uv_stride,
+    uint8_t* u_dst, uint8_t* v_dst, uint32_t dst_stride)
+  {
+    for (uint32_t y = 0; y < chroma_height; y++) {
+      const uint8_t* uv_ptr = uv_addr + y * uv_stride;
+      uint8_t* u_ptr = u_dst + y * dst_stride;
+      uint8_t* v_ptr = v_dst + y * dst_stride;
+      for (uint32_t x = 0; x < chroma_width; x++) {
+        u_ptr[x] = uv_ptr[2 * x];
+        v_ptr[x] = uv_ptr[2 * x + 1];
+      }
+    }
+  }
+
+} // namespace dolbyio::comms::native
+
+#endif // _VIDEO_FORMATS_H_
@@ -25,6 +25,72 @@ extern "C" {
 
     return call<>::result_error;
   }
-  
+
+  EXPORT_API int SetVideoFrameHandlerPreview(video_frame_handler* p, bool enabled, int format, int width, int height, double max_fps) {
+    if (p && is_valid_pixel_format(format) && width >= 0 && height >= 0 && max_fps >= 0) {
+      p->preview().policy(enabled, (pixel_format)format, width, height, max_fps);
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API int SetVideoFrameHandlerSource(video_frame_handler* p, video_source* source) {
+    if (p) {
+      p->source(source);
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API video_source* CreateVideoSource() {
+    return new video_source();
+  }
+
+  EXPORT_API bool DeleteVideoSource(video_source* source) {
+    if (source != nullptr) {
+      delete source;
+      return true;
+    }
+
+    return false;
+  }
+
+  EXPORT_API int PushVideoSourceFrame(video_source* source, int format, int width, int height, const uint8_t* data, int stride, int64_t timestamp_us) {
+    if (source != nullptr && is_valid_pixel_format(format) && source->push((pixel_format)format, width, height, data, stride, timestamp_us)) {
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API int SetVideoSourcePoolDepth(video_source* source, int depth) {
+    if (source != nullptr && depth >= 0) {
+      source->pool().max_depth(depth);
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API int GetVideoSourcePoolStats(video_source* source, frame_buffer_pool_stats* stats) {
+    if (source != nullptr && stats != nullptr) {
+      *stats = source->pool().stats();
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API int GetVideoSourceStats(video_source* source, video_source_stats* stats) {
+    if (source != nullptr && stats != nullptr) {
+      *stats = source->stats();
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
 } // extern "C"
 } // namespace dolbyio::comms::native
@@ -2,26 +2,95 @@
 #define _VIDEO_FRAME_HANDLER_H_
 
 #include "video_sink.h"
+#include "video_source.h"
 
 namespace dolbyio::comms::native {
 
+/**
+ * @brief Sink the SDK delivers the local camera frames to, which hands them to
+ * the application's video_sink with the preview policy of the handler.
+ *
+ * The policy only shapes the copy made for the preview: frames over its rate
+ * are dropped before any conversion, the others are scaled and converted in a
+ * single pass. The captured frame itself is never modified, and is encoded at
+ * its full size.
+ */
+class preview_tap : public dolbyio::comms::video_sink {
+  // The application's sink, the unqualified name being the SDK interface in this scope
+  using output_sink = dolbyio::comms::native::video_sink;
+
+public:
+  void sink(output_sink* sink) {
+    _sink = sink;
+  }
+
+  output_sink* sink() const {
+    return _sink;
+  }
+
+  /**
+   * @brief Sets the output of the preview, disabled to use the sink's own configuration.
+   */
+  void policy(bool enabled, pixel_format format, int width, int height, double max_fps) {
+    _limiter.max_fps(max_fps);
+    _format = format;
+    _target_size = output_sink::pack_size(width, height);
+    _enabled = enabled;
+  }
+
+  void handle_frame(std::unique_ptr<video_frame> frame) override {
+    output_sink* sink = _sink;
+    if (sink == nullptr) {
+      return;
+    }
+
+    if (!_enabled) {
+      sink->handle_frame(std::move(frame));
+      return;
+    }
+
+    sink->handle_frame(*frame, output_sink::frame_options{ _format, _target_size, &_limiter });
+  }
+
+private:
+  std::atomic<output_sink*>  _sink{ nullptr };
+  std::atomic<bool>          _enabled{ false };
+  std::atomic<pixel_format>  _format{ ARGB8888 };
+  std::atomic<uint32_t>      _target_size{ 0 };
+  frame_rate_limiter         _limiter;
+};
+
 class video_frame_handler : public dolbyio::comms::video_frame_handler {
 public:
   void sink(video_sink* sink) {
-    // Aliasing constructor
-    _sink = std::shared_ptr<dolbyio::comms::native::video_sink>(std::shared_ptr<dolbyio::comms::native::video_sink>{}, sink);
+    _tap.sink(sink);
   }
 
   virtual std::shared_ptr<dolbyio::comms::video_sink> sink() {
-    return _sink;
+    if (_tap.sink() == nullptr) {
+      return nullptr;
+    }
+
+    // Aliasing constructor
+    return std::shared_ptr<preview_tap>(std::shared_ptr<preview_tap>{}, &_tap);
+  }
+
+  preview_tap& preview() {
+    return _tap;
+  }
+
+  void source(video_source* source) {
+    // Aliasing constructor
+    _source = std::shared_ptr<dolbyio::comms::native::video_source>(std::shared_ptr<dolbyio::comms::native::video_source>{}, source);
   }
 
   virtual std::shared_ptr<dolbyio::comms::video_source> source() {
-    return nullptr;
+    return _source;
   }
 
 private:
-  std::shared_ptr<dolbyio::comms::native::video_sink> _sink;
+  preview_tap _tap;
+  std::shared_ptr<dolbyio::comms::native::video_source> _source;
 };
 
 } // namespace dolbyio::comms::native
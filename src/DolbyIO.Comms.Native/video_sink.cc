@@ -4,8 +4,20 @@
 namespace dolbyio::comms::native {
 extern "C" {
 
-  EXPORT_API video_sink* CreateVideoSink(video_sink::delegate_type delegate) {
-    return new video_sink(delegate);
+  EXPORT_API video_sink* CreateVideoSink(video_sink::delegate_type delegate, int format, int target_width, int target_height) {
+    if (!is_valid_pixel_format(format)) {
+      return nullptr;
+    }
+
+    return new video_sink(delegate, (pixel_format)format, target_width, target_height);
+  }
+
+  EXPORT_API video_sink* CreateVideoSinkWithMetadata(video_sink::metadata_delegate_type delegate, int format, int target_width, int target_height) {
+    if (!is_valid_pixel_format(format)) {
+      return nullptr;
+    }
+
+    return new video_sink(delegate, (pixel_format)format, target_width, target_height);
   }
 
   EXPORT_API bool DeleteVideoSink(video_sink* sink) {
@@ -18,13 +30,119 @@ extern "C" {
   }
 
   EXPORT_API bool DeleteVideoFrameBuffer(uint8_t* buffer) {
-    if (buffer != nullptr) {
-      free(buffer);
+    return frame_buffer_pool::release(buffer);
+  }
+
+  EXPORT_API int SetVideoSinkPoolDepth(video_sink* sink, int depth) {
+    if (sink != nullptr && depth >= 0) {
+      sink->pool().max_depth(depth);
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API int GetVideoSinkPoolStats(video_sink* sink, frame_buffer_pool_stats* stats) {
+    if (sink != nullptr && stats != nullptr) {
+      *stats = sink->pool().stats();
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API int SetVideoSinkTargetSize(video_sink* sink, int width, int height) {
+    if (sink != nullptr && width >= 0 && height >= 0) {
+      sink->target_size(width, height);
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API int SetVideoSinkMaxFrameRate(video_sink* sink, double max_fps) {
+    if (sink != nullptr && max_fps >= 0) {
+      sink->max_fps(max_fps);
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API int SetVideoSinkDropIfBusy(video_sink* sink, bool enabled) {
+    if (sink != nullptr) {
+      sink->drop_if_busy(enabled);
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API int SetVideoSinkAsyncDelivery(video_sink* sink, int depth, int policy) {
+    if (sink != nullptr && depth >= 0 && (policy == to_underlying(overflow_policy::drop_oldest) || policy == to_underlying(overflow_policy::drop_newest))) {
+      sink->async_delivery(depth, (overflow_policy)policy);
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API int SetVideoSinkSharedMemory(video_sink* sink, const char* name, int slot_count, int slot_size) {
+    return call { [&]() {
+      if (sink == nullptr || slot_count < 0 || slot_size < 0) {
+        throw std::invalid_argument("Invalid shared memory configuration");
+      }
+      sink->shared_memory(name ? name : "", slot_count, slot_size);
+    }}.result();
+  }
+
+  EXPORT_API shm_frame_ring* OpenVideoFrameRing(const char* name) {
+    shm_frame_ring* ring = nullptr;
+    call { [&]() {
+      ring = shm_frame_ring::open(name ? name : "").release();
+    }};
+    return ring;
+  }
+
+  EXPORT_API bool CloseVideoFrameRing(shm_frame_ring* ring) {
+    if (ring != nullptr) {
+      delete ring;
       return true;
     }
-    
+
     return false;
   }
 
+  EXPORT_API const uint8_t* ReadVideoFrameRing(shm_frame_ring* ring, int64_t after_frame_number, shm_frame_ring::shm_frame_info* info) {
+    if (ring != nullptr && info != nullptr) {
+      return ring->read_latest(after_frame_number, *info);
+    }
+
+    return nullptr;
+  }
+
+  EXPORT_API bool ValidateVideoFrameRing(shm_frame_ring* ring, shm_frame_ring::shm_frame_info* info) {
+    return ring != nullptr && info != nullptr && ring->validate(*info);
+  }
+
+  EXPORT_API int GetVideoSinkStats(video_sink* sink, video_sink_stats* stats) {
+    if (sink != nullptr && stats != nullptr) {
+      *stats = sink->stats();
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
+  EXPORT_API int SetVideoConversionThreading(int threads, int min_pixel_count) {
+    if (threads >= 0 && min_pixel_count >= 0) {
+      worker_pool::shared().threads(threads);
+      worker_pool::shared().min_pixel_count(min_pixel_count);
+      return call<>::result_success;
+    }
+
+    return call<>::result_error;
+  }
+
 } // extern "C"
 } // namespace dolbyio::comms::native
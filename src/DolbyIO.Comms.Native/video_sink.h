@@ -1,6 +1,8 @@
 #ifndef _VIDEO_SINK_H_
 #define _VIDEO_SINK_H_
 
+#include <atomic>
+#include <chrono>
 #include <cmath>
 
 #include "sdk.h"
@@ -9,6 +11,13 @@
 #include <dolbyio/comms/media_engine/video_utils.h>
 
 #include "yuv_to_rgba.h"
+#include "frame_buffer_pool.h"
+#include "frame_queue.h"
+#include "frame_rate_limiter.h"
+#include "shm_frame_ring.h"
+#include "worker_pool.h"
+#include "video_formats.h"
+#include "yuv_scale.h"
 
 #if defined(__APPLE__)
   #import <CoreVideo/CoreVideo.h>
@@ -18,101 +27,539 @@
 
 namespace dolbyio::comms::native {
 
-  enum pixel_format {
-    ARGB8888 = 0x00,
+  /**
+   * @brief C# NativeVideoFrame C struct.
+   */
+  struct video_sink_frame {
+    int      width;
+    int      height;
+    int      format;
+    int      plane_count;
+    uint8_t* planes[3];
+    int      strides[3];
+    uint8_t* buffer; // Pool buffer backing the planes, nullptr when they point into the decoded frame
+  };
+
+  /**
+   * @brief C# VideoFrameMetadata C struct, describing the decoded frame a
+   * video_sink_frame was produced from.
+   */
+  struct video_sink_frame_metadata {
+    int64_t  timestamp_us;    // Timestamp of the decoded frame
+    int64_t  received_us;     // Steady clock time at which the sink received the frame
+    uint64_t sequence_number; // Frames received by the sink before this one, dropped ones included
+    int32_t  rotation;        // Clockwise rotation in degrees, 0 as the C++ SDK hands frames over upright
+    int32_t  source_format;   // I420 or NV12
+    int32_t  source_width;
+    int32_t  source_height;
+    int32_t  source_strides[2]; // Luma and chroma strides of the decoded frame
+  };
+
+  /**
+   * @brief C# VideoSinkStatistics C struct.
+   */
+  struct video_sink_stats {
+    uint64_t delivered;
+    uint64_t dropped_rate;
+    uint64_t dropped_busy;
+    uint64_t dropped_queue;
   };
 
   class video_sink : public dolbyio::comms::video_sink {
   
   public:
-    using delegate_type = void (*)(int, int, uint8_t*);
+    using delegate_type = void (*)(const video_sink_frame*);
+    using metadata_delegate_type = void (*)(const video_sink_frame*, const video_sink_frame_metadata*);
+
+    /**
+     * @brief Output of a frame, overriding the sink's own configuration for the
+     * frames of a video_frame_handler preview policy.
+     */
+    struct frame_options {
+      pixel_format        format;
+      uint32_t            target_size; // As packed by pack_size()
+      frame_rate_limiter* limiter;
+    };
+
+    static uint32_t pack_size(int width, int height) {
+      return ((uint32_t)std::min(std::max(width, 0), 0xFFFF) << 16) | (uint32_t)std::min(std::max(height, 0), 0xFFFF);
+    }
 
-    video_sink(delegate_type delegate) {
+    video_sink(delegate_type delegate, pixel_format format = ARGB8888, int target_width = 0, int target_height = 0)
+      : pool_(frame_buffer_pool::create()) {
       delegate_ = delegate;
+      format_ = format;
+      target_size(target_width, target_height);
+    }
+
+    video_sink(metadata_delegate_type delegate, pixel_format format = ARGB8888, int target_width = 0, int target_height = 0)
+      : video_sink((delegate_type)nullptr, format, target_width, target_height) {
+      metadata_delegate_ = delegate;
+    }
+
+    /**
+     * @brief Sets the size the frames are downscaled to fit in, 0x0 to keep the decoded size.
+     */
+    void target_size(int width, int height) {
+      target_size_ = pack_size(width, height);
+    }
+
+    frame_buffer_pool& pool() {
+      return *pool_;
+    }
+
+    ~video_sink() {
+      std::atomic_store(&queue_, std::shared_ptr<delivery_queue<queued_frame>>());
+    }
+
+    /**
+     * @brief Writes the frames into a named shared memory ring instead of calling
+     * the delegate. An empty name goes back to the delegate.
+     *
+     * @throws std::runtime_error if the shared memory cannot be created.
+     */
+    void shared_memory(const std::string& name, uint32_t slot_count, uint32_t slot_size) {
+      std::shared_ptr<shm_frame_ring> ring;
+      if (!name.empty()) {
+        ring = shm_frame_ring::create(name, slot_count, slot_size);
+      }
+
+      std::atomic_store(&ring_, ring);
+    }
+
+    /**
+     * @brief Moves the delegate calls to a dedicated thread fed by a queue of the
+     * given depth, so that a slow delegate no longer holds the media thread.
+     * A depth of 0 calls the delegate synchronously.
+     *
+     * The delegate may delete the sink, so the delivery thread only touches the
+     * busy flag, which it co-owns, once the delegate returned.
+     */
+    void async_delivery(size_t depth, overflow_policy policy) {
+      std::shared_ptr<delivery_queue<queued_frame>> queue;
+      if (depth > 0) {
+        queue = std::make_shared<delivery_queue<queued_frame>>(depth, policy,
+          [this, busy = busy_](queued_frame& item) {
+            invoke(item.frame, item.metadata);
+            if (item.claimed) {
+              *busy = false;
+            }
+          },
+          [busy = busy_](queued_frame& item) {
+            frame_buffer_pool::release(item.frame.buffer);
+            if (item.claimed) {
+              *busy = false;
+            }
+          });
+      }
+
+      std::atomic_store(&queue_, queue);
+    }
+
+    /**
+     * @brief Sets the maximum number of frames per second delivered, 0 for no limit.
+     */
+    void max_fps(double fps) {
+      limiter_.max_fps(fps);
+    }
+
+    /**
+     * @brief When enabled, frames arriving while the delegate is still running
+     * are dropped before any conversion. With async delivery, the delegate runs
+     * until the queued frame has been delivered or discarded.
+     */
+    void drop_if_busy(bool enabled) {
+      drop_if_busy_ = enabled;
+    }
+
+    video_sink_stats stats() const {
+      return video_sink_stats{ delivered_, dropped_rate_, dropped_busy_, dropped_queue_ };
     }
 
     void handle_frame(std::unique_ptr<video_frame> frame) {
-      int bytes_per_pixel = 4;
-      size_t width, height = 0;
-      uint8_t* resbuffer = nullptr;
+      handle_frame(*frame, frame_options{ format_, target_size_.load(std::memory_order_relaxed), &limiter_ });
+    }
 
+    /**
+     * @brief Delivers a frame with the given output, leaving the frame untouched
+     * so that it can be forwarded afterwards.
+     */
+    void handle_frame(video_frame& frame, const frame_options& options) {
+      video_sink_frame_metadata metadata = {};
+      metadata.received_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+      metadata.sequence_number = sequence_number_++;
+
+      bool claimed = false;
+      if (drop_if_busy_) {
+        if (busy_->exchange(true)) {
+          dropped_busy_++;
+          return;
+        }
+        claimed = true;
+      }
+
+      if (options.limiter->admit(metadata.received_us)) {
+        convert(frame, metadata, options, claimed);
+      } else {
+        dropped_rate_++;
+      }
+
+      if (claimed) {
+        *busy_ = false;
+      }
+    }
+
+  private:
+    // claimed is cleared when the busy flag goes along with a queued frame
+    void convert(video_frame& frame, video_sink_frame_metadata& metadata, const frame_options& options, bool& claimed) {
 #if defined(__APPLE__)
-      video_frame_macos *mac_frame = frame->get_native_frame();
+      video_frame_macos *mac_frame = frame.get_native_frame();
       if (mac_frame) {
         CVPixelBufferRef buffer = mac_frame->get_buffer();
-        int res = CVPixelBufferLockBaseAddress(buffer, kCVPixelBufferLock_ReadOnly);
+        CVPixelBufferLockBaseAddress(buffer, kCVPixelBufferLock_ReadOnly);
 
         //Sanity check for ensuring we are capturing NV12 from camera
         auto format_type = CVPixelBufferGetPixelFormatType(buffer);
-        if (format_type != kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange &&
-            format_type != kCVPixelFormatType_420YpCbCr8BiPlanarFullRange)
-          return;
+        if (format_type == kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange ||
+            format_type == kCVPixelFormatType_420YpCbCr8BiPlanarFullRange) {
+          source_planes source;
+          source.layout = yuv_chroma_layout::nv12;
+          source.width = CVPixelBufferGetWidth(buffer);
+          source.height = CVPixelBufferGetHeight(buffer);
+          source.y = (const uint8_t*)CVPixelBufferGetBaseAddressOfPlane(buffer, 0);
+          source.u = (const uint8_t*)CVPixelBufferGetBaseAddressOfPlane(buffer, 1);
+          source.v = nullptr;
+          source.y_stride = CVPixelBufferGetBytesPerRowOfPlane(buffer, 0);
+          source.uv_stride = CVPixelBufferGetBytesPerRowOfPlane(buffer, 1);
+          source.timestamp_us = frame.timestamp_us();
 
-        width = CVPixelBufferGetWidth(buffer);
-        height = CVPixelBufferGetHeight(buffer);
+          deliver(source, metadata, options, claimed);
+        }
 
-        uint8_t *y_buffer = (uint8_t*)CVPixelBufferGetBaseAddressOfPlane(buffer, 0);
-        int y_stride = CVPixelBufferGetBytesPerRowOfPlane(buffer, 0);
+        CVPixelBufferUnlockBaseAddress(buffer, kCVPixelBufferLock_ReadOnly);
+        return;
+      }
+#endif
 
-        uint8_t *uv_buffer = (uint8_t*)CVPixelBufferGetBaseAddressOfPlane(buffer, 1);
-        int uv_stride = CVPixelBufferGetBytesPerRowOfPlane(buffer, 1);
+      auto frame_i420 = frame.get_i420_frame();
 
-        resbuffer = (uint8_t *)malloc(sizeof(uint8_t) * width * height * bytes_per_pixel);
+      source_planes source;
+      source.layout = yuv_chroma_layout::i420;
+      source.width = frame.width();
+      source.height = frame.height();
+      source.y = frame_i420->get_y();
+      source.u = frame_i420->get_u();
+      source.v = frame_i420->get_v();
+      source.y_stride = frame_i420->stride_y();
+      source.uv_stride = frame_i420->stride_u();
+      source.timestamp_us = frame.timestamp_us();
 
-        nv12_rgb24_std(
-          frame->width(),
-          frame->height(),
-          y_buffer,
-          uv_buffer,  
-          y_stride,
-          uv_stride,
-          resbuffer,
-          width * bytes_per_pixel,
-          ycbcr_type::ycbcr_jpeg);
+      deliver(source, metadata, options, claimed);
+    }
 
-        CVPixelBufferUnlockBaseAddress(buffer, kCVPixelBufferLock_ReadOnly);
-      } else {
-#endif
+    // Maps of the last downscale, built again when the decoded or fitted size changes
+    std::shared_ptr<const yuv_scale_maps> scale_maps(int src_width, int src_height, int width, int height) {
+      auto maps = std::atomic_load(&scale_maps_);
+      if (!maps || !maps->matches(src_width, src_height, width, height)) {
+        maps = std::make_shared<const yuv_scale_maps>(src_width, src_height, width, height);
+        std::atomic_store(&scale_maps_, maps);
+      }
 
-        auto frame_i420 = frame->get_i420_frame();
+      return maps;
+    }
 
-        width = frame->width();
-        height = frame->height();
+    struct source_planes {
+      yuv_chroma_layout layout;
+      int               width;
+      int               height;
+      const uint8_t*    y;
+      const uint8_t*    u; // Interleaved chroma plane for NV12
+      const uint8_t*    v;
+      int               y_stride;
+      int               uv_stride;
+      int64_t           timestamp_us;
+    };
 
-        resbuffer = (uint8_t *)malloc(sizeof(uint8_t) * width * height * bytes_per_pixel);
+    // Fills the planes of the output frame, converting only when the requested
+    // format or size differs from the decoded one. Passthrough planes are only
+    // valid until the delegate returns.
+    void deliver(const source_planes& source, video_sink_frame_metadata& metadata, const frame_options& options, bool& claimed) {
+      pixel_format format = options.format;
+      metadata.timestamp_us = source.timestamp_us;
+      metadata.rotation = 0;
+      metadata.source_format = source.layout == yuv_chroma_layout::nv12 ? NV12 : I420;
+      metadata.source_width = source.width;
+      metadata.source_height = source.height;
+      metadata.source_strides[0] = source.y_stride;
+      metadata.source_strides[1] = source.uv_stride;
 
-        const uint8_t* y_addr = frame_i420->get_y();
-        const uint8_t* u_addr = frame_i420->get_u();
-        const uint8_t* v_addr = frame_i420->get_v();
+      int width, height;
+      uint32_t target = options.target_size;
+      yuv_fit_size(source.width, source.height, target >> 16, target & 0xFFFF, width, height);
 
-        int y_stride = frame_i420->stride_y();
-        int u_stride = frame_i420->stride_u();
-        int v_stride = frame_i420->stride_v();
+      bool scaled = width != source.width || height != source.height;
+      std::shared_ptr<const yuv_scale_maps> maps;
+      if (scaled) {
+        maps = scale_maps(source.width, source.height, width, height);
+      }
 
-        yuv420_rgb24_std(
-          width,
-          height,
-          y_addr,
-          u_addr,
-          v_addr,
-          y_stride,
-          u_stride,
-          resbuffer,
-          width * bytes_per_pixel,
-          ycbcr_type::ycbcr_jpeg
-        );
+      int chroma_width = (width + 1) / 2;
+      int chroma_height = (height + 1) / 2;
 
-#if defined(__APPLE__)
+      auto ring = std::atomic_load(&ring_);
+
+      video_sink_frame out = {};
+      out.width = width;
+      out.height = height;
+      out.format = format;
+
+      switch (format) {
+        case ARGB8888:
+        case RGBA8888:
+        case BGRA8888: {
+          int bytes_per_pixel = 4;
+          out.buffer = acquire_buffer(ring.get(), width, height, sizeof(uint8_t) * width * height * bytes_per_pixel);
+          if (out.buffer == nullptr) {
+            dropped_queue_++;
+            return;
+          }
+
+          out.plane_count = 1;
+          out.planes[0] = out.buffer;
+          out.strides[0] = width * bytes_per_pixel;
+
+          worker_pool::shared().for_each_row_band(width, height, [&](int row_begin, int row_end) {
+            uint8_t* rgb = out.planes[0] + row_begin * out.strides[0];
+            if (scaled) {
+              yuv_scale_rgb24(
+                yuv_simd_detect(),
+                source.layout,
+                *maps,
+                source.y,
+                source.u,
+                source.v,
+                source.y_stride,
+                source.uv_stride,
+                row_begin,
+                row_end,
+                out.planes[0],
+                out.strides[0],
+                ycbcr_type::ycbcr_jpeg,
+                (rgb32_order)format
+              );
+            } else {
+              yuv_rgb24(
+                yuv_simd_detect(),
+                source.layout,
+                width,
+                row_end - row_begin,
+                source.y + row_begin * source.y_stride,
+                source.u + row_begin / 2 * source.uv_stride,
+                source.v ? source.v + row_begin / 2 * source.uv_stride : nullptr,
+                source.y_stride,
+                source.uv_stride,
+                rgb,
+                out.strides[0],
+                ycbcr_type::ycbcr_jpeg,
+                (rgb32_order)format
+              );
+            }
+          });
+          break;
+        }
+
+        case Y8:
+          out.plane_count = 1;
+          if (!scaled) {
+            out.planes[0] = const_cast<uint8_t*>(source.y);
+            out.strides[0] = source.y_stride;
+          } else {
+            out.buffer = acquire_buffer(ring.get(), width, height, width * height);
+            if (out.buffer == nullptr) {
+              dropped_queue_++;
+              return;
+            }
+
+            out.planes[0] = out.buffer;
+            out.strides[0] = width;
+
+            yuv_scale_planes(source.layout, *maps,
+              source.y, source.u, source.v, source.y_stride, source.uv_stride,
+              out.planes[0], nullptr, nullptr, width, 0);
+          }
+          break;
+
+        case I420:
+          out.plane_count = 3;
+          if (!scaled && source.layout == yuv_chroma_layout::i420) {
+            out.planes[0] = const_cast<uint8_t*>(source.y);
+            out.planes[1] = const_cast<uint8_t*>(source.u);
+            out.planes[2] = const_cast<uint8_t*>(source.v);
+            out.strides[0] = source.y_stride;
+            out.strides[1] = source.uv_stride;
+            out.strides[2] = source.uv_stride;
+          } else {
+            out.buffer = acquire_buffer(ring.get(), width, height, width * height + 2 * chroma_width * chroma_height);
+            if (out.buffer == nullptr) {
+              dropped_queue_++;
+              return;
+            }
+
+            out.planes[0] = out.buffer;
+            out.planes[1] = out.planes[0] + width * height;
+            out.planes[2] = out.planes[1] + chroma_width * chroma_height;
+            out.strides[0] = width;
+            out.strides[1] = chroma_width;
+            out.strides[2] = chroma_width;
+
+            if (scaled) {
+              yuv_scale_planes(source.layout, *maps,
+                source.y, source.u, source.v, source.y_stride, source.uv_stride,
+                out.planes[0], out.planes[1], out.planes[2], width, chroma_width);
+            } else {
+              copy_plane(source.y, source.y_stride, out.planes[0], width, width, height);
+              nv12_to_i420_chroma(chroma_width, chroma_height, source.u, source.uv_stride,
+                out.planes[1], out.planes[2], chroma_width);
+            }
+          }
+          break;
+
+        case NV12:
+          out.plane_count = 2;
+          if (!scaled && source.layout == yuv_chroma_layout::nv12) {
+            out.planes[0] = const_cast<uint8_t*>(source.y);
+            out.planes[1] = const_cast<uint8_t*>(source.u);
+            out.strides[0] = source.y_stride;
+            out.strides[1] = source.uv_stride;
+          } else {
+            out.buffer = acquire_buffer(ring.get(), width, height, width * height + 2 * chroma_width * chroma_height);
+            if (out.buffer == nullptr) {
+              dropped_queue_++;
+              return;
+            }
+
+            out.planes[0] = out.buffer;
+            out.planes[1] = out.planes[0] + width * height;
+            out.strides[0] = width;
+            out.strides[1] = 2 * chroma_width;
+
+            if (scaled) {
+              yuv_scale_planes(source.layout, *maps,
+                source.y, source.u, source.v, source.y_stride, source.uv_stride,
+                out.planes[0], out.planes[1], nullptr, width, 2 * chroma_width);
+            } else {
+              copy_plane(source.y, source.y_stride, out.planes[0], width, width, height);
+              i420_to_nv12_chroma(chroma_width, chroma_height, source.u, source.v, source.uv_stride,
+                out.planes[1], 2 * chroma_width);
+            }
+          }
+          break;
       }
-#endif
 
-      delegate_(width, height, resbuffer);
+      if (ring) {
+        if (out.buffer == nullptr && !own_planes(ring.get(), out)) {
+          dropped_queue_++;
+          return;
+        }
+
+        int row_bytes, rows;
+        size_t size = 0;
+        for (int i = 0; i < out.plane_count; i++) {
+          plane_size(format, width, height, i, row_bytes, rows);
+          size += (size_t)out.strides[i] * rows;
+        }
+
+        ring->end_write(out.width, out.height, out.format, out.plane_count, out.planes, out.strides, size, source.timestamp_us);
+        delivered_++;
+        return;
+      }
+
+      auto queue = std::atomic_load(&queue_);
+      if (queue) {
+        if (out.buffer == nullptr && !own_planes(nullptr, out)) {
+          dropped_queue_++;
+          return;
+        }
+
+        // The delivery thread releases the busy flag once the delegate returns
+        bool handed_off = claimed;
+        claimed = false;
+        if (queue->push(queued_frame{ out, metadata, handed_off })) {
+          dropped_queue_++;
+        }
+        return;
+      }
+
+      invoke(out, metadata);
     }
 
-  private:
+    void invoke(const video_sink_frame& frame, const video_sink_frame_metadata& metadata) {
+      delivered_++;
+      if (metadata_delegate_) {
+        metadata_delegate_(&frame, &metadata);
+      } else {
+        delegate_(&frame);
+      }
+    }
+
+    // Buffers come from the shared memory ring when enabled, from the pool otherwise
+    uint8_t* acquire_buffer(shm_frame_ring* ring, int width, int height, size_t size) {
+      if (ring) {
+        return ring->begin_write(size);
+      }
+      return pool_->acquire(width, height, size);
+    }
+
+    // Copies passthrough planes into a buffer of their own so that the frame outlives the decoded one
+    bool own_planes(shm_frame_ring* ring, video_sink_frame& frame) {
+      int row_bytes[3] = {}, rows[3] = {};
+      size_t size = 0;
+      for (int i = 0; i < frame.plane_count; i++) {
+        plane_size((pixel_format)frame.format, frame.width, frame.height, i, row_bytes[i], rows[i]);
+        size += row_bytes[i] * rows[i];
+      }
+
+      frame.buffer = acquire_buffer(ring, frame.width, frame.height, size);
+      if (frame.buffer == nullptr) {
+        return false;
+      }
+
+      uint8_t* dst = frame.buffer;
+      for (int i = 0; i < frame.plane_count; i++) {
+        copy_plane(frame.planes[i], frame.strides[i], dst, row_bytes[i], row_bytes[i], rows[i]);
+        frame.planes[i] = dst;
+        frame.strides[i] = row_bytes[i];
+        dst += row_bytes[i] * rows[i];
+      }
+
+      return true;
+    }
+
+    struct queued_frame {
+      video_sink_frame          frame;
+      video_sink_frame_metadata metadata;
+      bool                      claimed; // Holds the busy flag
+    };
+
     delegate_type delegate_;
+    metadata_delegate_type metadata_delegate_ = nullptr;
+    pixel_format format_;
+    std::atomic<uint32_t> target_size_; // Width in the high 16 bits, 0 when not scaling
+    std::shared_ptr<frame_buffer_pool> pool_;
+    frame_rate_limiter limiter_;
+    std::atomic<bool> drop_if_busy_{ false };
+    std::shared_ptr<std::atomic<bool>> busy_ = std::make_shared<std::atomic<bool>>(false); // Shared with the delivery thread
+    std::atomic<uint64_t> delivered_{ 0 };
+    std::atomic<uint64_t> dropped_rate_{ 0 };
+    std::atomic<uint64_t> dropped_busy_{ 0 };
+    std::atomic<uint64_t> dropped_queue_{ 0 };
+    std::atomic<uint64_t> sequence_number_{ 0 };
+    std::shared_ptr<delivery_queue<queued_frame>> queue_;
+    std::shared_ptr<shm_frame_ring> ring_;
+    std::shared_ptr<const yuv_scale_maps> scale_maps_;
   };
 
 } // namespace dolbyio::comms::native
 
-#endif // _VIDEO_SINK_H_
\ No newline at end of file
+#endif // _VIDEO_SINK_H_
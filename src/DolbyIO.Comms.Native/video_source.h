@@ -0,0 +1,286 @@
+#ifndef _VIDEO_SOURCE_H_
+#define _VIDEO_SOURCE_H_
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "sdk.h"
+
+#include "frame_buffer_pool.h"
+#include "frame_rate_limiter.h"
+#include "rgba_to_yuv.h"
+#include "video_formats.h"
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief C# VideoSourceStatistics C struct.
+   */
+  struct video_source_stats {
+    uint64_t pushed;       // Frames pushed by the application
+    uint64_t delivered;    // Frames handed to the SDK
+    uint64_t dropped;      // Frames pushed with no SDK sink attached or over its frame rate
+  };
+
+  /**
+   * @brief I420 frame backed by a buffer of a frame_buffer_pool, returned to the
+   * pool once the SDK is done with the frame.
+   *
+   * The frames themselves are recycled through a free list of up to max_free
+   * frames, so that pushing a frame does not allocate once the list filled up.
+   */
+  class pooled_i420_frame : public dolbyio::comms::video_frame, public dolbyio::comms::video_frame_i420 {
+  public:
+    static constexpr size_t max_free = 8;
+
+    pooled_i420_frame(uint8_t* buffer, int width, int height, int64_t timestamp_us)
+      : buffer_(buffer), width_(width), height_(height), timestamp_us_(timestamp_us) {}
+
+    ~pooled_i420_frame() {
+      frame_buffer_pool::release(buffer_);
+    }
+
+    static void* operator new(size_t size) {
+      if (size == sizeof(pooled_i420_frame)) {
+        auto& list = free_list::instance();
+        std::lock_guard<std::mutex> lock(list.mutex);
+        if (!list.frames.empty()) {
+          void* p = list.frames.back();
+          list.frames.pop_back();
+          return p;
+        }
+      }
+
+      return ::operator new(size);
+    }
+
+    static void operator delete(void* p, size_t size) noexcept {
+      if (p != nullptr && size == sizeof(pooled_i420_frame)) {
+        auto& list = free_list::instance();
+        std::lock_guard<std::mutex> lock(list.mutex);
+        if (list.frames.size() < max_free) {
+          list.frames.push_back(p);
+          return;
+        }
+      }
+
+      ::operator delete(p);
+    }
+
+    // Bytes of a frame, the planes being tightly packed one after the other
+    static size_t size(int width, int height) {
+      return (size_t)width * height + 2 * (size_t)((width + 1) / 2) * ((height + 1) / 2);
+    }
+
+    uint8_t* y() { return buffer_; }
+    uint8_t* u() { return buffer_ + (size_t)width_ * height_; }
+    uint8_t* v() { return u() + (size_t)stride_u() * ((height_ + 1) / 2); }
+
+    int width() const override { return width_; }
+    int height() const override { return height_; }
+    int64_t timestamp_us() const override { return timestamp_us_; }
+    dolbyio::comms::video_frame_i420* get_i420_frame() override { return this; }
+
+#if defined(__APPLE__)
+    dolbyio::comms::video_frame_macos* get_native_frame() override { return nullptr; }
+#endif
+
+    const uint8_t* get_y() const override { return buffer_; }
+    const uint8_t* get_u() const override { return buffer_ + (size_t)width_ * height_; }
+    const uint8_t* get_v() const override { return get_u() + (size_t)stride_u() * ((height_ + 1) / 2); }
+    int stride_y() const override { return width_; }
+    int stride_u() const override { return (width_ + 1) / 2; }
+    int stride_v() const override { return (width_ + 1) / 2; }
+
+  private:
+    struct free_list {
+      free_list() {
+        frames.reserve(max_free);
+      }
+
+      ~free_list() {
+        for (void* p : frames) {
+          ::operator delete(p);
+        }
+      }
+
+      static free_list& instance() {
+        static free_list list;
+        return list;
+      }
+
+      std::mutex         mutex;
+      std::vector<void*> frames;
+    };
+
+    uint8_t* buffer_;
+    int      width_;
+    int      height_;
+    int64_t  timestamp_us_;
+  };
+
+  /**
+   * @brief Video source fed by the application, which the SDK encodes in place
+   * of a camera when set on the video_frame_handler passed to local video start.
+   *
+   * Frames are pushed as a single buffer: packed 32 bit pixels, or the planes
+   * one after the other for I420 (chroma rows of half the luma stride) and NV12
+   * (chroma rows of the luma stride). They are converted, or copied, into
+   * pooled I420 buffers and handed to the SDK with their own timestamps.
+   */
+  class video_source : public dolbyio::comms::video_source {
+  public:
+    video_source()
+      : pool_(frame_buffer_pool::create()) {}
+
+    void set_sink(dolbyio::comms::video_sink* sink, const config& config) override {
+      std::lock_guard<std::mutex> lock(mutex_);
+      sink_ = sink;
+      black_frames_ = config.black_frames;
+      limiter_.max_fps(config.max_framerate_fps);
+    }
+
+    frame_buffer_pool& pool() {
+      return *pool_;
+    }
+
+    /**
+     * @brief Gets the size of the buffer holding a frame pushed with the given stride.
+     *
+     * @return 0 if the format cannot be pushed or the stride is too small.
+     */
+    static size_t frame_size(pixel_format format, int width, int height, int stride) {
+      int row_bytes, rows;
+      if (width <= 0 || height <= 0 || format == Y8 || !is_valid_pixel_format(format)) {
+        return 0;
+      }
+
+      // The NV12 chroma rows of an odd width are one byte longer than the luma rows
+      plane_size(format, width, height, format == NV12 ? 1 : 0, row_bytes, rows);
+      if (stride < row_bytes || stride < width) {
+        return 0;
+      }
+
+      size_t luma = (size_t)stride * height;
+      size_t chroma_rows = (height + 1) / 2;
+      switch (format) {
+        case I420: return luma + 2 * chroma_rows * ((stride + 1) / 2);
+        case NV12: return luma + chroma_rows * stride;
+        default:   return luma;
+      }
+    }
+
+    /**
+     * @brief Converts a frame and hands it to the SDK.
+     *
+     * @return false if the frame is invalid, true when it was delivered or
+     * dropped for lack of a sink.
+     */
+    bool push(pixel_format format, int width, int height, const uint8_t* data, int stride, int64_t timestamp_us) {
+      if (data == nullptr || frame_size(format, width, height, stride) == 0) {
+        return false;
+      }
+
+      stats_.pushed.fetch_add(1, std::memory_order_relaxed);
+
+      // Checked before converting, and again when delivering in case the sink went away meanwhile
+      bool black_frames;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (sink_ == nullptr || !limiter_.admit()) {
+          stats_.dropped.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+        black_frames = black_frames_;
+      }
+
+      uint8_t* buffer = pool_->acquire(width, height, pooled_i420_frame::size(width, height));
+      if (buffer == nullptr) {
+        stats_.dropped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+
+      auto frame = std::make_unique<pooled_i420_frame>(buffer, width, height, timestamp_us);
+      if (black_frames) {
+        fill_black(*frame);
+      } else {
+        convert(format, data, stride, *frame);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (sink_ == nullptr) {
+        stats_.dropped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+
+      sink_->handle_frame(std::move(frame));
+      stats_.delivered.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    video_source_stats stats() const {
+      return video_source_stats{
+        stats_.pushed.load(std::memory_order_relaxed),
+        stats_.delivered.load(std::memory_order_relaxed),
+        stats_.dropped.load(std::memory_order_relaxed)
+      };
+    }
+
+  private:
+    static void convert(pixel_format format, const uint8_t* data, int stride, pooled_i420_frame& frame) {
+      uint32_t width = frame.width();
+      uint32_t height = frame.height();
+      uint32_t chroma_width = (width + 1) / 2;
+      uint32_t chroma_height = (height + 1) / 2;
+
+      switch (format) {
+        case I420: {
+          uint32_t chroma_stride = (stride + 1) / 2;
+          const uint8_t* u = data + (size_t)stride * height;
+          const uint8_t* v = u + (size_t)chroma_stride * chroma_height;
+          copy_plane(data, stride, frame.y(), frame.stride_y(), width, height);
+          copy_plane(u, chroma_stride, frame.u(), frame.stride_u(), chroma_width, chroma_height);
+          copy_plane(v, chroma_stride, frame.v(), frame.stride_v(), chroma_width, chroma_height);
+          break;
+        }
+        case NV12:
+          copy_plane(data, stride, frame.y(), frame.stride_y(), width, height);
+          nv12_to_i420_chroma(chroma_width, chroma_height, data + (size_t)stride * height, stride,
+            frame.u(), frame.v(), frame.stride_u());
+          break;
+        default:
+          // BT.601 limited range, which the encoders expect
+          rgb32_i420((rgb32_order)format, width, height, data, stride,
+            frame.y(), frame.u(), frame.v(), frame.stride_y(), frame.stride_u(), ycbcr_type::ycbcr_601);
+          break;
+      }
+    }
+
+    static void fill_black(pooled_i420_frame& frame) {
+      size_t luma = (size_t)frame.width() * frame.height();
+      std::memset(frame.y(), 16, luma);
+      std::memset(frame.u(), 128, pooled_i420_frame::size(frame.width(), frame.height()) - luma);
+    }
+
+    struct counters {
+      std::atomic<uint64_t> pushed{ 0 };
+      std::atomic<uint64_t> delivered{ 0 };
+      std::atomic<uint64_t> dropped{ 0 };
+    };
+
+    std::shared_ptr<frame_buffer_pool> pool_;
+
+    std::mutex                         mutex_;
+    dolbyio::comms::video_sink*        sink_ = nullptr;
+    bool                               black_frames_ = false;
+    frame_rate_limiter                 limiter_;
+    counters                           stats_;
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _VIDEO_SOURCE_H_
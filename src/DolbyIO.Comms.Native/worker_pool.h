@@ -0,0 +1,199 @@
+#ifndef _WORKER_POOL_H_
+#define _WORKER_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Small pool of worker threads shared by all the video sinks.
+   *
+   * The thread calling run() takes part in the work, so a job always completes
+   * even if the pool has no thread or is being resized.
+   */
+  class worker_pool {
+    struct job {
+      std::function<void(int)> task;
+      int                      count;
+      std::atomic<int>         next{ 0 };
+      std::atomic<int>         done{ 0 };
+      std::mutex               mutex;
+      std::condition_variable  finished;
+
+      // Claims and runs task indices until none is left.
+      void work() {
+        int index;
+        while ((index = next.fetch_add(1)) < count) {
+          task(index);
+          if (done.fetch_add(1) + 1 == count) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.notify_all();
+          }
+        }
+      }
+    };
+
+  public:
+    static constexpr size_t default_min_pixel_count = 2560 * 1440;
+    static constexpr int    max_threads = 16;
+
+    static worker_pool& shared() {
+      static worker_pool pool;
+      return pool;
+    }
+
+    ~worker_pool() {
+      stop();
+    }
+
+    /**
+     * @brief Sets the number of worker threads, 0 disables the parallel conversion.
+     */
+    void threads(int count) {
+      std::lock_guard<std::mutex> config(config_mutex_);
+      count = std::clamp(count, 0, max_threads);
+      if (count == threads_) {
+        return;
+      }
+
+      stop();
+      threads_ = count;
+    }
+
+    int threads() {
+      std::lock_guard<std::mutex> config(config_mutex_);
+      return threads_;
+    }
+
+    /**
+     * @brief Sets the number of pixels from which a frame is split across the workers.
+     */
+    void min_pixel_count(size_t count) {
+      min_pixel_count_ = count;
+    }
+
+    size_t min_pixel_count() const {
+      return min_pixel_count_;
+    }
+
+    /**
+     * @brief Calls f(row_begin, row_end) on bands of rows covering [0, height).
+     *
+     * Frames smaller than min_pixel_count are processed on the calling thread.
+     * Every band but the last starts and ends on an even row so that the chroma
+     * rows of 4:2:0 frames are never shared between two bands.
+     */
+    template<typename F>
+    void for_each_row_band(int width, int height, F&& f) {
+      int workers = ensure_started();
+      int bands = std::min(workers + 1, height / min_band_height);
+
+      if (bands < 2 || (size_t)width * height < min_pixel_count_) {
+        f(0, height);
+        return;
+      }
+
+      int band_height = ((height + bands - 1) / bands + 1) & ~1;
+      bands = (height + band_height - 1) / band_height;
+
+      run(bands, [&](int band) {
+        int row_begin = band * band_height;
+        f(row_begin, std::min(row_begin + band_height, height));
+      });
+    }
+
+  private:
+    static constexpr int min_band_height = 16;
+
+    worker_pool() {
+      threads_ = std::min<int>(std::thread::hardware_concurrency() / 2, 4);
+    }
+
+    int ensure_started() {
+      std::lock_guard<std::mutex> config(config_mutex_);
+      if (workers_.empty() && threads_ > 0) {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          stopping_ = false;
+        }
+
+        for (int i = 0; i < threads_; i++) {
+          workers_.emplace_back([this]() { worker_loop(); });
+        }
+      }
+      return (int)workers_.size();
+    }
+
+    // Must be called with config_mutex_ held.
+    void stop() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+      }
+      wakeup_.notify_all();
+
+      for (auto& worker : workers_) {
+        worker.join();
+      }
+      workers_.clear();
+    }
+
+    void run(int count, std::function<void(int)> task) {
+      auto current = std::make_shared<job>();
+      current->task = std::move(task);
+      current->count = count;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(current);
+      }
+      wakeup_.notify_all();
+
+      current->work();
+
+      std::unique_lock<std::mutex> lock(current->mutex);
+      current->finished.wait(lock, [&]() { return current->done.load() == current->count; });
+    }
+
+    void worker_loop() {
+      while (true) {
+        std::shared_ptr<job> current;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          wakeup_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+          if (stopping_) {
+            return;
+          }
+
+          current = jobs_.front();
+          if (current->next.load() >= current->count - 1) {
+            jobs_.pop_front();
+          }
+        }
+
+        current->work();
+      }
+    }
+
+    std::mutex                        config_mutex_;
+    std::vector<std::thread>          workers_;
+    int                               threads_ = 0;
+    std::atomic<size_t>               min_pixel_count_{ default_min_pixel_count };
+
+    std::mutex                        mutex_;
+    std::condition_variable           wakeup_;
+    std::deque<std::shared_ptr<job>>  jobs_;
+    bool                              stopping_ = false;
+  };
+
+} // namespace dolbyio::comms::native
+
+#endif // _WORKER_POOL_H_
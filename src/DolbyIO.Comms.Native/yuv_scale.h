@@ -0,0 +1,189 @@
+#ifndef _YUV_SCALE_H_
+#define _YUV_SCALE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "yuv_to_rgba.h"
+
+namespace dolbyio::comms::native {
+
+  /**
+   * @brief Computes the largest even size fitting in max_width x max_height
+   * with the aspect ratio of the source. Frames are never upscaled, and a
+   * zero maximum keeps the source size.
+   */
+  static void yuv_fit_size(int src_width, int src_height, int max_width, int max_height, int& width, int& height) {
+    width = src_width;
+    height = src_height;
+
+    if (max_width <= 0 || max_height <= 0 || (src_width <= max_width && src_height <= max_height)) {
+      return;
+    }
+
+    if ((int64_t)max_width * src_height <= (int64_t)max_height * src_width) {
+      width = max_width;
+      height = (int)((int64_t)src_height * max_width / src_width);
+    } else {
+      height = max_height;
+      width = (int)((int64_t)src_width * max_height / src_height);
+    }
+
+    width = std::max(2, width & ~1);
+    height = std::max(2, height & ~1);
+  }
+
+  // Nearest source index sampled by each destination index
+  static void yuv_scale_map(uint32_t src_size, uint32_t dst_size, std::vector<uint32_t>& map) {
+    map.resize(dst_size);
+    for (uint32_t i = 0; i < dst_size; i++) {
+      uint64_t center = 2 * (uint64_t)i + 1;
+      map[i] = std::min<uint32_t>((uint32_t)(center * src_size / (2 * (uint64_t)dst_size)), src_size - 1);
+    }
+  }
+
+  /**
+   * @brief Source columns and rows sampled by a downscale from one size to
+   * another, computed once and kept for as long as both sizes stay the same.
+   * The chroma sample of a pair of columns or rows is the one of the first.
+   */
+  struct yuv_scale_maps {
+    yuv_scale_maps(uint32_t src_width, uint32_t src_height, uint32_t dst_width, uint32_t dst_height)
+      : src_width(src_width), src_height(src_height), dst_width(dst_width), dst_height(dst_height) {
+      yuv_scale_map(src_width, dst_width, x_map);
+      yuv_scale_map(src_height, dst_height, y_map);
+    }
+
+    bool matches(uint32_t src_w, uint32_t src_h, uint32_t dst_w, uint32_t dst_h) const {
+      return src_w == src_width && src_h == src_height && dst_w == dst_width && dst_h == dst_height;
+    }
+
+    uint32_t              src_width, src_height;
+    uint32_t              dst_width, dst_height;
+    std::vector<uint32_t> x_map, y_map;
+  };
+
+  /**
+   * @brief Nearest neighbour downscale fused with the conversion to 32 bit pixels of the given byte order.
+   *
+   * Every pair of destination rows is gathered from the source planes into a
+   * small scratch buffer, kept per thread, which is converted right away by
+   * the vectorized kernel, so no intermediate frame is ever written. Only the
+   * destination rows [row_begin, row_end) are produced, row_begin being even.
+   * For NV12 and NV21 u_addr points to the interleaved chroma plane and v_addr
+   * is ignored.
+   */
+  static void yuv_scale_rgb24(
+    yuv_simd simd, yuv_chroma_layout layout, const yuv_scale_maps& maps,
+    const uint8_t* y_addr, const uint8_t* u_addr, const uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+    uint32_t row_begin, uint32_t row_end,
+    uint8_t* rgb, uint32_t rgb_stride,
+    ycbcr_type yuv_type, rgb32_order order = rgb32_order::argb)
+  {
+    const auto& x_map = maps.x_map;
+    const auto& y_map = maps.y_map;
+    uint32_t dst_width = maps.dst_width;
+    uint32_t chroma_width = (dst_width + 1) / 2;
+    bool planar = layout == yuv_chroma_layout::i420;
+
+    uint32_t scratch_uv_stride = planar ? chroma_width : 2 * chroma_width;
+    size_t scratch_size = 2 * dst_width + 2 * scratch_uv_stride;
+    thread_local std::vector<uint8_t> scratch;
+    if (scratch.size() < scratch_size) {
+      scratch.resize(scratch_size);
+    }
+
+    uint8_t* scratch_y = scratch.data();
+    uint8_t* scratch_u = scratch_y + 2 * dst_width;
+    uint8_t* scratch_v = scratch_u + scratch_uv_stride;
+
+    for (uint32_t y = row_begin; y + 1 < row_end; y += 2) {
+      uint32_t src_y1 = y_map[y];
+      uint32_t src_y2 = y_map[y + 1];
+
+      const uint8_t* y_row1 = y_addr + src_y1 * y_stride;
+      const uint8_t* y_row2 = y_addr + src_y2 * y_stride;
+      for (uint32_t x = 0; x < dst_width; x++) {
+        scratch_y[x] = y_row1[x_map[x]];
+        scratch_y[dst_width + x] = y_row2[x_map[x]];
+      }
+
+      uint32_t src_chroma_y = src_y1 / 2;
+      if (planar) {
+        const uint8_t* u_row = u_addr + src_chroma_y * uv_stride;
+        const uint8_t* v_row = v_addr + src_chroma_y * uv_stride;
+        for (uint32_t x = 0; x < chroma_width; x++) {
+          scratch_u[x] = u_row[x_map[2 * x] / 2];
+          scratch_v[x] = v_row[x_map[2 * x] / 2];
+        }
+      } else {
+        const uint8_t* uv_row = u_addr + src_chroma_y * uv_stride;
+        for (uint32_t x = 0; x < chroma_width; x++) {
+          uint32_t offset = x_map[2 * x] & ~1u;
+          scratch_u[2 * x] = uv_row[offset];
+          scratch_u[2 * x + 1] = uv_row[offset + 1];
+        }
+      }
+
+      yuv_rgb24(simd, layout, dst_width, 2,
+        scratch_y, scratch_u, scratch_v, dst_width, scratch_uv_stride,
+        rgb + y * rgb_stride, rgb_stride, yuv_type, order);
+    }
+  }
+
+  /**
+   * @brief Nearest neighbour downscale of an I420 or NV12 frame into I420 (u_dst and
+   * v_dst), NV12 (u_dst only) or luma only (no chroma destination).
+   */
+  static void yuv_scale_planes(
+    yuv_chroma_layout layout, const yuv_scale_maps& maps,
+    const uint8_t* y_addr, const uint8_t* u_addr, const uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+    uint8_t* y_dst, uint8_t* u_dst, uint8_t* v_dst, uint32_t dst_y_stride, uint32_t dst_uv_stride)
+  {
+    const auto& x_map = maps.x_map;
+    const auto& y_map = maps.y_map;
+    uint32_t dst_width = maps.dst_width;
+    uint32_t dst_height = maps.dst_height;
+
+    for (uint32_t y = 0; y < dst_height; y++) {
+      const uint8_t* src_row = y_addr + y_map[y] * y_stride;
+      uint8_t* dst_row = y_dst + y * dst_y_stride;
+      for (uint32_t x = 0; x < dst_width; x++) {
+        dst_row[x] = src_row[x_map[x]];
+      }
+    }
+
+    if (u_dst == nullptr) {
+      return;
+    }
+
+    uint32_t chroma_width = (dst_width + 1) / 2;
+    uint32_t chroma_height = (dst_height + 1) / 2;
+    bool planar = layout == yuv_chroma_layout::i420;
+
+    for (uint32_t y = 0; y < chroma_height; y++) {
+      uint32_t src_y = y_map[2 * y] / 2;
+      const uint8_t* u_row = u_addr + src_y * uv_stride;
+      const uint8_t* v_row = planar ? v_addr + src_y * uv_stride : u_row + 1;
+      uint32_t step = planar ? 1 : 2;
+
+      for (uint32_t x = 0; x < chroma_width; x++) {
+        uint32_t offset = x_map[2 * x] / 2 * step;
+        uint8_t u = u_row[offset];
+        uint8_t v = v_row[offset];
+
+        if (v_dst != nullptr) {
+          u_dst[y * dst_uv_stride + x] = u;
+          v_dst[y * dst_uv_stride + x] = v;
+        } else {
+          u_dst[y * dst_uv_stride + 2 * x] = u;
+          u_dst[y * dst_uv_stride + 2 * x + 1] = v;
+        }
+      }
+    }
+  }
+
+} // namespace dolbyio::comms::native
+
+#endif // _YUV_SCALE_H_
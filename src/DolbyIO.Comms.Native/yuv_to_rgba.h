@@ -29,7 +29,11 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#ifndef _YUV_TO_RGBA_H_
+#define _YUV_TO_RGBA_H_
+
 #include <cstdint>
+#include <initializer_list>
 
 enum class ycbcr_type : int {
   ycbcr_jpeg = 0,
@@ -49,7 +53,7 @@ struct yuv_params {
   uint8_t y_offset;    // YMin
 };
 
-constexpr uint8_t clamp(uint16_t value) {
+constexpr uint8_t clamp(int value) {
   return value < 0 ? 0 : (value > 255 ? 255 : value);
 }
 
@@ -80,13 +84,32 @@ static constexpr yuv_params yuv2rb[6] = {
   make_yuv_params(0.2627, 0.0593, 0.0, 255.0, 255.0),
 };
 
+// Byte order of the 32 bit pixels written, named after the bytes in memory
+enum class rgb32_order : int {
+	argb = 0,
+	rgba = 1,
+	bgra = 2
+};
+
+// Offsets of the alpha, red, green and blue bytes in a pixel, for every rgb32_order
+struct rgb32_offsets {
+	int a, r, g, b;
+};
+
+static constexpr rgb32_offsets rgb32_layouts[3] = {
+	{ 0, 1, 2, 3 },
+	{ 3, 0, 1, 2 },
+	{ 3, 2, 1, 0 },
+};
+
 static void yuv420_rgb24_std(
 	uint32_t width, uint32_t height, 
 	const uint8_t* y_addr, const uint8_t *u_addr, const uint8_t *v_addr, uint32_t y_stride, uint32_t uv_stride, 
 	uint8_t *rgba_addr, uint32_t rgb_stride, 
-	ycbcr_type yuv_type
+	ycbcr_type yuv_type, rgb32_order order = rgb32_order::argb
 ) {
 	const yuv_params* const param = &(yuv2rb[(int)yuv_type]);
+	const rgb32_offsets o = rgb32_layouts[(int)order];
 	uint32_t x, y;
 
 	for(y=0; y<(height-1); y+=2) {
@@ -111,28 +134,28 @@ static void yuv420_rgb24_std(
 			
 			int16_t y_tmp;
 			y_tmp = (param->y_factor * (y_ptr1[0] - param->y_offset)) >> 7;
-      rgb_ptr1[0] = 0xFF;
-			rgb_ptr1[1] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr1[2] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr1[3] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr1[o.a] = 0xFF;
+			rgb_ptr1[o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr1[o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr1[o.b] = clamp(y_tmp + b_cb_offset);
 			
 			y_tmp = (param->y_factor * (y_ptr1[1] - param->y_offset)) >> 7;
-      rgb_ptr1[4] = 0xFF;
-			rgb_ptr1[5] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr1[6] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr1[7] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr1[4 + o.a] = 0xFF;
+			rgb_ptr1[4 + o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr1[4 + o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr1[4 + o.b] = clamp(y_tmp + b_cb_offset);
 			
 			y_tmp = (param->y_factor * (y_ptr2[0] - param->y_offset)) >> 7;
-      rgb_ptr2[0] = 0xFF;
-			rgb_ptr2[1] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr2[2] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr2[3] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr2[o.a] = 0xFF;
+			rgb_ptr2[o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr2[o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr2[o.b] = clamp(y_tmp + b_cb_offset);
 			
 			y_tmp = (param->y_factor * (y_ptr2[1] - param->y_offset)) >> 7;
-      rgb_ptr2[4] = 0xFF;
-			rgb_ptr2[5] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr2[6] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr2[7] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr2[4 + o.a] = 0xFF;
+			rgb_ptr2[4 + o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr2[4 + o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr2[4 + o.b] = clamp(y_tmp + b_cb_offset);
 			
 			rgb_ptr1 += 8;
 			rgb_ptr2 += 8;
@@ -148,9 +171,10 @@ static void nv12_rgb24_std(
 	uint32_t width, uint32_t height, 
 	const uint8_t* y_addr, const uint8_t* uv_addr, uint32_t y_stride, uint32_t uv_stride, 
 	uint8_t *rgb, uint32_t rgb_stride, 
-	ycbcr_type yuv_type)
+	ycbcr_type yuv_type, rgb32_order order = rgb32_order::argb)
 {
 	const yuv_params* const param = &(yuv2rb[(int)yuv_type]);
+	const rgb32_offsets o = rgb32_layouts[(int)order];
 	uint32_t x, y;
 	for(y=0; y<(height-1); y+=2)
 	{
@@ -175,28 +199,28 @@ static void nv12_rgb24_std(
 			
 			int16_t y_tmp;
 			y_tmp = (param->y_factor*(y_ptr1[0]-param->y_offset))>>7;
-      rgb_ptr1[0] = 0xFF;
-			rgb_ptr1[1] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr1[2] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr1[3] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr1[o.a] = 0xFF;
+			rgb_ptr1[o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr1[o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr1[o.b] = clamp(y_tmp + b_cb_offset);
 			
 			y_tmp = (param->y_factor*(y_ptr1[1]-param->y_offset))>>7;
-      rgb_ptr1[4] = 0xFF;
-			rgb_ptr1[5] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr1[6] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr1[7] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr1[4 + o.a] = 0xFF;
+			rgb_ptr1[4 + o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr1[4 + o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr1[4 + o.b] = clamp(y_tmp + b_cb_offset);
 			
 			y_tmp = (param->y_factor*(y_ptr2[0]-param->y_offset))>>7;
-      rgb_ptr2[0] = 0xFF;
-			rgb_ptr2[1] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr2[2] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr2[3] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr2[o.a] = 0xFF;
+			rgb_ptr2[o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr2[o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr2[o.b] = clamp(y_tmp + b_cb_offset);
 			
 			y_tmp = (param->y_factor*(y_ptr2[1]-param->y_offset))>>7;
-      rgb_ptr2[4] = 0xFF;
-			rgb_ptr2[5] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr2[6] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr2[7] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr2[4 + o.a] = 0xFF;
+			rgb_ptr2[4 + o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr2[4 + o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr2[4 + o.b] = clamp(y_tmp + b_cb_offset);
 			
 			rgb_ptr1 += 8;
 			rgb_ptr2 += 8;
@@ -211,9 +235,10 @@ static void nv21_rgb24_std(
 	uint32_t width, uint32_t height, 
 	const uint8_t* y_addr, const uint8_t* uv_addr, uint32_t y_stride, uint32_t uv_stride, 
 	uint8_t *rgb, uint32_t rgb_stride, 
-	ycbcr_type yuv_type)
+	ycbcr_type yuv_type, rgb32_order order = rgb32_order::argb)
 {
 	const yuv_params* const param = &(yuv2rb[(int)yuv_type]);
+	const rgb32_offsets o = rgb32_layouts[(int)order];
 
 	uint32_t x, y;
 	for(y=0; y<(height-1); y+=2)
@@ -239,28 +264,28 @@ static void nv21_rgb24_std(
 			
 			int16_t y_tmp;
 			y_tmp = (param->y_factor*(y_ptr1[0]-param->y_offset))>>7;
-      rgb_ptr1[0] = 0xFF;
-			rgb_ptr1[1] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr1[2] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr1[3] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr1[o.a] = 0xFF;
+			rgb_ptr1[o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr1[o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr1[o.b] = clamp(y_tmp + b_cb_offset);
 			
 			y_tmp = (param->y_factor*(y_ptr1[1]-param->y_offset))>>7;
-      rgb_ptr1[4] = 0xFF;
-			rgb_ptr1[5] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr1[6] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr1[7] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr1[4 + o.a] = 0xFF;
+			rgb_ptr1[4 + o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr1[4 + o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr1[4 + o.b] = clamp(y_tmp + b_cb_offset);
 			
 			y_tmp = (param->y_factor*(y_ptr2[0]-param->y_offset))>>7;
-      rgb_ptr2[0] = 0xFF;
-			rgb_ptr2[1] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr2[2] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr2[3] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr2[o.a] = 0xFF;
+			rgb_ptr2[o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr2[o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr2[o.b] = clamp(y_tmp + b_cb_offset);
 			
 			y_tmp = (param->y_factor*(y_ptr2[1]-param->y_offset))>>7;
-      rgb_ptr2[4] = 0xFF;
-			rgb_ptr2[5] = clamp(y_tmp + r_cr_offset);
-			rgb_ptr2[6] = clamp(y_tmp - g_cbcr_offset);
-			rgb_ptr2[7] = clamp(y_tmp + b_cb_offset);
+      rgb_ptr2[4 + o.a] = 0xFF;
+			rgb_ptr2[4 + o.r] = clamp(y_tmp + r_cr_offset);
+			rgb_ptr2[4 + o.g] = clamp(y_tmp - g_cbcr_offset);
+			rgb_ptr2[4 + o.b] = clamp(y_tmp + b_cb_offset);
 			
 			rgb_ptr1 += 8;
 			rgb_ptr2 += 8;
@@ -269,4 +294,598 @@ static void nv21_rgb24_std(
 			uv_ptr += 2;
 		}
 	}
-}
\ No newline at end of file
+}
+
+/*
+ * Vectorized converters.
+ *
+ * The kernels below produce exactly the same output as the *_std functions above
+ * for every ycbcr_type: all the fixed point products are computed with the same
+ * precision and the same rounding (arithmetic shift), only several pixels at a time.
+ * The columns left over by the vector loop are handed to the scalar functions.
+ *
+ * yuv420_rgb24, nv12_rgb24 and nv21_rgb24 select the best kernel supported by the
+ * CPU at runtime, the *_std functions are kept as the reference implementation.
+ */
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+	#define YUV_TO_RGBA_X86 1
+	#include <emmintrin.h>
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#define YUV_TO_RGBA_AVX2_TARGET
+	#else
+		#define YUV_TO_RGBA_AVX2_TARGET __attribute__((target("avx2")))
+	#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+	#define YUV_TO_RGBA_NEON 1
+	#include <arm_neon.h>
+#endif
+
+enum class yuv_simd : int {
+	none = 0,
+	sse2 = 1,
+	avx2 = 2,
+	neon = 3
+};
+
+enum class yuv_chroma_layout : int {
+	i420 = 0,
+	nv12 = 1,
+	nv21 = 2
+};
+
+static void yuv_rgb24_std(
+	yuv_chroma_layout layout,
+	uint32_t width, uint32_t height,
+	const uint8_t* y_addr, const uint8_t* u_addr, const uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+	uint8_t* rgb, uint32_t rgb_stride,
+	ycbcr_type yuv_type, rgb32_order order = rgb32_order::argb)
+{
+	switch (layout) {
+		case yuv_chroma_layout::i420:
+			yuv420_rgb24_std(width, height, y_addr, u_addr, v_addr, y_stride, uv_stride, rgb, rgb_stride, yuv_type, order);
+			break;
+		case yuv_chroma_layout::nv12:
+			nv12_rgb24_std(width, height, y_addr, u_addr, y_stride, uv_stride, rgb, rgb_stride, yuv_type, order);
+			break;
+		case yuv_chroma_layout::nv21:
+			nv21_rgb24_std(width, height, y_addr, u_addr, y_stride, uv_stride, rgb, rgb_stride, yuv_type, order);
+			break;
+	}
+}
+
+// Converts the columns the vector loop did not reach (always an even offset)
+static void yuv_rgb24_tail(
+	yuv_chroma_layout layout, uint32_t done,
+	uint32_t width, uint32_t height,
+	const uint8_t* y_addr, const uint8_t* u_addr, const uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+	uint8_t* rgb, uint32_t rgb_stride,
+	ycbcr_type yuv_type, rgb32_order order)
+{
+	if (width - done < 2) {
+		return;
+	}
+
+	uint32_t chroma_offset = layout == yuv_chroma_layout::i420 ? done / 2 : done;
+	yuv_rgb24_std(
+		layout, width - done, height,
+		y_addr + done, u_addr + chroma_offset, layout == yuv_chroma_layout::i420 ? v_addr + chroma_offset : nullptr,
+		y_stride, uv_stride,
+		rgb + done * 4, rgb_stride,
+		yuv_type, order);
+}
+
+#if defined(YUV_TO_RGBA_X86)
+
+struct yuv_sse2_params {
+	__m128i cb_factor;   // cb_factor << 5, paired with chroma << 5 in _mm_mulhi_epi16
+	__m128i cr_factor;   // cr_factor << 5
+	__m128i g_factors;   // g_cb_factor | g_cr_factor << 16, for _mm_madd_epi16
+	__m128i y_factor;    // y_factor << 5, paired with luma << 4 in _mm_mulhi_epi16
+	__m128i y_offset;
+	__m128i chroma_bias;
+	__m128i alpha;
+};
+
+static inline yuv_sse2_params yuv_sse2_make_params(const yuv_params* param) {
+	return yuv_sse2_params {
+		_mm_set1_epi16((int16_t)(param->cb_factor << 5)),
+		_mm_set1_epi16((int16_t)(param->cr_factor << 5)),
+		_mm_set1_epi32(param->g_cb_factor | (param->g_cr_factor << 16)),
+		_mm_set1_epi16((int16_t)(param->y_factor << 5)),
+		_mm_set1_epi16(param->y_offset),
+		_mm_set1_epi16(128),
+		_mm_set1_epi8((char)0xFF)
+	};
+}
+
+// (factor * luma) >> 7 for 8 pixels, luma is given as unsigned 16 bit lanes
+static inline __m128i yuv_sse2_luma(const yuv_sse2_params& p, __m128i y) {
+	return _mm_mulhi_epi16(_mm_slli_epi16(_mm_sub_epi16(y, p.y_offset), 4), p.y_factor);
+}
+
+// Converts and stores 16 pixels of a row, r/g/b hold the offsets for pixels 0-7 (lo) and 8-15 (hi)
+template<rgb32_order Order>
+static inline void yuv_sse2_store_row(
+	const yuv_sse2_params& p, const uint8_t* y_ptr, uint8_t* rgb_ptr,
+	__m128i r_lo, __m128i r_hi, __m128i g_lo, __m128i g_hi, __m128i b_lo, __m128i b_hi)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i y = _mm_loadu_si128((const __m128i*)y_ptr);
+	__m128i y_lo = yuv_sse2_luma(p, _mm_unpacklo_epi8(y, zero));
+	__m128i y_hi = yuv_sse2_luma(p, _mm_unpackhi_epi8(y, zero));
+
+	// One vector per byte of the pixel, in memory order
+	constexpr rgb32_offsets o = rgb32_layouts[(int)Order];
+	__m128i c[4];
+	c[o.a] = p.alpha;
+	c[o.r] = _mm_packus_epi16(_mm_add_epi16(y_lo, r_lo), _mm_add_epi16(y_hi, r_hi));
+	c[o.g] = _mm_packus_epi16(_mm_sub_epi16(y_lo, g_lo), _mm_sub_epi16(y_hi, g_hi));
+	c[o.b] = _mm_packus_epi16(_mm_add_epi16(y_lo, b_lo), _mm_add_epi16(y_hi, b_hi));
+
+	__m128i c01_lo = _mm_unpacklo_epi8(c[0], c[1]);
+	__m128i c01_hi = _mm_unpackhi_epi8(c[0], c[1]);
+	__m128i c23_lo = _mm_unpacklo_epi8(c[2], c[3]);
+	__m128i c23_hi = _mm_unpackhi_epi8(c[2], c[3]);
+
+	_mm_storeu_si128((__m128i*)(rgb_ptr), _mm_unpacklo_epi16(c01_lo, c23_lo));
+	_mm_storeu_si128((__m128i*)(rgb_ptr + 16), _mm_unpackhi_epi16(c01_lo, c23_lo));
+	_mm_storeu_si128((__m128i*)(rgb_ptr + 32), _mm_unpacklo_epi16(c01_hi, c23_hi));
+	_mm_storeu_si128((__m128i*)(rgb_ptr + 48), _mm_unpackhi_epi16(c01_hi, c23_hi));
+}
+
+template<yuv_chroma_layout Layout, rgb32_order Order>
+static void yuv_rgb24_sse2(
+	uint32_t width, uint32_t height,
+	const uint8_t* y_addr, const uint8_t* u_addr, const uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+	uint8_t* rgb, uint32_t rgb_stride,
+	ycbcr_type yuv_type)
+{
+	if (width < 2 || height < 2) {
+		return;
+	}
+
+	const yuv_sse2_params p = yuv_sse2_make_params(&(yuv2rb[(int)yuv_type]));
+	const uint32_t pixels = width & ~1u;
+	const uint32_t done = pixels & ~15u;
+
+	for (uint32_t y = 0; y < (height - 1); y += 2) {
+		const uint8_t* y_ptr1 = y_addr + y * y_stride;
+		const uint8_t* y_ptr2 = y_addr + (y + 1) * y_stride;
+		const uint8_t* u_ptr = u_addr + (y / 2) * uv_stride;
+		const uint8_t* v_ptr = Layout == yuv_chroma_layout::i420 ? v_addr + (y / 2) * uv_stride : nullptr;
+
+		uint8_t* rgb_ptr1 = rgb + y * rgb_stride;
+		uint8_t* rgb_ptr2 = rgb + (y + 1) * rgb_stride;
+
+		for (uint32_t x = 0; x < done; x += 16) {
+			__m128i u, v;
+			if (Layout == yuv_chroma_layout::i420) {
+				u = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(u_ptr + x / 2)), _mm_setzero_si128());
+				v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(v_ptr + x / 2)), _mm_setzero_si128());
+			} else {
+				__m128i uv = _mm_loadu_si128((const __m128i*)(u_ptr + x));
+				u = _mm_and_si128(uv, _mm_set1_epi16(0xFF));
+				v = _mm_srli_epi16(uv, 8);
+				if (Layout == yuv_chroma_layout::nv21) {
+					__m128i tmp = u; u = v; v = tmp;
+				}
+			}
+			u = _mm_sub_epi16(u, p.chroma_bias);
+			v = _mm_sub_epi16(v, p.chroma_bias);
+
+			// compute Cb Cr color offsets, common to four pixels
+			__m128i b_cb_offset = _mm_mulhi_epi16(_mm_slli_epi16(u, 5), p.cb_factor);
+			__m128i r_cr_offset = _mm_mulhi_epi16(_mm_slli_epi16(v, 5), p.cr_factor);
+			__m128i g_cbcr_offset = _mm_packs_epi32(
+				_mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(u, v), p.g_factors), 7),
+				_mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(u, v), p.g_factors), 7));
+
+			__m128i r_lo = _mm_unpacklo_epi16(r_cr_offset, r_cr_offset);
+			__m128i r_hi = _mm_unpackhi_epi16(r_cr_offset, r_cr_offset);
+			__m128i g_lo = _mm_unpacklo_epi16(g_cbcr_offset, g_cbcr_offset);
+			__m128i g_hi = _mm_unpackhi_epi16(g_cbcr_offset, g_cbcr_offset);
+			__m128i b_lo = _mm_unpacklo_epi16(b_cb_offset, b_cb_offset);
+			__m128i b_hi = _mm_unpackhi_epi16(b_cb_offset, b_cb_offset);
+
+			yuv_sse2_store_row<Order>(p, y_ptr1 + x, rgb_ptr1 + x * 4, r_lo, r_hi, g_lo, g_hi, b_lo, b_hi);
+			yuv_sse2_store_row<Order>(p, y_ptr2 + x, rgb_ptr2 + x * 4, r_lo, r_hi, g_lo, g_hi, b_lo, b_hi);
+		}
+	}
+
+	yuv_rgb24_tail(Layout, done, width, height, y_addr, u_addr, v_addr, y_stride, uv_stride, rgb, rgb_stride, yuv_type, Order);
+}
+
+struct yuv_avx2_params {
+	__m256i cb_factor;
+	__m256i cr_factor;
+	__m256i g_factors;
+	__m256i y_factor;
+	__m256i y_offset;
+	__m256i chroma_bias;
+	__m256i alpha;
+};
+
+YUV_TO_RGBA_AVX2_TARGET static inline yuv_avx2_params yuv_avx2_make_params(const yuv_params* param) {
+	return yuv_avx2_params {
+		_mm256_set1_epi16((int16_t)(param->cb_factor << 5)),
+		_mm256_set1_epi16((int16_t)(param->cr_factor << 5)),
+		_mm256_set1_epi32(param->g_cb_factor | (param->g_cr_factor << 16)),
+		_mm256_set1_epi16((int16_t)(param->y_factor << 5)),
+		_mm256_set1_epi16(param->y_offset),
+		_mm256_set1_epi16(128),
+		_mm256_set1_epi8((char)0xFF)
+	};
+}
+
+YUV_TO_RGBA_AVX2_TARGET static inline __m256i yuv_avx2_luma(const yuv_avx2_params& p, __m256i y) {
+	return _mm256_mulhi_epi16(_mm256_slli_epi16(_mm256_sub_epi16(y, p.y_offset), 4), p.y_factor);
+}
+
+// Packs two vectors of 16 bit lanes (pixels 0-15 and 16-31) into 32 bytes in pixel order
+YUV_TO_RGBA_AVX2_TARGET static inline __m256i yuv_avx2_pack(__m256i a, __m256i b) {
+	return _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+}
+
+// Converts and stores 32 pixels of a row, r/g/b hold the offsets for pixels 0-15 (a) and 16-31 (b)
+template<rgb32_order Order>
+YUV_TO_RGBA_AVX2_TARGET static inline void yuv_avx2_store_row(
+	const yuv_avx2_params& p, const uint8_t* y_ptr, uint8_t* rgb_ptr,
+	__m256i r_a, __m256i r_b, __m256i g_a, __m256i g_b, __m256i b_a, __m256i b_b)
+{
+	__m256i y = _mm256_loadu_si256((const __m256i*)y_ptr);
+	__m256i y_a = yuv_avx2_luma(p, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(y)));
+	__m256i y_b = yuv_avx2_luma(p, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(y, 1)));
+
+	// One vector per byte of the pixel, in memory order
+	constexpr rgb32_offsets o = rgb32_layouts[(int)Order];
+	__m256i c[4];
+	c[o.a] = p.alpha;
+	c[o.r] = yuv_avx2_pack(_mm256_add_epi16(y_a, r_a), _mm256_add_epi16(y_b, r_b));
+	c[o.g] = yuv_avx2_pack(_mm256_sub_epi16(y_a, g_a), _mm256_sub_epi16(y_b, g_b));
+	c[o.b] = yuv_avx2_pack(_mm256_add_epi16(y_a, b_a), _mm256_add_epi16(y_b, b_b));
+
+	// Lane 0 holds pixels 0-7 and lane 1 pixels 16-23 (lo), 8-15 and 24-31 (hi)
+	__m256i c01_lo = _mm256_unpacklo_epi8(c[0], c[1]);
+	__m256i c01_hi = _mm256_unpackhi_epi8(c[0], c[1]);
+	__m256i c23_lo = _mm256_unpacklo_epi8(c[2], c[3]);
+	__m256i c23_hi = _mm256_unpackhi_epi8(c[2], c[3]);
+
+	__m256i q0 = _mm256_unpacklo_epi16(c01_lo, c23_lo);
+	__m256i q1 = _mm256_unpackhi_epi16(c01_lo, c23_lo);
+	__m256i q2 = _mm256_unpacklo_epi16(c01_hi, c23_hi);
+	__m256i q3 = _mm256_unpackhi_epi16(c01_hi, c23_hi);
+
+	_mm256_storeu_si256((__m256i*)(rgb_ptr), _mm256_permute2x128_si256(q0, q1, 0x20));
+	_mm256_storeu_si256((__m256i*)(rgb_ptr + 32), _mm256_permute2x128_si256(q2, q3, 0x20));
+	_mm256_storeu_si256((__m256i*)(rgb_ptr + 64), _mm256_permute2x128_si256(q0, q1, 0x31));
+	_mm256_storeu_si256((__m256i*)(rgb_ptr + 96), _mm256_permute2x128_si256(q2, q3, 0x31));
+}
+
+template<yuv_chroma_layout Layout, rgb32_order Order>
+YUV_TO_RGBA_AVX2_TARGET static void yuv_rgb24_avx2(
+	uint32_t width, uint32_t height,
+	const uint8_t* y_addr, const uint8_t* u_addr, const uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+	uint8_t* rgb, uint32_t rgb_stride,
+	ycbcr_type yuv_type)
+{
+	if (width < 2 || height < 2) {
+		return;
+	}
+
+	const yuv_avx2_params p = yuv_avx2_make_params(&(yuv2rb[(int)yuv_type]));
+	const uint32_t pixels = width & ~1u;
+	const uint32_t done = pixels & ~31u;
+
+	for (uint32_t y = 0; y < (height - 1); y += 2) {
+		const uint8_t* y_ptr1 = y_addr + y * y_stride;
+		const uint8_t* y_ptr2 = y_addr + (y + 1) * y_stride;
+		const uint8_t* u_ptr = u_addr + (y / 2) * uv_stride;
+		const uint8_t* v_ptr = Layout == yuv_chroma_layout::i420 ? v_addr + (y / 2) * uv_stride : nullptr;
+
+		uint8_t* rgb_ptr1 = rgb + y * rgb_stride;
+		uint8_t* rgb_ptr2 = rgb + (y + 1) * rgb_stride;
+
+		for (uint32_t x = 0; x < done; x += 32) {
+			__m256i u, v;
+			if (Layout == yuv_chroma_layout::i420) {
+				u = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(u_ptr + x / 2)));
+				v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(v_ptr + x / 2)));
+			} else {
+				__m256i uv = _mm256_loadu_si256((const __m256i*)(u_ptr + x));
+				u = _mm256_and_si256(uv, _mm256_set1_epi16(0xFF));
+				v = _mm256_srli_epi16(uv, 8);
+				if (Layout == yuv_chroma_layout::nv21) {
+					__m256i tmp = u; u = v; v = tmp;
+				}
+			}
+			u = _mm256_sub_epi16(u, p.chroma_bias);
+			v = _mm256_sub_epi16(v, p.chroma_bias);
+
+			// compute Cb Cr color offsets, common to four pixels
+			__m256i b_cb_offset = _mm256_mulhi_epi16(_mm256_slli_epi16(u, 5), p.cb_factor);
+			__m256i r_cr_offset = _mm256_mulhi_epi16(_mm256_slli_epi16(v, 5), p.cr_factor);
+			__m256i g_cbcr_offset = _mm256_packs_epi32(
+				_mm256_srai_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(u, v), p.g_factors), 7),
+				_mm256_srai_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(u, v), p.g_factors), 7));
+
+			// Duplicate each chroma offset for the two pixels it covers
+			__m256i r_lo = _mm256_unpacklo_epi16(r_cr_offset, r_cr_offset);
+			__m256i r_hi = _mm256_unpackhi_epi16(r_cr_offset, r_cr_offset);
+			__m256i g_lo = _mm256_unpacklo_epi16(g_cbcr_offset, g_cbcr_offset);
+			__m256i g_hi = _mm256_unpackhi_epi16(g_cbcr_offset, g_cbcr_offset);
+			__m256i b_lo = _mm256_unpacklo_epi16(b_cb_offset, b_cb_offset);
+			__m256i b_hi = _mm256_unpackhi_epi16(b_cb_offset, b_cb_offset);
+
+			__m256i r_a = _mm256_permute2x128_si256(r_lo, r_hi, 0x20);
+			__m256i r_b = _mm256_permute2x128_si256(r_lo, r_hi, 0x31);
+			__m256i g_a = _mm256_permute2x128_si256(g_lo, g_hi, 0x20);
+			__m256i g_b = _mm256_permute2x128_si256(g_lo, g_hi, 0x31);
+			__m256i b_a = _mm256_permute2x128_si256(b_lo, b_hi, 0x20);
+			__m256i b_b = _mm256_permute2x128_si256(b_lo, b_hi, 0x31);
+
+			yuv_avx2_store_row<Order>(p, y_ptr1 + x, rgb_ptr1 + x * 4, r_a, r_b, g_a, g_b, b_a, b_b);
+			yuv_avx2_store_row<Order>(p, y_ptr2 + x, rgb_ptr2 + x * 4, r_a, r_b, g_a, g_b, b_a, b_b);
+		}
+	}
+
+	yuv_rgb24_tail(Layout, done, width, height, y_addr, u_addr, v_addr, y_stride, uv_stride, rgb, rgb_stride, yuv_type, Order);
+}
+
+static bool yuv_cpu_has_avx2() {
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+
+	__cpuid(info, 1);
+	bool os_saves_ymm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 0x6) == 0x6);
+	if (!os_saves_ymm) {
+		return false;
+	}
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // YUV_TO_RGBA_X86
+
+#if defined(YUV_TO_RGBA_NEON)
+
+struct yuv_neon_params {
+	int16x8_t cb_factor;   // cb_factor << 4, paired with chroma << 5 in vqdmulhq_s16
+	int16x8_t cr_factor;   // cr_factor << 4
+	int16x4_t g_cb_factor;
+	int16x4_t g_cr_factor;
+	int16x8_t y_factor;    // y_factor << 4, paired with luma << 4 in vqdmulhq_s16
+	int16x8_t y_offset;
+	int16x8_t chroma_bias;
+	uint8x16_t alpha;
+};
+
+static inline yuv_neon_params yuv_neon_make_params(const yuv_params* param) {
+	return yuv_neon_params {
+		vdupq_n_s16((int16_t)(param->cb_factor << 4)),
+		vdupq_n_s16((int16_t)(param->cr_factor << 4)),
+		vdup_n_s16(param->g_cb_factor),
+		vdup_n_s16(param->g_cr_factor),
+		vdupq_n_s16((int16_t)(param->y_factor << 4)),
+		vdupq_n_s16(param->y_offset),
+		vdupq_n_s16(128),
+		vdupq_n_u8(0xFF)
+	};
+}
+
+static inline int16x8_t yuv_neon_luma(const yuv_neon_params& p, uint8x8_t y) {
+	int16x8_t luma = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y)), p.y_offset);
+	return vqdmulhq_s16(vshlq_n_s16(luma, 4), p.y_factor);
+}
+
+// Converts and stores 16 pixels of a row, r/g/b hold the offsets for pixels 0-7 (lo) and 8-15 (hi)
+template<rgb32_order Order>
+static inline void yuv_neon_store_row(
+	const yuv_neon_params& p, const uint8_t* y_ptr, uint8_t* rgb_ptr,
+	int16x8_t r_lo, int16x8_t r_hi, int16x8_t g_lo, int16x8_t g_hi, int16x8_t b_lo, int16x8_t b_hi)
+{
+	uint8x16_t y = vld1q_u8(y_ptr);
+	int16x8_t y_lo = yuv_neon_luma(p, vget_low_u8(y));
+	int16x8_t y_hi = yuv_neon_luma(p, vget_high_u8(y));
+
+	constexpr rgb32_offsets o = rgb32_layouts[(int)Order];
+	uint8x16x4_t pixels;
+	pixels.val[o.a] = p.alpha;
+	pixels.val[o.r] = vcombine_u8(vqmovun_s16(vaddq_s16(y_lo, r_lo)), vqmovun_s16(vaddq_s16(y_hi, r_hi)));
+	pixels.val[o.g] = vcombine_u8(vqmovun_s16(vsubq_s16(y_lo, g_lo)), vqmovun_s16(vsubq_s16(y_hi, g_hi)));
+	pixels.val[o.b] = vcombine_u8(vqmovun_s16(vaddq_s16(y_lo, b_lo)), vqmovun_s16(vaddq_s16(y_hi, b_hi)));
+	vst4q_u8(rgb_ptr, pixels);
+}
+
+template<yuv_chroma_layout Layout, rgb32_order Order>
+static void yuv_rgb24_neon(
+	uint32_t width, uint32_t height,
+	const uint8_t* y_addr, const uint8_t* u_addr, const uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+	uint8_t* rgb, uint32_t rgb_stride,
+	ycbcr_type yuv_type)
+{
+	if (width < 2 || height < 2) {
+		return;
+	}
+
+	const yuv_neon_params p = yuv_neon_make_params(&(yuv2rb[(int)yuv_type]));
+	const uint32_t pixels = width & ~1u;
+	const uint32_t done = pixels & ~15u;
+
+	for (uint32_t y = 0; y < (height - 1); y += 2) {
+		const uint8_t* y_ptr1 = y_addr + y * y_stride;
+		const uint8_t* y_ptr2 = y_addr + (y + 1) * y_stride;
+		const uint8_t* u_ptr = u_addr + (y / 2) * uv_stride;
+		const uint8_t* v_ptr = Layout == yuv_chroma_layout::i420 ? v_addr + (y / 2) * uv_stride : nullptr;
+
+		uint8_t* rgb_ptr1 = rgb + y * rgb_stride;
+		uint8_t* rgb_ptr2 = rgb + (y + 1) * rgb_stride;
+
+		for (uint32_t x = 0; x < done; x += 16) {
+			uint8x8_t u8, v8;
+			if (Layout == yuv_chroma_layout::i420) {
+				u8 = vld1_u8(u_ptr + x / 2);
+				v8 = vld1_u8(v_ptr + x / 2);
+			} else {
+				uint8x8x2_t uv = vld2_u8(u_ptr + x);
+				u8 = Layout == yuv_chroma_layout::nv12 ? uv.val[0] : uv.val[1];
+				v8 = Layout == yuv_chroma_layout::nv12 ? uv.val[1] : uv.val[0];
+			}
+			int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u8)), p.chroma_bias);
+			int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v8)), p.chroma_bias);
+
+			// compute Cb Cr color offsets, common to four pixels
+			int16x8_t b_cb_offset = vqdmulhq_s16(vshlq_n_s16(u, 5), p.cb_factor);
+			int16x8_t r_cr_offset = vqdmulhq_s16(vshlq_n_s16(v, 5), p.cr_factor);
+			int32x4_t g_lo32 = vmlal_s16(vmull_s16(vget_low_s16(u), p.g_cb_factor), vget_low_s16(v), p.g_cr_factor);
+			int32x4_t g_hi32 = vmlal_s16(vmull_s16(vget_high_s16(u), p.g_cb_factor), vget_high_s16(v), p.g_cr_factor);
+			int16x8_t g_cbcr_offset = vcombine_s16(vshrn_n_s32(g_lo32, 7), vshrn_n_s32(g_hi32, 7));
+
+			int16x8_t r_lo = vzip1q_s16(r_cr_offset, r_cr_offset);
+			int16x8_t r_hi = vzip2q_s16(r_cr_offset, r_cr_offset);
+			int16x8_t g_lo = vzip1q_s16(g_cbcr_offset, g_cbcr_offset);
+			int16x8_t g_hi = vzip2q_s16(g_cbcr_offset, g_cbcr_offset);
+			int16x8_t b_lo = vzip1q_s16(b_cb_offset, b_cb_offset);
+			int16x8_t b_hi = vzip2q_s16(b_cb_offset, b_cb_offset);
+
+			yuv_neon_store_row<Order>(p, y_ptr1 + x, rgb_ptr1 + x * 4, r_lo, r_hi, g_lo, g_hi, b_lo, b_hi);
+			yuv_neon_store_row<Order>(p, y_ptr2 + x, rgb_ptr2 + x * 4, r_lo, r_hi, g_lo, g_hi, b_lo, b_hi);
+		}
+	}
+
+	yuv_rgb24_tail(Layout, done, width, height, y_addr, u_addr, v_addr, y_stride, uv_stride, rgb, rgb_stride, yuv_type, Order);
+}
+
+#endif // YUV_TO_RGBA_NEON
+
+/**
+ * @brief Returns whether the given kernel can run on this CPU.
+ */
+static bool yuv_simd_supported(yuv_simd simd) {
+	switch (simd) {
+		case yuv_simd::none:
+			return true;
+#if defined(YUV_TO_RGBA_X86)
+		case yuv_simd::sse2:
+			return true;
+		case yuv_simd::avx2: {
+			static const bool has_avx2 = yuv_cpu_has_avx2();
+			return has_avx2;
+		}
+#endif
+#if defined(YUV_TO_RGBA_NEON)
+		case yuv_simd::neon:
+			return true;
+#endif
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief Returns the fastest kernel supported by this CPU, detected once.
+ */
+static yuv_simd yuv_simd_detect() {
+	static const yuv_simd best = []() {
+		for (yuv_simd simd : { yuv_simd::avx2, yuv_simd::neon, yuv_simd::sse2 }) {
+			if (yuv_simd_supported(simd)) {
+				return simd;
+			}
+		}
+		return yuv_simd::none;
+	}();
+	return best;
+}
+
+using yuv_rgb24_kernel_type = void (*)(uint32_t, uint32_t, const uint8_t*, const uint8_t*, const uint8_t*, uint32_t, uint32_t, uint8_t*, uint32_t, ycbcr_type);
+
+// Gets the vectorized kernel for the given layout and byte order, nullptr if simd has none
+template<rgb32_order Order>
+static yuv_rgb24_kernel_type yuv_rgb24_kernel(yuv_simd simd, yuv_chroma_layout layout) {
+	switch (simd) {
+#if defined(YUV_TO_RGBA_X86)
+		case yuv_simd::sse2:
+			return layout == yuv_chroma_layout::i420 ? yuv_rgb24_sse2<yuv_chroma_layout::i420, Order>
+				: layout == yuv_chroma_layout::nv12 ? yuv_rgb24_sse2<yuv_chroma_layout::nv12, Order>
+				: yuv_rgb24_sse2<yuv_chroma_layout::nv21, Order>;
+		case yuv_simd::avx2:
+			return layout == yuv_chroma_layout::i420 ? yuv_rgb24_avx2<yuv_chroma_layout::i420, Order>
+				: layout == yuv_chroma_layout::nv12 ? yuv_rgb24_avx2<yuv_chroma_layout::nv12, Order>
+				: yuv_rgb24_avx2<yuv_chroma_layout::nv21, Order>;
+#endif
+#if defined(YUV_TO_RGBA_NEON)
+		case yuv_simd::neon:
+			return layout == yuv_chroma_layout::i420 ? yuv_rgb24_neon<yuv_chroma_layout::i420, Order>
+				: layout == yuv_chroma_layout::nv12 ? yuv_rgb24_neon<yuv_chroma_layout::nv12, Order>
+				: yuv_rgb24_neon<yuv_chroma_layout::nv21, Order>;
+#endif
+		default:
+			return nullptr;
+	}
+}
+
+/**
+ * @brief Converts a frame with an explicit kernel. For NV12 and NV21 u_addr
+ * points to the interleaved chroma plane and v_addr is ignored. The pixels
+ * are written in the given byte order, so that no second pass reorders them.
+ */
+static void yuv_rgb24(
+	yuv_simd simd, yuv_chroma_layout layout,
+	uint32_t width, uint32_t height,
+	const uint8_t* y_addr, const uint8_t* u_addr, const uint8_t* v_addr, uint32_t y_stride, uint32_t uv_stride,
+	uint8_t* rgb, uint32_t rgb_stride,
+	ycbcr_type yuv_type, rgb32_order order = rgb32_order::argb)
+{
+	if (width < 2 || height < 2) {
+		return;
+	}
+
+	yuv_rgb24_kernel_type kernel = order == rgb32_order::rgba ? yuv_rgb24_kernel<rgb32_order::rgba>(simd, layout)
+		: order == rgb32_order::bgra ? yuv_rgb24_kernel<rgb32_order::bgra>(simd, layout)
+		: yuv_rgb24_kernel<rgb32_order::argb>(simd, layout);
+
+	if (kernel && yuv_simd_supported(simd)) {
+		kernel(width, height, y_addr, u_addr, v_addr, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+	} else {
+		yuv_rgb24_std(layout, width, height, y_addr, u_addr, v_addr, y_stride, uv_stride, rgb, rgb_stride, yuv_type, order);
+	}
+}
+
+static void yuv420_rgb24(
+	uint32_t width, uint32_t height,
+	const uint8_t* y_addr, const uint8_t *u_addr, const uint8_t *v_addr, uint32_t y_stride, uint32_t uv_stride,
+	uint8_t *rgba_addr, uint32_t rgb_stride,
+	ycbcr_type yuv_type)
+{
+	yuv_rgb24(yuv_simd_detect(), yuv_chroma_layout::i420, width, height, y_addr, u_addr, v_addr, y_stride, uv_stride, rgba_addr, rgb_stride, yuv_type);
+}
+
+static void nv12_rgb24(
+	uint32_t width, uint32_t height,
+	const uint8_t* y_addr, const uint8_t* uv_addr, uint32_t y_stride, uint32_t uv_stride,
+	uint8_t *rgb, uint32_t rgb_stride,
+	ycbcr_type yuv_type)
+{
+	yuv_rgb24(yuv_simd_detect(), yuv_chroma_layout::nv12, width, height, y_addr, uv_addr, nullptr, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+}
+
+static void nv21_rgb24(
+	uint32_t width, uint32_t height,
+	const uint8_t* y_addr, const uint8_t* uv_addr, uint32_t y_stride, uint32_t uv_stride,
+	uint8_t *rgb, uint32_t rgb_stride,
+	ycbcr_type yuv_type)
+{
+	yuv_rgb24(yuv_simd_detect(), yuv_chroma_layout::nv21, width, height, y_addr, uv_addr, nullptr, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+}
+
+#endif // _YUV_TO_RGBA_H_
@@ -12,8 +12,24 @@ namespace DolbyIO.Comms
         /// </summary>
         /// <param name="message">The message that describes the error.</param>
         internal DolbyIOException(string message)
+            : this(ErrorCode.Unknown, message)
+        {
+        }
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="DolbyIO.Comms.DolbyIOException">DolbyIOException</see>.
+        /// </summary>
+        /// <param name="code">The category of the error.</param>
+        /// <param name="message">The message that describes the error.</param>
+        internal DolbyIOException(ErrorCode code, string message)
             : base(message)
         {
+            Code = code;
         }
+
+        /// <summary>
+        /// Gets the category of the error.
+        /// </summary>
+        public ErrorCode Code { get; }
     }
 }
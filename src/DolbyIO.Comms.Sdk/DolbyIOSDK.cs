@@ -207,12 +207,9 @@ namespace DolbyIO.Comms
                 throw new DolbyIOException("Already initialized, call Dispose first.");
             }
             _refreshCallback = cb;
-            await Task.Run(() =>
-            {
-                Native.CheckException(Native.Init(accessToken, _refreshCallback));
-                Native.CheckException(Native.RegisterComponentVersion(_componentName, typeof(DolbyIOSDK).Assembly.GetName().Version.ToString()));
-                _initialized = true;
-            }).ConfigureAwait(false);
+            await Task.Run(() => Native.CheckException(Native.Init(accessToken, _refreshCallback))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.RegisterComponentVersionAsync(_componentName, typeof(DolbyIOSDK).Assembly.GetName().Version.ToString(), done, cookie)).ConfigureAwait(false);
+            _initialized = true;
         }
 
         /// <summary>
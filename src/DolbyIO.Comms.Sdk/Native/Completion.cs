@@ -0,0 +1,128 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Threading.Tasks;
+
+namespace DolbyIO.Comms
+{
+    internal delegate void CompletionHandler(IntPtr cookie, int result, IntPtr value, int count, [MarshalAs(UnmanagedType.LPStr)] string error);
+
+    internal delegate int AsyncExport(CompletionHandler done, IntPtr cookie);
+
+    /// <summary>
+    /// Turns the asynchronous native exports into tasks, without parking a thread while the SDK works.
+    /// </summary>
+    internal static class Completion
+    {
+        // Never collected, the SDK may complete long after the managed caller returned
+        internal static readonly CompletionHandler Handler = OnCompleted;
+
+        private abstract class Pending
+        {
+            internal abstract void Complete(int result, IntPtr value, int count, string error);
+        }
+
+        private sealed class Pending<T> : Pending
+        {
+            private readonly Func<IntPtr, int, T> _convert;
+
+            // Continuations must not run on the SDK thread, which blocking exports would deadlock
+            internal readonly TaskCompletionSource<T> Source = new TaskCompletionSource<T>(TaskCreationOptions.RunContinuationsAsynchronously);
+
+            internal Pending(Func<IntPtr, int, T> convert)
+            {
+                _convert = convert;
+            }
+
+            internal override void Complete(int result, IntPtr value, int count, string error)
+            {
+                // Failures complete with their error code
+                if (Result.Success != (Result)result)
+                {
+                    Source.SetException(new DolbyIOException((ErrorCode)result, error));
+                    return;
+                }
+
+                try
+                {
+                    Source.SetResult(_convert(value, count));
+                }
+                catch (Exception e)
+                {
+                    Source.SetException(e);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Starts an asynchronous export that completes without a value.
+        /// </summary>
+        internal static Task Run(AsyncExport start)
+        {
+            return Run<bool>(start, (value, count) => true);
+        }
+
+        /// <summary>
+        /// Starts an asynchronous export, converting its value on completion.
+        /// </summary>
+        /// <param name="start">Calls the export with the completion handler and cookie.</param>
+        /// <param name="convert">Copies the native value, only valid during the call, into managed objects.</param>
+        internal static Task<T> Run<T>(AsyncExport start, Func<IntPtr, int, T> convert)
+        {
+            var pending = new Pending<T>(convert);
+            GCHandle handle = GCHandle.Alloc(pending);
+
+            int result;
+            try
+            {
+                result = start(Handler, GCHandle.ToIntPtr(handle));
+            }
+            catch
+            {
+                handle.Free();
+                throw;
+            }
+
+            // The completion is never called when the operation failed to start
+            if (Result.Success != (Result)result)
+            {
+                handle.Free();
+                return Task.FromException<T>(Native.LastError());
+            }
+
+            return pending.Source.Task;
+        }
+
+        /// <summary>
+        /// Copies a native struct, or creates an empty one when there is no value.
+        /// </summary>
+        internal static T ToStructure<T>(IntPtr value) where T : new()
+        {
+            return value != IntPtr.Zero ? Marshal.PtrToStructure<T>(value) : new T();
+        }
+
+        /// <summary>
+        /// Copies a contiguous array of native structs.
+        /// </summary>
+        internal static T[] ToArray<T>(IntPtr value, int count)
+        {
+            T[] items = new T[count];
+            int size = Marshal.SizeOf<T>();
+
+            for (int i = 0; i < count; i++)
+            {
+                items[i] = Marshal.PtrToStructure<T>(IntPtr.Add(value, i * size));
+            }
+
+            return items;
+        }
+
+        private static void OnCompleted(IntPtr cookie, int result, IntPtr value, int count, string error)
+        {
+            GCHandle handle = GCHandle.FromIntPtr(cookie);
+            var pending = (Pending)handle.Target;
+            handle.Free();
+
+            pending.Complete(result, value, count, error);
+        }
+    }
+}
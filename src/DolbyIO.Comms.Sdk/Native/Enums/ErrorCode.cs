@@ -0,0 +1,67 @@
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The ErrorCode enum gathers the categories of the errors reported by
+    /// <see cref="DolbyIOException.Code"/>, which follow the exception types of the C++ SDK.
+    /// </summary>
+    public enum ErrorCode
+    {
+        /// <summary>
+        /// No error.
+        /// </summary>
+        None = 0,
+        /// <summary>
+        /// The error does not come from an exception of the C++ SDK.
+        /// </summary>
+        Unknown,
+        /// <summary>
+        /// An error of the C++ SDK without a more specific category.
+        /// </summary>
+        Sdk,
+        /// <summary>
+        /// An input or output error.
+        /// </summary>
+        IO,
+        /// <summary>
+        /// A network error.
+        /// </summary>
+        Network,
+        /// <summary>
+        /// An error of the signaling channel with the backend.
+        /// </summary>
+        SignalingChannel,
+        /// <summary>
+        /// The access token is invalid.
+        /// </summary>
+        InvalidToken,
+        /// <summary>
+        /// A conference error.
+        /// </summary>
+        Conference,
+        /// <summary>
+        /// The conference is not in a state allowing the operation, for example
+        /// when the operation requires joining the conference first.
+        /// </summary>
+        ConferenceState,
+        /// <summary>
+        /// A media engine error.
+        /// </summary>
+        MediaEngine,
+        /// <summary>
+        /// The peer connection failed.
+        /// </summary>
+        PeerConnectionFailed,
+        /// <summary>
+        /// An error of the Dolby Voice Codec.
+        /// </summary>
+        Dvc,
+        /// <summary>
+        /// A security check failed.
+        /// </summary>
+        SecurityCheck,
+        /// <summary>
+        /// An argument is invalid.
+        /// </summary>
+        InvalidArgument,
+    }
+}
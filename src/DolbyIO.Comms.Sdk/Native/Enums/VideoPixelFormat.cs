@@ -0,0 +1,40 @@
+using System;
+
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The possible pixel formats of the frames delivered to a <see cref="VideoSink"/>.
+    /// </summary>
+    public enum VideoPixelFormat
+    {
+        /// <summary>
+        /// One plane of 32 bit pixels stored in the A, R, G, B byte order.
+        /// </summary>
+        Argb8888 = 0,
+
+        /// <summary>
+        /// One plane of 32 bit pixels stored in the R, G, B, A byte order.
+        /// </summary>
+        Rgba8888 = 1,
+
+        /// <summary>
+        /// One plane of 32 bit pixels stored in the B, G, R, A byte order.
+        /// </summary>
+        Bgra8888 = 2,
+
+        /// <summary>
+        /// Three planes: full resolution luma, then half resolution U and V.
+        /// </summary>
+        I420 = 3,
+
+        /// <summary>
+        /// Two planes: full resolution luma, then half resolution interleaved U and V.
+        /// </summary>
+        Nv12 = 4,
+
+        /// <summary>
+        /// The luma plane only.
+        /// </summary>
+        Y8 = 5
+    }
+}
@@ -0,0 +1,20 @@
+using System;
+
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The possible behaviours of a <see cref="VideoSink"/> delivery queue when it is full.
+    /// </summary>
+    public enum VideoSinkOverflowPolicy
+    {
+        /// <summary>
+        /// The oldest queued frame is discarded to make room for the new one.
+        /// </summary>
+        DropOldest = 0,
+
+        /// <summary>
+        /// The new frame is discarded.
+        /// </summary>
+        DropNewest = 1
+    }
+}
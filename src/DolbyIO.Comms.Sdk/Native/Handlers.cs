@@ -39,6 +39,16 @@ namespace DolbyIO.Comms
     /// <param name="participant">The participant who changed status.</param>
     public delegate void ParticipantUpdatedEventHandler(Participant participant);
 
+    /// <summary>
+    /// The <see cref="DolbyIO.Comms.Services.ConferenceService.ParticipantsUpdated">Conference.ParticipantsUpdated</see> event handler.
+    /// </summary>
+    /// <param name="participants">The latest state of every participant added or updated during the batching window.</param>
+    public delegate void ParticipantsUpdatedEventHandler(Participant[] participants);
+
+    internal delegate void ParticipantsBatchHandler(IntPtr participants, int count);
+
+    internal delegate void ParticipantsChangesHandler(ulong version, int snapshot, IntPtr changed, int changedCount, IntPtr removed, int removedCount);
+
     /// <summary>
     /// The <see cref="DolbyIO.Comms.Services.ConferenceService.ActiveSpeakerChange">Conference.ActiveSpeakerChange</see> event handler. 
     /// </summary>
@@ -57,6 +67,29 @@ namespace DolbyIO.Comms
     /// <param name="message">The received message.</param>
     public delegate void ConferenceMessageReceivedEventHandler(string conferenceId, string userId, ParticipantInfo info, string message);
 
+    /// <summary>
+    /// The <see cref="DolbyIO.Comms.Services.ConferenceService.MessagesReceived">Conference.MessagesReceived</see> event handler.
+    /// </summary>
+    /// <param name="conferenceId">The conference ID.</param>
+    /// <param name="userId">The ID of the participant who sent the messages.</param>
+    /// <param name="info">Additional information about the participant who sent the messages.</param>
+    /// <param name="messages">The received messages, in the order they were queued.</param>
+    public delegate void ConferenceMessagesReceivedEventHandler(string conferenceId, string userId, ParticipantInfo info, string[] messages);
+
+    internal delegate void ConferenceMessagesBatchHandler(string conferenceId, string userId, ParticipantInfo info, int count,
+        [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr, SizeParamIndex = 3)] string[] messages);
+
+    /// <summary>
+    /// The <see cref="DolbyIO.Comms.Services.ConferenceService.BinaryMessageReceived">Conference.BinaryMessageReceived</see> event handler.
+    /// </summary>
+    /// <param name="conferenceId">The conference ID.</param>
+    /// <param name="userId">The ID of the participant who sent the message.</param>
+    /// <param name="info">Additional information about the participant who sent the message.</param>
+    /// <param name="data">The received payload.</param>
+    public delegate void ConferenceBinaryMessageReceivedEventHandler(string conferenceId, string userId, ParticipantInfo info, byte[] data);
+
+    internal delegate void ConferenceBinaryMessageHandler(string conferenceId, string userId, ParticipantInfo info, IntPtr data, int size);
+
     /// <summary>
     /// The <see cref="DolbyIO.Comms.Services.ConferenceService.InvitationReceived">Conference.InvitationReceived</see> event handler.
     /// </summary>
@@ -1,7 +1,9 @@
 using System;
 using System.Collections;
 using System.Collections.Generic;
+using System.Numerics;
 using System.Runtime.InteropServices;
+using System.Text;
 
 namespace DolbyIO.Comms
 {
@@ -20,50 +22,101 @@ namespace DolbyIO.Comms
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int RegisterComponentVersion(string name, string version);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int RegisterComponentVersionAsync(string name, string version, CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int SetLogLevel([MarshalAs(UnmanagedType.I4)] LogLevel level);
     
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int Open(UserInfo user, [Out] UserInfo res);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int OpenAsync(UserInfo user, CompletionHandler done, IntPtr cookie);
+
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         internal static extern int Close();
 
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int CloseAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int Create(ConferenceOptions options, [Out] Conference infos);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int CreateAsync(ConferenceOptions options, CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int Join(Conference conference, JoinOptions options, [Out] Conference res);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int JoinAsync(Conference conference, JoinOptions options, CompletionHandler done, IntPtr cookie);
         
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int Listen(Conference conference, ListenOptions options, [Out] Conference res);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int ListenAsync(Conference conference, ListenOptions options, CompletionHandler done, IntPtr cookie);
        
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int Demo(SpatialAudioStyle audioStyle, [Out] Conference conference);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int DemoAsync(SpatialAudioStyle audioStyle, CompletionHandler done, IntPtr cookie);
+
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         internal static extern int GetCurrentConference([Out] Conference conference);
 
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetCurrentConferenceAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         internal static extern int GetParticipants(ref int size, out IntPtr participants);
 
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetParticipantsAsync(CompletionHandler done, IntPtr cookie);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetParticipantsVersion(out ulong version);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetParticipantsChanges(ulong since, ParticipantsChangesHandler handler);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int Mute(bool muted);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int MuteAsync(bool muted, CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int RemoteMute(bool muted, string participantId);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int RemoteMuteAsync(bool muted, string participantId, CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int StartAudio();
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int StartAudioAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int StopAudio();
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int StopAudioAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int StartRemoteAudio(string participantId);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int StartRemoteAudioAsync(string participantId, CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int StopRemoteAudio(string participantId);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int StopRemoteAudioAsync(string participantId, CompletionHandler done, IntPtr cookie);
         
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int SetSpatialEnvironment(float scaleX, float scaleY, float scaleZ,
@@ -71,57 +124,129 @@ namespace DolbyIO.Comms
                                                         float upX, float upY, float upZ,
                                                         float rightX, float rightY, float rightZ);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetSpatialEnvironmentAsync(float scaleX, float scaleY, float scaleZ,
+                                                             float forwardX, float forwardY, float forwardZ,
+                                                             float upX, float upY, float upZ,
+                                                             float rightX, float rightY, float rightZ,
+                                                             CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int SetSpatialDirection(float x, float y, float z);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetSpatialDirectionAsync(float x, float y, float z, CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int SetSpatialPosition(string userId, float x, float y, float z);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetSpatialPositionAsync(string userId, float x, float y, float z, CompletionHandler done, IntPtr cookie);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int UpdateSpatialAudioAsync(int count, string[] userIds, Vector3[] positions, float[]? environment, float[]? direction,
+                                                           CompletionHandler done, IntPtr cookie);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetSpatialFilter(bool enabled, float positionX, float positionY, float positionZ,
+                                                    float directionX, float directionY, float directionZ, double maxRate);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetSpatialFilterStatistics(out SpatialFilterStatistics statistics);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int FlushSpatialAudioAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int SendMessage(string message);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SendMessageAsync(string message, CompletionHandler done, IntPtr cookie);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetMessageBatching(int maxFrameSize, int maxDelayMs);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int QueueMessage(string message);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int QueueBinaryMessage(byte[] data, int size, int compressThreshold);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SendBinaryMessageAsync(byte[] data, int size, int compressThreshold, CompletionHandler done, IntPtr cookie);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int FlushMessagesAsync(CompletionHandler done, IntPtr cookie);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetMessageBatchStatistics(out MessageBatchStatistics statistics);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int DeclineInvitation(string conferenceId);
 
-        [DllImport(LibName, CharSet = CharSet.Ansi)]
-        internal static extern bool AudioDeviceEquals(IntPtr id1, IntPtr id2);
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int DeclineInvitationAsync(string conferenceId, CompletionHandler done, IntPtr cookie);
 
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int GetAudioDevices(ref int size, [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 0)] out AudioDevice[] devices);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetAudioDevicesAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         internal static extern int SetPreferredAudioInputDevice(AudioDevice device);
 
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetPreferredAudioInputDeviceAsync(AudioDevice device, CompletionHandler done, IntPtr cookie);
+
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         internal static extern int SetPreferredAudioOutputDevice(AudioDevice device);
 
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetPreferredAudioOutputDeviceAsync(AudioDevice device, CompletionHandler done, IntPtr cookie);
+
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         internal static extern int GetCurrentAudioInputDevice(out AudioDevice device);
 
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetCurrentAudioInputDeviceAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         internal static extern int GetCurrentAudioOutputDevice(out AudioDevice device);
 
         [DllImport(LibName, CharSet = CharSet.Ansi)]
-        internal static extern bool DeleteDeviceIdentity(IntPtr handle);
+        internal static extern int GetCurrentAudioOutputDeviceAsync(CompletionHandler done, IntPtr cookie);
 
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int Leave();
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int LeaveAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int Release();
 
         [DllImport (LibName, CharSet = CharSet.Ansi)]
-        internal static extern string GetLastErrorMsg();
+        internal static extern int GetLastErrorCode();
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetLastErrorMessage([Out] byte[] buffer, int size);
 
         // Video
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern int GetVideoDevices(ref int size, [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 0)] out VideoDevice[] devices);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetVideoDevicesAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
         internal static extern int GetCurrentVideoDevice(out VideoDevice device);
 
         [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
-        internal static extern VideoSinkHandle CreateVideoSink(VideoSink.VideoSinkOnFrame f);
+        internal static extern int GetCurrentVideoDeviceAsync(CompletionHandler done, IntPtr cookie);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern VideoSinkHandle CreateVideoSinkWithMetadata(VideoSink.VideoSinkOnFrame f, VideoPixelFormat format, int targetWidth, int targetHeight);
 
         [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
         internal static extern bool DeleteVideoSink(IntPtr handle);
@@ -129,8 +254,50 @@ namespace DolbyIO.Comms
         [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
         internal static extern bool DeleteVideoFrameBuffer(IntPtr handle);
 
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetVideoSinkPoolDepth(VideoSinkHandle handle, int depth);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetVideoSinkPoolStats(VideoSinkHandle handle, out VideoSinkPoolStatistics stats);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetVideoSinkTargetSize(VideoSinkHandle handle, int width, int height);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetVideoSinkMaxFrameRate(VideoSinkHandle handle, double maxFps);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetVideoSinkDropIfBusy(VideoSinkHandle handle, bool enabled);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetVideoSinkAsyncDelivery(VideoSinkHandle handle, int depth, VideoSinkOverflowPolicy policy);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetVideoSinkSharedMemory(VideoSinkHandle handle, string name, int slotCount, int slotSize);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern VideoFrameRingHandle OpenVideoFrameRing(string name);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern bool CloseVideoFrameRing(IntPtr handle);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern IntPtr ReadVideoFrameRing(VideoFrameRingHandle handle, long afterFrameNumber, out VideoFrameRingInfo info);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern bool ValidateVideoFrameRing(VideoFrameRingHandle handle, ref VideoFrameRingInfo info);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetVideoSinkStats(VideoSinkHandle handle, out VideoSinkStatistics stats);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetVideoConversionThreading(int threads, int minPixelCount);
+
         [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
         internal static extern int SetVideoSink(VideoTrack track, VideoSinkHandle handle);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetVideoSinkAsync(VideoTrack track, VideoSinkHandle handle, CompletionHandler done, IntPtr cookie);
         
         [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
         internal static extern int SetNullVideoSink(VideoTrack track);
@@ -138,18 +305,33 @@ namespace DolbyIO.Comms
         [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
         internal static extern int StartVideo(VideoDevice device, VideoFrameHandlerHandle handler);
 
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int StartVideoAsync(VideoDevice device, VideoFrameHandlerHandle handler, CompletionHandler done, IntPtr cookie);
+
         [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
         internal static extern int StopVideo();
 
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int StopVideoAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         internal static extern int GetScreenShareSources(ref int size, [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 0)] out ScreenShareSource[] sources);
 
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetScreenShareSourcesAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         internal static extern int StartScreenShare(ScreenShareSource source, VideoFrameHandlerHandle handler);
 
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int StartScreenShareAsync(ScreenShareSource source, VideoFrameHandlerHandle handler, CompletionHandler done, IntPtr cookie);
+
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         internal static extern int StopScreenShare();
 
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int StopScreenShareAsync(CompletionHandler done, IntPtr cookie);
+
         [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
         internal static extern VideoFrameHandlerHandle CreateVideoFrameHandler();
 
@@ -159,6 +341,33 @@ namespace DolbyIO.Comms
         [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
         internal static extern int SetVideoFrameHandlerSink(VideoFrameHandlerHandle handle, VideoSinkHandle sink);
 
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetVideoFrameHandlerPreview(VideoFrameHandlerHandle handle, bool enabled, VideoPixelFormat format, int width, int height, double maxFps);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetVideoFrameHandlerSource(VideoFrameHandlerHandle handle, VideoSourceHandle source);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern VideoSourceHandle CreateVideoSource();
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern bool DeleteVideoSource(IntPtr handle);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int PushVideoSourceFrame(VideoSourceHandle handle, VideoPixelFormat format, int width, int height, IntPtr data, int stride, long timestampUs);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int PushVideoSourceFrame(VideoSourceHandle handle, VideoPixelFormat format, int width, int height, byte[] data, int stride, long timestampUs);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int SetVideoSourcePoolDepth(VideoSourceHandle handle, int depth);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetVideoSourcePoolStats(VideoSourceHandle handle, out VideoSinkPoolStatistics stats);
+
+        [DllImport (Native.LibName, CharSet = CharSet.Ansi)]
+        internal static extern int GetVideoSourceStats(VideoSourceHandle handle, out VideoSourceStatistics stats);
+
         // Events Handling
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern void AddOnConferenceStatusUpdatedHandler(int hash, ConferenceStatusUpdatedEventHandler handler);                                      
@@ -178,12 +387,30 @@ namespace DolbyIO.Comms
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern void RemoveOnParticipantUpdatedHandler(int hash, ParticipantUpdatedEventHandler handler);  
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern void AddOnParticipantsBatchHandler(int hash, ParticipantsBatchHandler handler, int windowMs);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int RemoveOnParticipantsBatchHandler(int hash, ParticipantsBatchHandler handler);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern void AddOnConferenceMessageReceivedHandler(int hash, ConferenceMessageReceivedEventHandler handler);
     
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern void RemoveOnConferenceMessageReceivedHandler(int hash, ConferenceMessageReceivedEventHandler handler);
 
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern void AddOnConferenceMessagesReceivedHandler(int hash, ConferenceMessagesBatchHandler handler);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int RemoveOnConferenceMessagesReceivedHandler(int hash, ConferenceMessagesBatchHandler handler);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern void AddOnConferenceBinaryMessageReceivedHandler(int hash, ConferenceBinaryMessageHandler handler);
+
+        [DllImport (LibName, CharSet = CharSet.Ansi)]
+        internal static extern int RemoveOnConferenceBinaryMessageReceivedHandler(int hash, ConferenceBinaryMessageHandler handler);
+
         [DllImport (LibName, CharSet = CharSet.Ansi)]
         internal static extern void AddOnConferenceInvitationReceivedHandler(int hash, ConferenceInvitationReceivedEventHandler handler);
 
@@ -268,11 +495,28 @@ namespace DolbyIO.Comms
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         internal static extern void RemoveOnConferenceVideoTrackRemovedHandler(int hash, VideoTrackRemovedEventHandler handler);
 
+        // Same size as the native buffer, which truncates longer messages
+        private const int MaxErrorMessage = 1024;
+
+        [ThreadStatic]
+        private static byte[]? _errorMessage;
+
+        /// <summary>
+        /// Creates the exception of the last error of the calling thread.
+        /// </summary>
+        internal static DolbyIOException LastError()
+        {
+            byte[] buffer = _errorMessage ??= new byte[MaxErrorMessage];
+            int length = Math.Min(GetLastErrorMessage(buffer, buffer.Length), buffer.Length - 1);
+
+            return new DolbyIOException((ErrorCode)GetLastErrorCode(), Encoding.UTF8.GetString(buffer, 0, length));
+        }
+
         internal static void CheckException(int err)
         {
             if (Result.Success != (Result)err)
             {
-                throw new DolbyIOException(Native.GetLastErrorMsg());
+                throw LastError();
             }
         }
     }
@@ -36,13 +36,13 @@ namespace DolbyIO.Comms
         /// <inheritdoc/>
         public bool Equals(AudioDevice obj)
         {
-            return Native.AudioDeviceEquals(Identity.Value, obj.Identity.Value);
+            return Identity.Equals(obj.Identity);
         }
 
         /// <inheritdoc/>
         public bool Equals(DeviceIdentity id)
         {
-            return Native.AudioDeviceEquals(Identity.Value, id.Value);
+            return Identity.Equals(id);
         }
     }
 }
\ No newline at end of file
@@ -1,15 +1,55 @@
 using System;
 using System.Runtime.InteropServices;
-using System.Runtime.ConstrainedExecution;
 
 namespace DolbyIO.Comms
 {
     /// <summary>
-    /// An Internal representation of an <see cref="AudioDevice"/> identity.
+    /// The identity of an <see cref="AudioDevice"/>. Identities are small handles
+    /// interned by the native layer, the same device always having the same identity
+    /// while it is present, so that they compare without calling into the SDK.
     /// </summary>
-    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
-    public class DeviceIdentity
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct DeviceIdentity : IEquatable<DeviceIdentity>
     {
-        internal readonly IntPtr Value;
+        internal readonly int Value;
+
+        internal DeviceIdentity(int value)
+        {
+            Value = value;
+        }
+
+        /// <summary>
+        /// Gets whether the identity designates a device. An audio device removed
+        /// before it was ever listed has no identity.
+        /// </summary>
+        public bool IsValid => Value != 0;
+
+        /// <inheritdoc/>
+        public bool Equals(DeviceIdentity other)
+        {
+            return Value == other.Value;
+        }
+
+        /// <inheritdoc/>
+        public override bool Equals(object obj)
+        {
+            return obj is DeviceIdentity other && Equals(other);
+        }
+
+        /// <inheritdoc/>
+        public override int GetHashCode()
+        {
+            return Value;
+        }
+
+        /// <summary>
+        /// Compares two identities.
+        /// </summary>
+        public static bool operator ==(DeviceIdentity left, DeviceIdentity right) => left.Equals(right);
+
+        /// <summary>
+        /// Compares two identities.
+        /// </summary>
+        public static bool operator !=(DeviceIdentity left, DeviceIdentity right) => !left.Equals(right);
     }
-}
\ No newline at end of file
+}
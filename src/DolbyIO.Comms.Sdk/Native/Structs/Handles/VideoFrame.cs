@@ -4,7 +4,8 @@ using System.Runtime.InteropServices;
 namespace DolbyIO.Comms
 {
     /// <summary>
-    /// The VideoFrame object wraps the decoded ARGB8888 video frames.
+    /// The VideoFrame object wraps the decoded video frames, in the pixel format
+    /// requested by the <see cref="VideoSink"/>.
     /// </summary>
     public class VideoFrame : SafeHandle 
     {
@@ -18,12 +19,51 @@ namespace DolbyIO.Comms
         /// </summary>
         public int Height;
 
-        internal VideoFrame(int width, int height, IntPtr buffer)
+        /// <summary>
+        /// The pixel format of the video frame.
+        /// </summary>
+        public readonly VideoPixelFormat Format;
+
+        /// <summary>
+        /// The number of planes of the video frame.
+        /// </summary>
+        public readonly int PlaneCount;
+
+        /// <summary>
+        /// Whether the planes point directly into the decoded frame. Such frames are
+        /// delivered without any conversion or copy for the formats matching the
+        /// decoder output, and their planes are only valid until
+        /// <see cref="VideoSink.OnFrame"/> returns.
+        /// </summary>
+        public readonly bool IsTransient;
+
+        /// <summary>
+        /// The timestamps, sequence number and source description of the video frame.
+        /// </summary>
+        public readonly VideoFrameMetadata Metadata;
+
+        private readonly IntPtr[] _planes;
+        private readonly int[] _strides;
+
+        internal VideoFrame(ref NativeVideoFrame frame)
+            : this(ref frame, default)
+        {
+        }
+
+        internal VideoFrame(ref NativeVideoFrame frame, VideoFrameMetadata metadata)
             : base(IntPtr.Zero, true)
         {
-            Width = width;
-            Height = height;
-            SetHandle(buffer);
+            Width = frame.Width;
+            Height = frame.Height;
+            Format = frame.Format;
+            PlaneCount = frame.PlaneCount;
+            IsTransient = frame.Buffer == IntPtr.Zero;
+            Metadata = metadata;
+
+            _planes = new IntPtr[] { frame.Plane0, frame.Plane1, frame.Plane2 };
+            _strides = new int[] { frame.Stride0, frame.Stride1, frame.Stride2 };
+
+            SetHandle(frame.Buffer);
         }
         
         /// <inheritdoc/>
@@ -36,16 +76,90 @@ namespace DolbyIO.Comms
         }
 
         /// <summary>
-        /// Gets a copy of the native video frame as a byte array.
+        /// Gets the address of a plane of the video frame.
+        /// </summary>
+        /// <param name="index">The index of the plane.</param>
+        /// <returns>The address of the first row of the plane.</returns>
+        public IntPtr GetPlane(int index)
+        {
+            CheckPlaneIndex(index);
+            return _planes[index];
+        }
+
+        /// <summary>
+        /// Gets the number of bytes between the starts of two consecutive rows of a plane.
+        /// </summary>
+        /// <param name="index">The index of the plane.</param>
+        /// <returns>The stride of the plane.</returns>
+        public int GetStride(int index)
+        {
+            CheckPlaneIndex(index);
+            return _strides[index];
+        }
+
+        /// <summary>
+        /// Gets a copy of the native video frame as a byte array, with the planes
+        /// stored one after the other and without any row padding.
         /// </summary>
         /// <returns>A byte array containing the video frame.</returns>
         public byte[] GetBuffer()
         {
-            byte[] buffer = new byte[Width * Height * 4];
-            Marshal.Copy(handle, buffer, 0, buffer.Length);
+            int size = 0;
+            for (int i = 0; i < PlaneCount; i++)
+            {
+                GetPlaneSize(i, out int rowBytes, out int rows);
+                size += rowBytes * rows;
+            }
+
+            byte[] buffer = new byte[size];
+            int offset = 0;
+
+            for (int i = 0; i < PlaneCount; i++)
+            {
+                GetPlaneSize(i, out int rowBytes, out int rows);
+                for (int row = 0; row < rows; row++)
+                {
+                    Marshal.Copy(IntPtr.Add(_planes[i], row * _strides[i]), buffer, offset, rowBytes);
+                    offset += rowBytes;
+                }
+            }
 
             return buffer;
         }
+
+        private void CheckPlaneIndex(int index)
+        {
+            if (index < 0 || index >= PlaneCount)
+                throw new ArgumentOutOfRangeException(nameof(index));
+        }
+
+        private void GetPlaneSize(int index, out int rowBytes, out int rows)
+        {
+            int chromaWidth = (Width + 1) / 2;
+            int chromaHeight = (Height + 1) / 2;
+
+            switch (Format)
+            {
+                case VideoPixelFormat.Argb8888:
+                case VideoPixelFormat.Rgba8888:
+                case VideoPixelFormat.Bgra8888:
+                    rowBytes = Width * 4;
+                    rows = Height;
+                    break;
+                case VideoPixelFormat.I420:
+                    rowBytes = index == 0 ? Width : chromaWidth;
+                    rows = index == 0 ? Height : chromaHeight;
+                    break;
+                case VideoPixelFormat.Nv12:
+                    rowBytes = index == 0 ? Width : 2 * chromaWidth;
+                    rows = index == 0 ? Height : chromaHeight;
+                    break;
+                default:
+                    rowBytes = Width;
+                    rows = Height;
+                    break;
+            }
+        }
     }
 
     [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
@@ -57,6 +171,25 @@ namespace DolbyIO.Comms
         [MarshalAs(UnmanagedType.I4)]
         public int Height;
 
+        [MarshalAs(UnmanagedType.I4)]
+        public VideoPixelFormat Format;
+
+        [MarshalAs(UnmanagedType.I4)]
+        public int PlaneCount;
+
+        public IntPtr Plane0;
+        public IntPtr Plane1;
+        public IntPtr Plane2;
+
+        [MarshalAs(UnmanagedType.I4)]
+        public int Stride0;
+
+        [MarshalAs(UnmanagedType.I4)]
+        public int Stride1;
+
+        [MarshalAs(UnmanagedType.I4)]
+        public int Stride2;
+
         public IntPtr Buffer;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,19 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace DolbyIO.Comms
+{
+    internal sealed class VideoFrameRingHandle : SafeHandle
+    {
+        public VideoFrameRingHandle()
+            : base(IntPtr.Zero, true)
+        {}
+
+        public override bool IsInvalid => handle == IntPtr.Zero || handle == new IntPtr(-1);
+
+        protected override bool ReleaseHandle()
+        {
+            return Native.CloseVideoFrameRing(handle);
+        }
+    }
+}
@@ -0,0 +1,24 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace DolbyIO.Comms
+{
+    internal sealed class VideoSourceHandle : SafeHandle
+    {
+        public VideoSourceHandle()
+            : base(IntPtr.Zero, true)
+        {}
+
+        public override bool IsInvalid => handle == IntPtr.Zero || handle == new IntPtr(-1);
+
+        public IntPtr GetIntPtr()
+        {
+            return handle;
+        }
+
+        protected override bool ReleaseHandle()
+        {
+            return Native.DeleteVideoSource(handle);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+using System.Runtime.InteropServices;
+
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The MessageBatchStatistics struct counts the messages batched by
+    /// <see cref="DolbyIO.Comms.Services.ConferenceService.QueueMessage(string)"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+    public struct MessageBatchStatistics
+    {
+        /// <summary>
+        /// The number of messages queued.
+        /// </summary>
+        public readonly ulong Messages;
+
+        /// <summary>
+        /// The number of frames sent.
+        /// </summary>
+        public readonly ulong Frames;
+
+        /// <summary>
+        /// The number of frames that failed to be sent.
+        /// </summary>
+        public readonly ulong FailedFrames;
+    }
+}
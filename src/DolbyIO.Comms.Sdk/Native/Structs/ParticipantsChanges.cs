@@ -0,0 +1,39 @@
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The ParticipantsChanges class holds the changes of the participant roster
+    /// since a given version, as returned by <see cref="DolbyIO.Comms.Services.ConferenceService.GetParticipantsChanges(ulong)"/>.
+    /// </summary>
+    public sealed class ParticipantsChanges
+    {
+        /// <summary>
+        /// The version of the roster the changes bring the caller to, to pass to the next query.
+        /// </summary>
+        public readonly ulong Version;
+
+        /// <summary>
+        /// Whether <see cref="Changed"/> holds every participant of the roster, in which case
+        /// the caller must replace its copy instead of applying the changes.
+        /// </summary>
+        public readonly bool IsSnapshot;
+
+        /// <summary>
+        /// The latest state of the participants added or updated since the requested version,
+        /// or of every participant when <see cref="IsSnapshot"/> is true.
+        /// </summary>
+        public readonly Participant[] Changed;
+
+        /// <summary>
+        /// The identifiers of the participants removed since the requested version.
+        /// </summary>
+        public readonly string[] Removed;
+
+        internal ParticipantsChanges(ulong version, bool isSnapshot, Participant[] changed, string[] removed)
+        {
+            Version = version;
+            IsSnapshot = isSnapshot;
+            Changed = changed;
+            Removed = removed;
+        }
+    }
+}
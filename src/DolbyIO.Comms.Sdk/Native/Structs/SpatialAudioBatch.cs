@@ -0,0 +1,115 @@
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+
+#nullable enable
+
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The SpatialAudioBatch class collects spatial audio changes that
+    /// <see cref="DolbyIO.Comms.Services.ConferenceService.UpdateSpatialAudioAsync(SpatialAudioBatch)"/> applies
+    /// in a single update, instead of one update per participant.
+    /// <example>
+    /// <code>
+    /// _batch.Clear();
+    /// foreach (var avatar in _avatars)
+    ///     _batch.SetPosition(avatar.ParticipantId, avatar.Position);
+    ///
+    /// await _sdk.Conference.UpdateSpatialAudioAsync(_batch);
+    /// </code>
+    /// </example>
+    /// </summary>
+    public sealed class SpatialAudioBatch
+    {
+        private readonly Dictionary<string, int> _index = new Dictionary<string, int>();
+        private string[] _ids = new string[16];
+        private Vector3[] _positions = new Vector3[16];
+        private float[]? _environment;
+        private float[]? _direction;
+
+        /// <summary>
+        /// Gets the number of participant positions in the batch.
+        /// </summary>
+        public int Count { get; private set; }
+
+        /// <summary>
+        /// Sets the position of a participant, replacing the position set earlier in the batch for the same participant.
+        /// See <see cref="DolbyIO.Comms.Services.ConferenceService.SetSpatialPositionAsync(string, Vector3)"/>.
+        /// </summary>
+        /// <param name="participantId">The participant identifier.</param>
+        /// <param name="position">The participant's audio location.</param>
+        public void SetPosition(string participantId, Vector3 position)
+        {
+            if (participantId == null)
+                throw new ArgumentNullException(nameof(participantId));
+
+            if (_index.TryGetValue(participantId, out int i))
+            {
+                _positions[i] = position;
+                return;
+            }
+
+            if (Count == _ids.Length)
+            {
+                Array.Resize(ref _ids, 2 * Count);
+                Array.Resize(ref _positions, 2 * Count);
+            }
+
+            _index.Add(participantId, Count);
+            _ids[Count] = participantId;
+            _positions[Count] = position;
+            Count++;
+        }
+
+        /// <summary>
+        /// Sets the direction the local participant is facing.
+        /// See <see cref="DolbyIO.Comms.Services.ConferenceService.SetSpatialDirectionAsync(Vector3)"/>.
+        /// </summary>
+        /// <param name="direction">The direction the local participant is facing in space.</param>
+        public void SetDirection(Vector3 direction)
+        {
+            _direction = new float[] { direction.X, direction.Y, direction.Z };
+        }
+
+        /// <summary>
+        /// Sets the spatial environment.
+        /// See <see cref="DolbyIO.Comms.Services.ConferenceService.SetSpatialEnvironmentAsync(Vector3, Vector3, Vector3, Vector3)"/>.
+        /// </summary>
+        /// <param name="scale">The application's distance units or scale in application units per one meter.</param>
+        /// <param name="forward">A vector describing the forward direction in the application's coordinate system.</param>
+        /// <param name="up">A vector describing the up direction in the application's coordinate system.</param>
+        /// <param name="right">A vector describing the right direction in the application's coordinate system.</param>
+        public void SetEnvironment(Vector3 scale, Vector3 forward, Vector3 up, Vector3 right)
+        {
+            _environment = new float[]
+            {
+                scale.X, scale.Y, scale.Z,
+                forward.X, forward.Y, forward.Z,
+                up.X, up.Y, up.Z,
+                right.X, right.Y, right.Z
+            };
+        }
+
+        /// <summary>
+        /// Empties the batch, keeping its storage for the next update.
+        /// </summary>
+        public void Clear()
+        {
+            Array.Clear(_ids, 0, Count);
+            _index.Clear();
+            _environment = null;
+            _direction = null;
+            Count = 0;
+        }
+
+        internal string[] Ids => _ids;
+
+        // Vector3 is three contiguous floats, which is the layout the native side reads
+        internal Vector3[] Positions => _positions;
+
+        internal float[]? Environment => _environment;
+
+        internal float[]? Direction => _direction;
+    }
+}
@@ -0,0 +1,33 @@
+using System.Runtime.InteropServices;
+
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The SpatialFilterStatistics struct counts the spatial audio changes that went through the filter set by
+    /// <see cref="DolbyIO.Comms.Services.ConferenceService.ConfigureSpatialFilter(System.Numerics.Vector3, System.Numerics.Vector3, double)"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+    public struct SpatialFilterStatistics
+    {
+        /// <summary>
+        /// The number of positions, directions and environments submitted.
+        /// </summary>
+        public readonly ulong Submitted;
+
+        /// <summary>
+        /// The number of positions, directions and environments sent to the conference.
+        /// </summary>
+        public readonly ulong Forwarded;
+
+        /// <summary>
+        /// The number of positions, directions and environments dropped because they
+        /// moved less than the thresholds, or were replaced before being sent.
+        /// </summary>
+        public readonly ulong Elided;
+
+        /// <summary>
+        /// The number of updates held back by the maximum update rate.
+        /// </summary>
+        public readonly ulong Deferred;
+    }
+}
@@ -9,12 +9,14 @@ namespace DolbyIO.Comms
     /// The video frame handler for local video streams.
     ///
     /// The application can set the video frame handler when starting a local camera stream. Use the frame handler to
-    /// capture camera frames for local camera preview.
+    /// capture camera frames for local camera preview, or to send frames produced by the
+    /// application through a <see cref="VideoSource"/>.
     /// </summary>
     public class VideoFrameHandler : IDisposable
     {
         internal VideoFrameHandlerHandle Handle;
         private VideoSink? _sink;
+        private VideoSource? _source;
 
         /// <summary>
         /// The VideoSink used to handle video frames.
@@ -29,6 +31,56 @@ namespace DolbyIO.Comms
             }
         }
 
+        /// <summary>
+        /// The VideoSource whose frames are sent in place of the camera's.
+        /// </summary>
+        public VideoSource? Source
+        {
+            get => _source;
+            set
+            {
+                _source = value;
+                Native.CheckException(Native.SetVideoFrameHandlerSource(Handle, _source!.Handle));
+            }
+        }
+
+        /// <summary>
+        /// Sets how the camera frames are delivered to <see cref="Sink"/>, in place of the sink's
+        /// own format, size and frame rate. Frames over the rate are dropped before any conversion,
+        /// and the others are scaled and converted in a single pass, so that a small self-view
+        /// costs a fraction of a full size conversion. The frames sent into the conference are
+        /// not affected.
+        /// </summary>
+        /// <param name="format">The pixel format of the preview frames.</param>
+        /// <param name="width">The maximum width of the preview frames, 0 to keep the captured size.</param>
+        /// <param name="height">The maximum height of the preview frames, 0 to keep the captured size.</param>
+        /// <param name="maxFrameRate">The maximum number of preview frames per second, 0 for no limit.</param>
+        /// <exception cref="ArgumentOutOfRangeException">The format is unknown, or one of the other arguments is negative.</exception>
+        public void SetPreviewPolicy(VideoPixelFormat format, int width, int height, double maxFrameRate)
+        {
+            if (!Enum.IsDefined(typeof(VideoPixelFormat), format))
+                throw new ArgumentOutOfRangeException(nameof(format));
+
+            if (width < 0)
+                throw new ArgumentOutOfRangeException(nameof(width));
+
+            if (height < 0)
+                throw new ArgumentOutOfRangeException(nameof(height));
+
+            if (maxFrameRate < 0)
+                throw new ArgumentOutOfRangeException(nameof(maxFrameRate));
+
+            Native.CheckException(Native.SetVideoFrameHandlerPreview(Handle, true, format, width, height, maxFrameRate));
+        }
+
+        /// <summary>
+        /// Removes the preview policy, <see cref="Sink"/> receiving the camera frames with its own configuration.
+        /// </summary>
+        public void ClearPreviewPolicy()
+        {
+            Native.CheckException(Native.SetVideoFrameHandlerPreview(Handle, false, VideoPixelFormat.Argb8888, 0, 0, 0));
+        }
+
         /// <summary>
         /// Create a new VideoFrameHandler.
         /// </summary>
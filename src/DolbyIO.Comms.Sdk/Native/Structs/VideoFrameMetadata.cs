@@ -0,0 +1,63 @@
+using System.Runtime.InteropServices;
+
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The VideoFrameMetadata struct describes the decoded frame a <see cref="VideoFrame"/>
+    /// was produced from.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+    public struct VideoFrameMetadata
+    {
+        /// <summary>
+        /// The timestamp of the decoded frame, in microseconds.
+        /// </summary>
+        public readonly long TimestampUs;
+
+        /// <summary>
+        /// The steady clock time at which the <see cref="VideoSink"/> received the
+        /// frame, in microseconds. Comparing it with <see cref="TimestampUs"/> gives
+        /// the time spent in the media pipeline.
+        /// </summary>
+        public readonly long ReceivedUs;
+
+        /// <summary>
+        /// The number of frames received by the <see cref="VideoSink"/> before this one,
+        /// dropped frames included. Gaps between the delivered frames reveal drops.
+        /// </summary>
+        public readonly ulong SequenceNumber;
+
+        /// <summary>
+        /// The clockwise rotation to apply to the frame, in degrees. Always 0 as
+        /// frames are handed over upright.
+        /// </summary>
+        public readonly int Rotation;
+
+        /// <summary>
+        /// The pixel format of the decoded frame, <see cref="VideoPixelFormat.I420"/>
+        /// or <see cref="VideoPixelFormat.Nv12"/>.
+        /// </summary>
+        [MarshalAs(UnmanagedType.I4)]
+        public readonly VideoPixelFormat SourceFormat;
+
+        /// <summary>
+        /// The width of the decoded frame.
+        /// </summary>
+        public readonly int SourceWidth;
+
+        /// <summary>
+        /// The height of the decoded frame.
+        /// </summary>
+        public readonly int SourceHeight;
+
+        /// <summary>
+        /// The stride of the luma plane of the decoded frame.
+        /// </summary>
+        public readonly int SourceLumaStride;
+
+        /// <summary>
+        /// The stride of the chroma planes of the decoded frame.
+        /// </summary>
+        public readonly int SourceChromaStride;
+    }
+}
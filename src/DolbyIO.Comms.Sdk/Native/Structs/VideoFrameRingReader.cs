@@ -0,0 +1,172 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The VideoFrameRingReader class reads the frames published by a <see cref="VideoSink"/>
+    /// to a shared memory ring, see <see cref="VideoSink.EnableSharedMemoryOutput"/>.
+    /// The reader can live in another process of the same machine.
+    /// </summary>
+    public sealed class VideoFrameRingReader : IDisposable
+    {
+        private readonly VideoFrameRingHandle _handle;
+
+        /// <summary>
+        /// Maps an existing shared memory ring.
+        /// </summary>
+        /// <param name="name">The name given to <see cref="VideoSink.EnableSharedMemoryOutput"/>.</param>
+        /// <exception cref="ArgumentNullException">The name is null or empty.</exception>
+        /// <exception cref="DolbyIOException">The ring does not exist.</exception>
+        public VideoFrameRingReader(string name)
+        {
+            if (string.IsNullOrEmpty(name))
+                throw new ArgumentNullException(nameof(name));
+
+            _handle = Native.OpenVideoFrameRing(name);
+            if (_handle.IsInvalid)
+                throw Native.LastError();
+        }
+
+        /// <summary>
+        /// Gets the newest frame of the ring, without copying it.
+        /// </summary>
+        /// <param name="afterFrameNumber">Only frames published after this one are returned,
+        /// -1 to get any frame.</param>
+        /// <param name="frame">The frame. Its planes point into the ring and are
+        /// overwritten once the writer wraps around, check <see cref="IsValid"/>
+        /// after reading them.</param>
+        /// <returns>true if a newer frame was available.</returns>
+        public bool TryReadLatest(long afterFrameNumber, out VideoFrameRingFrame frame)
+        {
+            IntPtr payload = Native.ReadVideoFrameRing(_handle, afterFrameNumber, out VideoFrameRingInfo info);
+            frame = new VideoFrameRingFrame(info, payload);
+            return payload != IntPtr.Zero;
+        }
+
+        /// <summary>
+        /// Checks that a frame has not been overwritten since it was read. The content
+        /// read from the planes must be discarded when it was.
+        /// </summary>
+        /// <param name="frame">A frame returned by <see cref="TryReadLatest"/>.</param>
+        /// <returns>true if the content of the frame is still intact.</returns>
+        public bool IsValid(in VideoFrameRingFrame frame)
+        {
+            VideoFrameRingInfo info = frame._info;
+            return frame._payload != IntPtr.Zero && Native.ValidateVideoFrameRing(_handle, ref info);
+        }
+
+        /// <inheritdoc/>
+        public void Dispose()
+        {
+            _handle.Dispose();
+        }
+    }
+
+    /// <summary>
+    /// The VideoFrameRingFrame struct describes a frame held in a shared memory ring.
+    /// </summary>
+    public readonly struct VideoFrameRingFrame
+    {
+        internal readonly VideoFrameRingInfo _info;
+        internal readonly IntPtr _payload;
+
+        internal VideoFrameRingFrame(VideoFrameRingInfo info, IntPtr payload)
+        {
+            _info = info;
+            _payload = payload;
+        }
+
+        /// <summary>
+        /// The number of the frame, counted from 0 since the ring was created.
+        /// </summary>
+        public long FrameNumber => (long)_info.FrameNumber;
+
+        /// <summary>
+        /// The capture timestamp of the frame, in microseconds.
+        /// </summary>
+        public long TimestampUs => _info.TimestampUs;
+
+        /// <summary>
+        /// The width of the frame.
+        /// </summary>
+        public int Width => _info.Width;
+
+        /// <summary>
+        /// The height of the frame.
+        /// </summary>
+        public int Height => _info.Height;
+
+        /// <summary>
+        /// The pixel format of the frame.
+        /// </summary>
+        public VideoPixelFormat Format => _info.Format;
+
+        /// <summary>
+        /// The number of planes of the frame.
+        /// </summary>
+        public int PlaneCount => _info.PlaneCount;
+
+        /// <summary>
+        /// Gets the address of a plane of the frame, inside the shared memory.
+        /// </summary>
+        /// <param name="index">The index of the plane.</param>
+        /// <returns>The address of the first row of the plane.</returns>
+        public IntPtr GetPlane(int index)
+        {
+            CheckPlaneIndex(index);
+            uint offset = index == 0 ? _info.Offset0 : index == 1 ? _info.Offset1 : _info.Offset2;
+            return IntPtr.Add(_payload, (int)offset);
+        }
+
+        /// <summary>
+        /// Gets the number of bytes between the starts of two consecutive rows of a plane.
+        /// </summary>
+        /// <param name="index">The index of the plane.</param>
+        /// <returns>The stride of the plane.</returns>
+        public int GetStride(int index)
+        {
+            CheckPlaneIndex(index);
+            return index == 0 ? _info.Stride0 : index == 1 ? _info.Stride1 : _info.Stride2;
+        }
+
+        private void CheckPlaneIndex(int index)
+        {
+            if (index < 0 || index >= PlaneCount)
+                throw new ArgumentOutOfRangeException(nameof(index));
+        }
+    }
+
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+    internal struct VideoFrameRingInfo
+    {
+        public ulong FrameNumber;
+        public long TimestampUs;
+
+        [MarshalAs(UnmanagedType.I4)]
+        public int Width;
+
+        [MarshalAs(UnmanagedType.I4)]
+        public int Height;
+
+        [MarshalAs(UnmanagedType.I4)]
+        public VideoPixelFormat Format;
+
+        [MarshalAs(UnmanagedType.I4)]
+        public int PlaneCount;
+
+        [MarshalAs(UnmanagedType.I4)]
+        public int Stride0;
+
+        [MarshalAs(UnmanagedType.I4)]
+        public int Stride1;
+
+        [MarshalAs(UnmanagedType.I4)]
+        public int Stride2;
+
+        public uint Offset0;
+        public uint Offset1;
+        public uint Offset2;
+        public uint Size;
+    }
+}
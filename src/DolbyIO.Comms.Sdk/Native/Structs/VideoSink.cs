@@ -8,7 +8,7 @@ namespace DolbyIO.Comms
     /// </summary>
     public abstract class VideoSink : IDisposable
     {
-        internal delegate void VideoSinkOnFrame(int width, int height, IntPtr buffer);
+        internal delegate void VideoSinkOnFrame(ref NativeVideoFrame frame, ref VideoFrameMetadata metadata);
 
         internal VideoSinkHandle _handle;
 
@@ -17,17 +17,237 @@ namespace DolbyIO.Comms
         internal VideoSinkOnFrame _delegate;
 
         /// <summary>
-        /// Create a new VideoSink.
+        /// The pixel format of the frames delivered to <see cref="OnFrame"/>.
+        /// </summary>
+        public VideoPixelFormat Format { get; }
+
+        /// <summary>
+        /// Create a new VideoSink receiving ARGB8888 frames.
         /// </summary>
         public VideoSink()
+            : this(VideoPixelFormat.Argb8888)
+        {
+        }
+
+        /// <summary>
+        /// Create a new VideoSink receiving frames in the given pixel format.
+        /// I420 and Y8 frames are passed through without conversion, and so are
+        /// NV12 frames on the platforms decoding to NV12.
+        /// </summary>
+        /// <param name="format">The pixel format of the delivered frames.</param>
+        /// <exception cref="ArgumentOutOfRangeException">The format is unknown.</exception>
+        public VideoSink(VideoPixelFormat format)
+            : this(format, 0, 0)
         {
+        }
+
+        /// <summary>
+        /// Create a new VideoSink receiving frames downscaled to fit in the given size.
+        /// The scaling is done in the same pass as the pixel format conversion.
+        /// </summary>
+        /// <param name="format">The pixel format of the delivered frames.</param>
+        /// <param name="targetWidth">The maximum width of the delivered frames, 0 to keep the decoded size.</param>
+        /// <param name="targetHeight">The maximum height of the delivered frames, 0 to keep the decoded size.</param>
+        /// <exception cref="ArgumentOutOfRangeException">The format is unknown or the size is negative.</exception>
+        public VideoSink(VideoPixelFormat format, int targetWidth, int targetHeight)
+        {
+            if (!Enum.IsDefined(typeof(VideoPixelFormat), format))
+                throw new ArgumentOutOfRangeException(nameof(format));
+
+            CheckTargetSize(targetWidth, targetHeight);
+
+            Format = format;
             _delegate = OnNativeFrame;
-            _handle = Native.CreateVideoSink(_delegate);
+            _handle = Native.CreateVideoSinkWithMetadata(_delegate, format, targetWidth, targetHeight);
+        }
+
+        /// <summary>
+        /// Changes the size the frames are downscaled to fit in. The aspect ratio of the
+        /// decoded frames is kept and frames are never upscaled.
+        /// </summary>
+        /// <param name="width">The maximum width of the delivered frames, 0 to keep the decoded size.</param>
+        /// <param name="height">The maximum height of the delivered frames, 0 to keep the decoded size.</param>
+        /// <exception cref="ArgumentOutOfRangeException">The size is negative.</exception>
+        public void SetTargetSize(int width, int height)
+        {
+            CheckTargetSize(width, height);
+            Native.CheckException(Native.SetVideoSinkTargetSize(_handle, width, height));
+        }
+
+        private static void CheckTargetSize(int width, int height)
+        {
+            if (width < 0)
+                throw new ArgumentOutOfRangeException(nameof(width));
+
+            if (height < 0)
+                throw new ArgumentOutOfRangeException(nameof(height));
+        }
+
+        /// <summary>
+        /// Gets or sets the maximum number of idle frame buffers kept by the sink for reuse.
+        /// Buffers return to the pool when the <see cref="VideoFrame"/> they back is disposed.
+        /// The default depth is 4; a depth of 0 disables the pooling.
+        /// </summary>
+        /// <exception cref="ArgumentOutOfRangeException">The depth is negative.</exception>
+        public int PoolDepth
+        {
+            get => _poolDepth;
+            set
+            {
+                if (value < 0)
+                    throw new ArgumentOutOfRangeException(nameof(value));
+
+                Native.CheckException(Native.SetVideoSinkPoolDepth(_handle, value));
+                _poolDepth = value;
+            }
+        }
+
+        private int _poolDepth = 4;
+
+        /// <summary>
+        /// Gets or sets the maximum number of frames per second delivered to
+        /// <see cref="OnFrame"/>, 0 for no limit. Frames over the limit are dropped
+        /// before being converted.
+        /// </summary>
+        /// <exception cref="ArgumentOutOfRangeException">The rate is negative.</exception>
+        public double MaxFrameRate
+        {
+            get => _maxFrameRate;
+            set
+            {
+                if (value < 0)
+                    throw new ArgumentOutOfRangeException(nameof(value));
+
+                Native.CheckException(Native.SetVideoSinkMaxFrameRate(_handle, value));
+                _maxFrameRate = value;
+            }
+        }
+
+        private double _maxFrameRate = 0;
+
+        /// <summary>
+        /// Gets or sets whether the frames arriving while <see cref="OnFrame"/> is still
+        /// running are dropped before being converted, so that a slow consumer always
+        /// gets the newest frame. Disabled by default.
+        /// </summary>
+        public bool DropIfBusy
+        {
+            get => _dropIfBusy;
+            set
+            {
+                Native.CheckException(Native.SetVideoSinkDropIfBusy(_handle, value));
+                _dropIfBusy = value;
+            }
+        }
+
+        private bool _dropIfBusy = false;
+
+        /// <summary>
+        /// Moves the <see cref="OnFrame"/> calls to a dedicated thread fed by a bounded
+        /// queue, so that a slow consumer no longer delays the decoding of the track.
+        /// Frames are converted on the media thread and, in this mode, are never transient.
+        /// </summary>
+        /// <param name="depth">The number of frames the queue can hold, 0 to call
+        /// <see cref="OnFrame"/> synchronously on the media thread (the default).</param>
+        /// <param name="policy">What to discard when the queue is full.</param>
+        /// <exception cref="ArgumentOutOfRangeException">The depth is negative.</exception>
+        public void SetAsyncDelivery(int depth, VideoSinkOverflowPolicy policy = VideoSinkOverflowPolicy.DropOldest)
+        {
+            if (depth < 0)
+                throw new ArgumentOutOfRangeException(nameof(depth));
+
+            Native.CheckException(Native.SetVideoSinkAsyncDelivery(_handle, depth, policy));
+        }
+
+        /// <summary>
+        /// Publishes the frames to a named shared memory ring instead of calling
+        /// <see cref="OnFrame"/>. Frames are converted directly into the ring, and
+        /// local processes read them in place with a <see cref="VideoFrameRingReader"/>.
+        /// Frames larger than a slot are counted in <see cref="VideoSinkStatistics.DroppedByQueue"/>.
+        /// </summary>
+        /// <param name="name">The name of the shared memory, without path separators.</param>
+        /// <param name="slotCount">The number of frames the ring holds.</param>
+        /// <param name="maxWidth">The maximum width of the published frames.</param>
+        /// <param name="maxHeight">The maximum height of the published frames.</param>
+        /// <exception cref="ArgumentNullException">The name is null or empty.</exception>
+        /// <exception cref="ArgumentOutOfRangeException">One of the sizes is not positive.</exception>
+        /// <exception cref="DolbyIOException">The shared memory cannot be created.</exception>
+        public void EnableSharedMemoryOutput(string name, int slotCount, int maxWidth, int maxHeight)
+        {
+            if (string.IsNullOrEmpty(name))
+                throw new ArgumentNullException(nameof(name));
+
+            if (slotCount <= 0)
+                throw new ArgumentOutOfRangeException(nameof(slotCount));
+
+            if (maxWidth <= 0)
+                throw new ArgumentOutOfRangeException(nameof(maxWidth));
+
+            if (maxHeight <= 0)
+                throw new ArgumentOutOfRangeException(nameof(maxHeight));
+
+            long slotSize = (long)maxWidth * maxHeight * 4;
+            if (slotSize > int.MaxValue)
+                throw new ArgumentOutOfRangeException(nameof(maxWidth));
+
+            Native.CheckException(Native.SetVideoSinkSharedMemory(_handle, name, slotCount, (int)slotSize));
+        }
+
+        /// <summary>
+        /// Stops publishing to the shared memory ring and resumes the calls to <see cref="OnFrame"/>.
+        /// </summary>
+        public void DisableSharedMemoryOutput()
+        {
+            Native.CheckException(Native.SetVideoSinkSharedMemory(_handle, null, 0, 0));
+        }
+
+        /// <summary>
+        /// Gets the number of frames delivered and dropped by the sink.
+        /// </summary>
+        public VideoSinkStatistics Statistics
+        {
+            get
+            {
+                Native.CheckException(Native.GetVideoSinkStats(_handle, out VideoSinkStatistics stats));
+                return stats;
+            }
+        }
+
+        /// <summary>
+        /// Gets the statistics of the frame buffer pool.
+        /// </summary>
+        public VideoSinkPoolStatistics PoolStatistics
+        {
+            get
+            {
+                Native.CheckException(Native.GetVideoSinkPoolStats(_handle, out VideoSinkPoolStatistics stats));
+                return stats;
+            }
+        }
+
+        /// <summary>
+        /// Configures the worker threads, shared by all the sinks, that convert large
+        /// frames in parallel bands of rows before <see cref="OnFrame"/> is invoked.
+        /// </summary>
+        /// <param name="threads">The number of worker threads, 0 converts every frame on the
+        /// calling thread. The count is capped at 16.</param>
+        /// <param name="minPixelCount">The number of pixels (width times height) from which
+        /// a frame is converted in parallel. The default is 2560x1440.</param>
+        /// <exception cref="ArgumentOutOfRangeException">One of the arguments is negative.</exception>
+        public static void SetConversionThreading(int threads, int minPixelCount)
+        {
+            if (threads < 0)
+                throw new ArgumentOutOfRangeException(nameof(threads));
+
+            if (minPixelCount < 0)
+                throw new ArgumentOutOfRangeException(nameof(minPixelCount));
+
+            Native.CheckException(Native.SetVideoConversionThreading(threads, minPixelCount));
         }
 
-        internal void OnNativeFrame(int width, int height, IntPtr buffer)
+        internal void OnNativeFrame(ref NativeVideoFrame native, ref VideoFrameMetadata metadata)
         {
-            VideoFrame frame = new VideoFrame(width, height, buffer);
+            VideoFrame frame = new VideoFrame(ref native, metadata);
             OnFrame(frame);
         }
 
@@ -35,7 +255,9 @@ namespace DolbyIO.Comms
         /// The callback that is invoked when a video frame is decoded and ready
         /// to be processed.
         /// </summary>
-        /// <param name="frame">The video frame.</param>
+        /// <param name="frame">The video frame. Dispose of the frame once done with it so that
+        /// its buffer can be reused for the following frames. Transient frames
+        /// (see <see cref="VideoFrame.IsTransient"/>) must not be used after this method returns.</param>
         public abstract void OnFrame(VideoFrame frame);
 
         /// <inheritdoc/>
@@ -0,0 +1,32 @@
+using System.Runtime.InteropServices;
+
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The VideoSinkPoolStatistics struct describes the state of the pool
+    /// of frame buffers owned by a <see cref="VideoSink"/> or a <see cref="VideoSource"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+    public struct VideoSinkPoolStatistics
+    {
+        /// <summary>
+        /// The number of frames that reused an idle buffer.
+        /// </summary>
+        public readonly ulong Hits;
+
+        /// <summary>
+        /// The number of frames that required a new allocation.
+        /// </summary>
+        public readonly ulong Misses;
+
+        /// <summary>
+        /// The number of frames handed to the application and not yet disposed.
+        /// </summary>
+        public readonly int Outstanding;
+
+        /// <summary>
+        /// The number of buffers waiting in the pool to be reused.
+        /// </summary>
+        public readonly int Idle;
+    }
+}
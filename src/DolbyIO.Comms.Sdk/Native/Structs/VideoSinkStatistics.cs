@@ -0,0 +1,33 @@
+using System.Runtime.InteropServices;
+
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The VideoSinkStatistics struct counts the frames received by a <see cref="VideoSink"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+    public struct VideoSinkStatistics
+    {
+        /// <summary>
+        /// The number of frames delivered to <see cref="VideoSink.OnFrame"/>.
+        /// </summary>
+        public readonly ulong Delivered;
+
+        /// <summary>
+        /// The number of frames dropped to honour <see cref="VideoSink.MaxFrameRate"/>.
+        /// </summary>
+        public readonly ulong DroppedByRate;
+
+        /// <summary>
+        /// The number of frames dropped because <see cref="VideoSink.OnFrame"/> was
+        /// still processing the previous frame, see <see cref="VideoSink.DropIfBusy"/>.
+        /// </summary>
+        public readonly ulong DroppedWhileBusy;
+
+        /// <summary>
+        /// The number of frames discarded because the delivery queue was full,
+        /// see <see cref="VideoSink.SetAsyncDelivery"/>.
+        /// </summary>
+        public readonly ulong DroppedByQueue;
+    }
+}
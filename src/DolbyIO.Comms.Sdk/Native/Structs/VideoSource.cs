@@ -0,0 +1,182 @@
+using System;
+
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The VideoSource class sends frames produced by the application, such as a rendered
+    /// view or a synthetic feed, in place of a camera. Set the source on the
+    /// <see cref="VideoFrameHandler"/> passed to
+    /// <see cref="DolbyIO.Comms.Services.LocalVideoService.StartAsync"/>
+    /// and push the frames as they are produced.
+    ///
+    /// ARGB8888, RGBA8888 and BGRA8888 frames are converted to I420 natively, I420 and NV12
+    /// frames are copied. The frames are encoded with the timestamps they were pushed with,
+    /// and their buffers are pooled so that pushing at a steady resolution does not allocate.
+    /// <example>
+    /// <code>
+    /// _source = new VideoSource();
+    /// _handler = new VideoFrameHandler { Source = _source };
+    /// await _sdk.Video.Local.StartAsync(null, _handler);
+    ///
+    /// // On every rendered frame
+    /// _source.PushFrame(VideoPixelFormat.Rgba8888, width, height, pixels, width * 4, timestampUs);
+    /// </code>
+    /// </example>
+    /// </summary>
+    public sealed class VideoSource : IDisposable
+    {
+        internal VideoSourceHandle Handle { get; }
+
+        /// <summary>
+        /// Create a new VideoSource.
+        /// </summary>
+        public VideoSource()
+        {
+            Handle = Native.CreateVideoSource();
+        }
+
+        /// <summary>
+        /// Gets the size of the buffer holding a frame pushed with the given stride. Packed
+        /// formats hold height rows of stride bytes. Planar formats hold the luma plane,
+        /// followed by the U and V planes with rows of half the stride for I420, or the
+        /// interleaved chroma plane with rows of the stride for NV12.
+        /// </summary>
+        /// <param name="format">The pixel format of the frame.</param>
+        /// <param name="width">The width of the frame.</param>
+        /// <param name="height">The height of the frame.</param>
+        /// <param name="stride">The number of bytes between two rows of the luma, or only, plane.</param>
+        /// <returns>The size of the frame in bytes.</returns>
+        /// <exception cref="ArgumentOutOfRangeException">The format cannot be pushed or the size is invalid.</exception>
+        public static long GetFrameSize(VideoPixelFormat format, int width, int height, int stride)
+        {
+            if (!Enum.IsDefined(typeof(VideoPixelFormat), format) || format == VideoPixelFormat.Y8)
+                throw new ArgumentOutOfRangeException(nameof(format));
+
+            if (width <= 0)
+                throw new ArgumentOutOfRangeException(nameof(width));
+
+            if (height <= 0)
+                throw new ArgumentOutOfRangeException(nameof(height));
+
+            long luma = (long)stride * height;
+            long chromaRows = (height + 1) / 2;
+
+            switch (format)
+            {
+                case VideoPixelFormat.I420:
+                    if (stride < width)
+                        throw new ArgumentOutOfRangeException(nameof(stride));
+                    return luma + 2 * chromaRows * ((stride + 1) / 2);
+
+                case VideoPixelFormat.Nv12:
+                    if (stride < width + width % 2)
+                        throw new ArgumentOutOfRangeException(nameof(stride));
+                    return luma + chromaRows * stride;
+
+                default:
+                    if (stride < 4L * width)
+                        throw new ArgumentOutOfRangeException(nameof(stride));
+                    return luma;
+            }
+        }
+
+        /// <summary>
+        /// Pushes a frame to the SDK. The frame is dropped when the video was not started
+        /// with this source, or to honour the frame rate the SDK encodes at.
+        /// </summary>
+        /// <param name="format">The pixel format of the frame.</param>
+        /// <param name="width">The width of the frame.</param>
+        /// <param name="height">The height of the frame.</param>
+        /// <param name="data">The frame, laid out as described in <see cref="GetFrameSize"/>.</param>
+        /// <param name="stride">The number of bytes between two rows of the luma, or only, plane.</param>
+        /// <param name="timestampUs">The capture time of the frame in microseconds.</param>
+        /// <exception cref="ArgumentNullException">The data is null.</exception>
+        /// <exception cref="ArgumentOutOfRangeException">The format cannot be pushed, the size is invalid
+        /// or the data is too small.</exception>
+        public void PushFrame(VideoPixelFormat format, int width, int height, byte[] data, int stride, long timestampUs)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            if (data.Length < GetFrameSize(format, width, height, stride))
+                throw new ArgumentOutOfRangeException(nameof(data));
+
+            Native.CheckException(Native.PushVideoSourceFrame(Handle, format, width, height, data, stride, timestampUs));
+        }
+
+        /// <summary>
+        /// Pushes a frame held in native memory, such as a mapped render target, to the SDK.
+        /// The memory is only read during the call.
+        /// </summary>
+        /// <param name="format">The pixel format of the frame.</param>
+        /// <param name="width">The width of the frame.</param>
+        /// <param name="height">The height of the frame.</param>
+        /// <param name="data">The frame, at least <see cref="GetFrameSize"/> bytes laid out as described there.</param>
+        /// <param name="stride">The number of bytes between two rows of the luma, or only, plane.</param>
+        /// <param name="timestampUs">The capture time of the frame in microseconds.</param>
+        /// <exception cref="ArgumentNullException">The data is null.</exception>
+        /// <exception cref="ArgumentOutOfRangeException">The format cannot be pushed or the size is invalid.</exception>
+        public void PushFrame(VideoPixelFormat format, int width, int height, IntPtr data, int stride, long timestampUs)
+        {
+            if (data == IntPtr.Zero)
+                throw new ArgumentNullException(nameof(data));
+
+            GetFrameSize(format, width, height, stride);
+            Native.CheckException(Native.PushVideoSourceFrame(Handle, format, width, height, data, stride, timestampUs));
+        }
+
+        /// <summary>
+        /// Gets or sets the maximum number of idle frame buffers kept for reuse.
+        /// Buffers return to the pool once the SDK has encoded the frame they hold.
+        /// The default depth is 4; a depth of 0 disables the pooling.
+        /// </summary>
+        /// <exception cref="ArgumentOutOfRangeException">The depth is negative.</exception>
+        public int PoolDepth
+        {
+            get => _poolDepth;
+            set
+            {
+                if (value < 0)
+                    throw new ArgumentOutOfRangeException(nameof(value));
+
+                Native.CheckException(Native.SetVideoSourcePoolDepth(Handle, value));
+                _poolDepth = value;
+            }
+        }
+
+        private int _poolDepth = 4;
+
+        /// <summary>
+        /// Gets the number of frames pushed, delivered and dropped by the source.
+        /// </summary>
+        public VideoSourceStatistics Statistics
+        {
+            get
+            {
+                Native.CheckException(Native.GetVideoSourceStats(Handle, out VideoSourceStatistics stats));
+                return stats;
+            }
+        }
+
+        /// <summary>
+        /// Gets the statistics of the frame buffer pool.
+        /// </summary>
+        public VideoSinkPoolStatistics PoolStatistics
+        {
+            get
+            {
+                Native.CheckException(Native.GetVideoSourcePoolStats(Handle, out VideoSinkPoolStatistics stats));
+                return stats;
+            }
+        }
+
+        /// <summary>
+        /// Releases the native source. The video must have been stopped, or started
+        /// with another handler, beforehand.
+        /// </summary>
+        public void Dispose()
+        {
+            Handle.Dispose();
+        }
+    }
+}
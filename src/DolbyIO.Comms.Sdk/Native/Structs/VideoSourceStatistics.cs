@@ -0,0 +1,27 @@
+using System.Runtime.InteropServices;
+
+namespace DolbyIO.Comms
+{
+    /// <summary>
+    /// The VideoSourceStatistics struct counts the frames pushed to a <see cref="VideoSource"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+    public struct VideoSourceStatistics
+    {
+        /// <summary>
+        /// The number of frames pushed by the application.
+        /// </summary>
+        public readonly ulong Pushed;
+
+        /// <summary>
+        /// The number of frames handed to the SDK for encoding.
+        /// </summary>
+        public readonly ulong Delivered;
+
+        /// <summary>
+        /// The number of frames dropped because the video was not started with the
+        /// source, or to honour the frame rate requested by the SDK.
+        /// </summary>
+        public readonly ulong Dropped;
+    }
+}
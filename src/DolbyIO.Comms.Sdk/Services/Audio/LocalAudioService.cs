@@ -27,7 +27,7 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task StartAsync()
         {
-            await Task.Run(() => Native.CheckException(Native.StartAudio())).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.StartAudioAsync(done, cookie)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -36,7 +36,7 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task StopAsync()
         {
-            await Task.Run(() => Native.CheckException(Native.StopAudio())).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.StopAudioAsync(done, cookie)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -50,7 +50,7 @@ namespace DolbyIO.Comms.Services
         /// </remarks>
         public async Task MuteAsync(bool muted)
         {
-            await Task.Run(() => Native.CheckException(Native.Mute(muted))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.MuteAsync(muted, done, cookie)).ConfigureAwait(false);
         }
     }
 }
\ No newline at end of file
@@ -28,7 +28,7 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task StartAsync(string participantId)
         {
-            await Task.Run(() => Native.CheckException(Native.StartRemoteAudio(participantId))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.StartRemoteAudioAsync(participantId, done, cookie)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -38,7 +38,7 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task StopAsync(string participantId)
         {
-            await Task.Run(() => Native.CheckException(Native.StopRemoteAudio(participantId))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.StopRemoteAudioAsync(participantId, done, cookie)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -55,7 +55,7 @@ namespace DolbyIO.Comms.Services
         /// </remarks>
         public async Task MuteAsync(bool muted, string participantId)
         {
-            await Task.Run(() => Native.CheckException(Native.RemoteMute(muted, participantId))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.RemoteMuteAsync(muted, participantId, done, cookie)).ConfigureAwait(false);
         }
     }
 }
\ No newline at end of file
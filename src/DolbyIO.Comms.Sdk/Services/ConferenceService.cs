@@ -107,6 +107,71 @@ namespace DolbyIO.Comms.Services
             }
         }
 
+        private readonly Dictionary<ParticipantsUpdatedEventHandler, ParticipantsBatchHandler> _participantsUpdated
+            = new Dictionary<ParticipantsUpdatedEventHandler, ParticipantsBatchHandler>();
+
+        /// <summary>
+        /// Gets or sets the window over which the <see cref="ParticipantsUpdated"/> event coalesces
+        /// the participant updates. Only applies to the handlers added afterwards. The default is 100 ms.
+        /// </summary>
+        public TimeSpan ParticipantsUpdatedWindow { get; set; } = TimeSpan.FromMilliseconds(100);
+
+        /// <summary>
+        /// Sets the <see cref="ParticipantsUpdatedEventHandler"/> that is raised with the participants added or
+        /// updated during the last <see cref="ParticipantsUpdatedWindow"/>. Each participant appears once,
+        /// with its latest state, which makes this event lighter than <see cref="ParticipantAdded"/> and
+        /// <see cref="ParticipantUpdated"/> in large conferences.
+        /// <example>
+        /// <code>
+        /// _sdk.Conference.ParticipantsUpdated += (Participant[] participants) =>
+        /// {
+        ///
+        /// }
+        /// </code>
+        /// </example>
+        /// </summary>
+        /// <value>The <see cref="ParticipantsUpdatedEventHandler"/> event handler.</value>
+        public event ParticipantsUpdatedEventHandler ParticipantsUpdated
+        {
+            add
+            {
+                ParticipantsBatchHandler native = (IntPtr participants, int count) => value(ToParticipants(participants, count));
+                lock (_participantsUpdated)
+                {
+                    _participantsUpdated[value] = native;
+                }
+
+                Native.AddOnParticipantsBatchHandler(value.GetHashCode(), native, (int)ParticipantsUpdatedWindow.TotalMilliseconds);
+            }
+
+            remove
+            {
+                ParticipantsBatchHandler native;
+                lock (_participantsUpdated)
+                {
+                    if (!_participantsUpdated.TryGetValue(value, out native))
+                        return;
+
+                    _participantsUpdated.Remove(value);
+                }
+
+                Native.RemoveOnParticipantsBatchHandler(value.GetHashCode(), native);
+            }
+        }
+
+        internal static Participant[] ToParticipants(IntPtr src, int count)
+        {
+            Participant[] participants = new Participant[count];
+            int size = Marshal.SizeOf<Participant>();
+
+            for (int i = 0; i < count; i++)
+            {
+                participants[i] = Marshal.PtrToStructure<Participant>(IntPtr.Add(src, i * size));
+            }
+
+            return participants;
+        }
+
         private ActiveSpeakerChangeEventHandler _activeSpeakerChange;
 
         /// <summary>
@@ -165,6 +230,104 @@ namespace DolbyIO.Comms.Services
             }
         }
 
+        private readonly Dictionary<ConferenceMessagesReceivedEventHandler, ConferenceMessagesBatchHandler> _messagesReceived
+            = new Dictionary<ConferenceMessagesReceivedEventHandler, ConferenceMessagesBatchHandler>();
+
+        /// <summary>
+        /// Sets the <see cref="ConferenceMessagesReceivedEventHandler"/> that is raised for every received frame, with
+        /// all the messages a participant batched into it through <see cref="QueueMessage(string)"/>. Messages sent
+        /// with <see cref="SendMessageAsync(string)"/> arrive alone.
+        /// </summary>
+        /// <example>
+        /// <code>
+        /// _sdk.Conference.MessagesReceived += (string conferenceId, string userId, ParticipantInfo info, string[] messages) =>
+        /// {
+        ///
+        /// }
+        /// </code>
+        /// </example>
+        /// <value>The <see cref="ConferenceMessagesReceivedEventHandler"/> event handler.</value>
+        public event ConferenceMessagesReceivedEventHandler MessagesReceived
+        {
+            add
+            {
+                ConferenceMessagesBatchHandler native = (string conferenceId, string userId, ParticipantInfo info, int count, string[] messages) =>
+                    value(conferenceId, userId, info, messages);
+                lock (_messagesReceived)
+                {
+                    _messagesReceived[value] = native;
+                }
+
+                Native.AddOnConferenceMessagesReceivedHandler(value.GetHashCode(), native);
+            }
+
+            remove
+            {
+                ConferenceMessagesBatchHandler native;
+                lock (_messagesReceived)
+                {
+                    if (!_messagesReceived.TryGetValue(value, out native))
+                        return;
+
+                    _messagesReceived.Remove(value);
+                }
+
+                Native.RemoveOnConferenceMessagesReceivedHandler(value.GetHashCode(), native);
+            }
+        }
+
+        private readonly Dictionary<ConferenceBinaryMessageReceivedEventHandler, ConferenceBinaryMessageHandler> _binaryMessageReceived
+            = new Dictionary<ConferenceBinaryMessageReceivedEventHandler, ConferenceBinaryMessageHandler>();
+
+        /// <summary>
+        /// Sets the <see cref="ConferenceBinaryMessageReceivedEventHandler"/> that is raised when a participant receives
+        /// a payload sent with <see cref="SendBinaryMessageAsync(byte[])"/> or <see cref="QueueBinaryMessage(byte[])"/>,
+        /// once per payload, including the payloads batched into a frame. The text of the encoded payload is also
+        /// raised by <see cref="MessageReceived"/> and <see cref="MessagesReceived"/>.
+        /// </summary>
+        /// <example>
+        /// <code>
+        /// _sdk.Conference.BinaryMessageReceived += (string conferenceId, string userId, ParticipantInfo info, byte[] data) =>
+        /// {
+        ///
+        /// }
+        /// </code>
+        /// </example>
+        /// <value>The <see cref="ConferenceBinaryMessageReceivedEventHandler"/> event handler.</value>
+        public event ConferenceBinaryMessageReceivedEventHandler BinaryMessageReceived
+        {
+            add
+            {
+                ConferenceBinaryMessageHandler native = (string conferenceId, string userId, ParticipantInfo info, IntPtr data, int size) =>
+                {
+                    byte[] payload = new byte[size];
+                    Marshal.Copy(data, payload, 0, size);
+                    value(conferenceId, userId, info, payload);
+                };
+
+                lock (_binaryMessageReceived)
+                {
+                    _binaryMessageReceived[value] = native;
+                }
+
+                Native.AddOnConferenceBinaryMessageReceivedHandler(value.GetHashCode(), native);
+            }
+
+            remove
+            {
+                ConferenceBinaryMessageHandler native;
+                lock (_binaryMessageReceived)
+                {
+                    if (!_binaryMessageReceived.TryGetValue(value, out native))
+                        return;
+
+                    _binaryMessageReceived.Remove(value);
+                }
+
+                Native.RemoveOnConferenceBinaryMessageReceivedHandler(value.GetHashCode(), native);
+            }
+        }
+
         private ConferenceInvitationReceivedEventHandler _invitationReceived;
 
         /// <summary>
@@ -307,12 +470,8 @@ namespace DolbyIO.Comms.Services
         /// The <xref href="System.Threading.Tasks.Task`1.Result"/> property returns the currently active <see cref="Conference" />.</returns>
         public async Task<Conference> GetCurrentAsync()
         {
-            return await Task.Run(() =>
-            {
-                Conference conference = new Conference();
-                Native.CheckException(Native.GetCurrentConference(conference));
-                return conference;
-            }).ConfigureAwait(false);
+            return await Completion.Run((done, cookie) => Native.GetCurrentConferenceAsync(done, cookie),
+                (value, count) => Completion.ToStructure<Conference>(value)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -322,25 +481,66 @@ namespace DolbyIO.Comms.Services
         /// The <xref href="System.Threading.Tasks.Task`1.Result"/> property returns a <xref href="System.Collections.Generic.List`1" /> of <see cref="Participant" /> objects.</returns>
         public async Task<List<Participant>> GetParticipantsAsync()
         {
-            return await Task.Run(() =>
+            return await Completion.Run((done, cookie) => Native.GetParticipantsAsync(done, cookie),
+                (value, count) => new List<Participant>(ToParticipants(value, count))).ConfigureAwait(false);
+        }
+
+        /// <summary>
+        /// Gets the version of the participant roster, which the SDK keeps up to date from the
+        /// participant events and bumps on every change. Cheap enough to be polled every frame.
+        /// </summary>
+        /// <value>The current roster version, 0 until the first participant is known.</value>
+        public ulong ParticipantsVersion
+        {
+            get
             {
-                List<Participant> participants = new List<Participant>();
-                IntPtr src;
-                int size = 0;
+                ulong version;
+                Native.CheckException(Native.GetParticipantsVersion(out version));
+                return version;
+            }
+        }
 
-                Native.CheckException(Native.GetParticipants(ref size, out src));
+        /// <summary>
+        /// Gets the participants added, updated and removed since a version of the participant roster.
+        /// Unlike <see cref="GetParticipantsAsync"/>, only the participants that changed are copied,
+        /// and nothing when the roster did not change.
+        /// <example>
+        /// <code>
+        /// var changes = _sdk.Conference.GetParticipantsChanges(_version);
+        /// if (changes.IsSnapshot)
+        ///     _participants.Clear();
+        ///
+        /// foreach (var participant in changes.Changed)
+        ///     _participants[participant.Id] = participant;
+        ///
+        /// foreach (var id in changes.Removed)
+        ///     _participants.Remove(id);
+        ///
+        /// _version = changes.Version;
+        /// </code>
+        /// </example>
+        /// </summary>
+        /// <param name="sinceVersion">The <see cref="ParticipantsChanges.Version"/> of the previous query,
+        /// 0 to get a snapshot of the roster.</param>
+        /// <returns>The changes, a snapshot of the roster when <paramref name="sinceVersion"/> is 0 or too old.</returns>
+        public ParticipantsChanges GetParticipantsChanges(ulong sinceVersion = 0)
+        {
+            ParticipantsChanges changes = null;
+            ParticipantsChangesHandler handler = (ulong version, int snapshot, IntPtr changed, int changedCount, IntPtr removed, int removedCount) =>
+                changes = ToParticipantsChanges(version, snapshot, changed, changedCount, removed, removedCount);
 
-                IntPtr[] tmp = new IntPtr[size];
-                Marshal.Copy(src, tmp, 0, size);
+            Native.CheckException(Native.GetParticipantsChanges(sinceVersion, handler));
+            GC.KeepAlive(handler);
+            return changes;
+        }
 
-                for (int i = 0; i < size; i++)
-                {
-                    var participant = Marshal.PtrToStructure<Participant>(tmp[i]);
-                    participants.Add(participant);
-                }
+        internal static ParticipantsChanges ToParticipantsChanges(ulong version, int snapshot, IntPtr changed, int changedCount, IntPtr removed, int removedCount)
+        {
+            IntPtr[] ids = new IntPtr[removedCount];
+            if (removedCount > 0)
+                Marshal.Copy(removed, ids, 0, removedCount);
 
-                return participants;
-            }).ConfigureAwait(false);
+            return new ParticipantsChanges(version, snapshot != 0, ToParticipants(changed, changedCount), Array.ConvertAll(ids, Marshal.PtrToStringAnsi));
         }
 
         /// <summary>
@@ -351,12 +551,8 @@ namespace DolbyIO.Comms.Services
         /// The <xref href="System.Threading.Tasks.Task`1.Result"/> property returns the newly created <see cref="Conference" />.</returns>
         public async Task<Conference> CreateAsync(ConferenceOptions options)
         {
-            return await Task.Run(() => 
-            {
-                Conference conference = new Conference();
-                Native.CheckException(Native.Create(options, conference));
-                return conference;
-            }).ConfigureAwait(false);
+            return await Completion.Run((done, cookie) => Native.CreateAsync(options, done, cookie),
+                (value, count) => Completion.ToStructure<Conference>(value)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -368,13 +564,10 @@ namespace DolbyIO.Comms.Services
         /// The <xref href="System.Threading.Tasks.Task`1.Result"/> property returns the joined <see cref="Conference" /> object.</returns>
         public async Task<Conference> JoinAsync(Conference conference, JoinOptions options)
         {
-            return await Task.Run(() => 
-            {
-                Conference res = new Conference();
-                Native.CheckException(Native.Join(conference, options, res));
-                _isInConference = true;
-                return res;
-            }).ConfigureAwait(false);
+            Conference res = await Completion.Run((done, cookie) => Native.JoinAsync(conference, options, done, cookie),
+                (value, count) => Completion.ToStructure<Conference>(value)).ConfigureAwait(false);
+            _isInConference = true;
+            return res;
         }
 
         /// <summary>
@@ -386,13 +579,10 @@ namespace DolbyIO.Comms.Services
         /// The <xref href="System.Threading.Tasks.Task`1.Result"/> property returns the joined <see cref="Conference" /> object.</returns>
         public async Task<Conference> ListenAsync(Conference conference, ListenOptions options)
         {
-            return await Task.Run(() =>
-            {
-                Conference res = new Conference();
-                Native.CheckException(Native.Listen(conference, options, res));
-                _isInConference = true;
-                return res;
-            }).ConfigureAwait(false);
+            Conference res = await Completion.Run((done, cookie) => Native.ListenAsync(conference, options, done, cookie),
+                (value, count) => Completion.ToStructure<Conference>(value)).ConfigureAwait(false);
+            _isInConference = true;
+            return res;
         }
 
         /// <summary>
@@ -403,13 +593,10 @@ namespace DolbyIO.Comms.Services
         /// The <xref href="System.Threading.Tasks.Task`1.Result"/> property returns the joined <see cref="Conference" /> object.</returns>
         public async Task<Conference> DemoAsync(SpatialAudioStyle audioStyle = SpatialAudioStyle.Individual)
         {
-            return await Task.Run(() => 
-            {
-                Conference conference = new Conference();
-                Native.CheckException(Native.Demo(audioStyle, conference));
-                _isInConference = true;
-                return conference;
-            }).ConfigureAwait(false);
+            Conference conference = await Completion.Run((done, cookie) => Native.DemoAsync(audioStyle, done, cookie),
+                (value, count) => Completion.ToStructure<Conference>(value)).ConfigureAwait(false);
+            _isInConference = true;
+            return conference;
         }
 
         /// <summary>
@@ -438,12 +625,13 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task SetSpatialEnvironmentAsync(Vector3 scale, Vector3 forward, Vector3 up, Vector3 right)
         {
-            await Task.Run(() => Native.CheckException(Native.SetSpatialEnvironment(
+            await Completion.Run((done, cookie) => Native.SetSpatialEnvironmentAsync(
                 scale.X, scale.Y, scale.Z,
                 forward.X, forward.Y, forward.Z,
                 up.X, up.Y, up.Z,
-                right.X, right.Y, right.Z
-            ))).ConfigureAwait(false);
+                right.X, right.Y, right.Z,
+                done, cookie
+            )).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -457,7 +645,7 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task SetSpatialDirectionAsync(Vector3 direction)
         {
-            await Task.Run(() => Native.CheckException(Native.SetSpatialDirection(direction.X, direction.Y, direction.Z))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.SetSpatialDirectionAsync(direction.X, direction.Y, direction.Z, done, cookie)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -476,7 +664,78 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task SetSpatialPositionAsync(string participantId, Vector3 position)
         {
-            await Task.Run(() => Native.CheckException(Native.SetSpatialPosition(participantId, position.X, position.Y, position.Z))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.SetSpatialPositionAsync(participantId, position.X, position.Y, position.Z, done, cookie)).ConfigureAwait(false);
+        }
+
+        /// <summary>
+        /// Applies the positions, and the direction and environment if set, of a <see cref="SpatialAudioBatch"/>
+        /// in a single spatial audio update. This replaces one <see cref="SetSpatialPositionAsync(string, Vector3)"/>
+        /// call per participant when many participants move at once. The batch can be cleared and reused as soon as
+        /// this method returns.
+        /// </summary>
+        /// <param name="batch">The changes to apply.</param>
+        /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
+        public async Task UpdateSpatialAudioAsync(SpatialAudioBatch batch)
+        {
+            if (batch == null)
+                throw new ArgumentNullException(nameof(batch));
+
+            await Completion.Run((done, cookie) => Native.UpdateSpatialAudioAsync(
+                batch.Count, batch.Ids, batch.Positions, batch.Environment, batch.Direction, done, cookie
+            )).ConfigureAwait(false);
+        }
+
+        /// <summary>
+        /// Filters the spatial audio updates, so that applications setting the positions every frame only send the
+        /// changes that can be heard. A position or direction is sent when it moved by more than the threshold of one
+        /// of its axes away from the value last sent, and an environment when it changed. Changes arriving faster than
+        /// maxUpdatesPerSecond are held back, keeping the latest one per participant, and sent once the rate allows.
+        /// The filter applies to <see cref="UpdateSpatialAudioAsync(SpatialAudioBatch)"/> and to the SetSpatial methods,
+        /// and forgets the values sent when leaving the conference.
+        /// </summary>
+        /// <param name="positionThreshold">The smallest position change sent, per axis.</param>
+        /// <param name="directionThreshold">The smallest direction change sent, per axis.</param>
+        /// <param name="maxUpdatesPerSecond">The maximum number of updates per second, 0 for no limit.</param>
+        public void ConfigureSpatialFilter(Vector3 positionThreshold, Vector3 directionThreshold, double maxUpdatesPerSecond)
+        {
+            if (maxUpdatesPerSecond < 0)
+                throw new ArgumentOutOfRangeException(nameof(maxUpdatesPerSecond));
+
+            Native.CheckException(Native.SetSpatialFilter(true,
+                positionThreshold.X, positionThreshold.Y, positionThreshold.Z,
+                directionThreshold.X, directionThreshold.Y, directionThreshold.Z,
+                maxUpdatesPerSecond
+            ));
+        }
+
+        /// <summary>
+        /// Stops filtering the spatial audio updates, which is the default.
+        /// </summary>
+        public void DisableSpatialFilter()
+        {
+            Native.CheckException(Native.SetSpatialFilter(false, 0, 0, 0, 0, 0, 0, 0));
+        }
+
+        /// <summary>
+        /// Sends the spatial audio changes held back by the spatial filter without waiting for the rate to allow.
+        /// </summary>
+        /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
+        public async Task FlushSpatialAudioAsync()
+        {
+            await Completion.Run((done, cookie) => Native.FlushSpatialAudioAsync(done, cookie)).ConfigureAwait(false);
+        }
+
+        /// <summary>
+        /// Gets the statistics of the spatial audio filter.
+        /// </summary>
+        public SpatialFilterStatistics SpatialFilterStatistics
+        {
+            get
+            {
+                SpatialFilterStatistics statistics;
+                Native.CheckException(Native.GetSpatialFilterStatistics(out statistics));
+                return statistics;
+            }
         }
 
         /// <summary>
@@ -489,7 +748,103 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task SendMessageAsync(string message)
         {
-            await Task.Run(() => Native.CheckException(Native.SendMessage(message))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.SendMessageAsync(message, done, cookie)).ConfigureAwait(false);
+        }
+
+        /// <summary>
+        /// Batches the messages of <see cref="QueueMessage(string)"/> into frames, which receivers split back and
+        /// raise through <see cref="MessagesReceived"/>. A frame is sent once the next message would not fit in it,
+        /// or maxDelay after its first message was queued. Changing the batching sends the pending frame and resets
+        /// the <see cref="MessageBatchStatistics"/>.
+        /// </summary>
+        /// <param name="maxFrameSize">The maximum size of a frame in bytes, at most the 16KB a message is limited to.
+        /// A larger message is sent in a frame of its own.</param>
+        /// <param name="maxDelay">The longest time a message waits in a frame.</param>
+        public void ConfigureMessageBatching(int maxFrameSize, TimeSpan maxDelay)
+        {
+            if (maxFrameSize <= 0)
+                throw new ArgumentOutOfRangeException(nameof(maxFrameSize));
+
+            Native.CheckException(Native.SetMessageBatching(maxFrameSize, (int)maxDelay.TotalMilliseconds));
+        }
+
+        /// <summary>
+        /// Sends the pending frame and stops batching the messages of <see cref="QueueMessage(string)"/>, which is the default.
+        /// </summary>
+        public void DisableMessageBatching()
+        {
+            Native.CheckException(Native.SetMessageBatching(0, 0));
+        }
+
+        /// <summary>
+        /// Queues a message for the current conference without waiting for it to be sent. The message is added to
+        /// the pending frame when <see cref="ConfigureMessageBatching(int, TimeSpan)"/> enabled the batching, and
+        /// sent at once otherwise.
+        /// </summary>
+        /// <param name="message">The message to send to the conference.</param>
+        public void QueueMessage(string message)
+        {
+            if (message == null)
+                throw new ArgumentNullException(nameof(message));
+
+            Native.CheckException(Native.QueueMessage(message));
+        }
+
+        /// <summary>
+        /// Gets or sets the size in bytes from which the payloads of <see cref="SendBinaryMessageAsync(byte[])"/> and
+        /// <see cref="QueueBinaryMessage(byte[])"/> are compressed, 0 to never compress them. The default is 256 bytes.
+        /// </summary>
+        public int BinaryCompressionThreshold { get; set; } = 256;
+
+        /// <summary>
+        /// Sends a binary payload to the current conference, raised by <see cref="BinaryMessageReceived"/>. The payload
+        /// is compressed from <see cref="BinaryCompressionThreshold"/> bytes when this makes it smaller, and encoded as
+        /// text, which adds a quarter to its size. The encoded message is limited to 16KB and the payload to 1MB.
+        /// </summary>
+        /// <param name="data">The payload to send to the conference.</param>
+        /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
+        public async Task SendBinaryMessageAsync(byte[] data)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            int threshold = BinaryCompressionThreshold;
+            await Completion.Run((done, cookie) => Native.SendBinaryMessageAsync(data, data.Length, threshold, done, cookie)).ConfigureAwait(false);
+        }
+
+        /// <summary>
+        /// Queues a binary payload like <see cref="QueueMessage(string)"/>, encoded like
+        /// <see cref="SendBinaryMessageAsync(byte[])"/>. The payload can be reused as soon as this method returns.
+        /// </summary>
+        /// <param name="data">The payload to send to the conference.</param>
+        public void QueueBinaryMessage(byte[] data)
+        {
+            if (data == null)
+                throw new ArgumentNullException(nameof(data));
+
+            Native.CheckException(Native.QueueBinaryMessage(data, data.Length, BinaryCompressionThreshold));
+        }
+
+        /// <summary>
+        /// Sends the pending frame of queued messages without waiting for the end of the delay.
+        /// </summary>
+        /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
+        public async Task FlushMessagesAsync()
+        {
+            await Completion.Run((done, cookie) => Native.FlushMessagesAsync(done, cookie)).ConfigureAwait(false);
+        }
+
+        /// <summary>
+        /// Gets the statistics of the message batching.
+        /// </summary>
+        public MessageBatchStatistics MessageBatchStatistics
+        {
+            get
+            {
+                MessageBatchStatistics statistics;
+                Native.CheckException(Native.GetMessageBatchStatistics(out statistics));
+                return statistics;
+            }
         }
 
         /// <summary>
@@ -498,7 +853,7 @@ namespace DolbyIO.Comms.Services
         /// <param name="conferenceId">The conference identifier.</param>
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task DeclineInvitationAsync(string conferenceId) {
-            await Task.Run(() => Native.CheckException(Native.DeclineInvitation(conferenceId))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.DeclineInvitationAsync(conferenceId, done, cookie)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -507,10 +862,8 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task LeaveAsync()
         {
-            await Task.Run(() => {
-                Native.CheckException(Native.Leave());
-                _isInConference = false;
-            }).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.LeaveAsync(done, cookie)).ConfigureAwait(false);
+            _isInConference = false;
         }
     }
 }
@@ -149,21 +149,8 @@ namespace DolbyIO.Comms.Services
         /// that are currently available in the system.</returns>
         public async Task<List<AudioDevice>> GetAudioDevicesAsync()
         {
-            return await Task.Run(() => 
-            {
-                List<AudioDevice> devices = new List<AudioDevice>();
-                AudioDevice[] src = new AudioDevice[0];
-                int size = 0;
-
-                Native.CheckException(Native.GetAudioDevices(ref size, out src));
-                
-                for (int i = 0; i < size; i++)
-                {
-                    devices.Add(src[i]);
-                }
-
-                return devices;
-            }).ConfigureAwait(false);
+            return await Completion.Run((done, cookie) => Native.GetAudioDevicesAsync(done, cookie),
+                (value, count) => new List<AudioDevice>(Completion.ToArray<AudioDevice>(value, count))).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -174,12 +161,8 @@ namespace DolbyIO.Comms.Services
         /// that is currently used by the system.</returns>
         public async Task<AudioDevice> GetCurrentAudioInputDeviceAsync()
         {
-            return await Task.Run(() => 
-            {
-                AudioDevice device;
-                Native.CheckException(Native.GetCurrentAudioInputDevice(out device));
-                return device;
-            }).ConfigureAwait(false);
+            return await Completion.Run((done, cookie) => Native.GetCurrentAudioInputDeviceAsync(done, cookie),
+                (value, count) => Completion.ToStructure<AudioDevice>(value)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -188,12 +171,8 @@ namespace DolbyIO.Comms.Services
         /// <returns>The currently used output audio device.</returns>
         public async Task<AudioDevice> GetCurrentAudioOutputDeviceAsync()
         {
-            return await Task.Run(() => 
-            {
-                AudioDevice device;
-                Native.CheckException(Native.GetCurrentAudioOutputDevice(out device));
-                return device;
-            }).ConfigureAwait(false);
+            return await Completion.Run((done, cookie) => Native.GetCurrentAudioOutputDeviceAsync(done, cookie),
+                (value, count) => Completion.ToStructure<AudioDevice>(value)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -203,7 +182,7 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task SetPreferredAudioInputDeviceAsync(AudioDevice device)
         {
-            await Task.Run(() => Native.CheckException(Native.SetPreferredAudioInputDevice(device))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.SetPreferredAudioInputDeviceAsync(device, done, cookie)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -213,7 +192,7 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task SetPreferredAudioOutputDeviceAsync(AudioDevice device)
         {
-            await Task.Run(() => Native.CheckException(Native.SetPreferredAudioOutputDevice(device))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.SetPreferredAudioOutputDeviceAsync(device, done, cookie)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -224,21 +203,8 @@ namespace DolbyIO.Comms.Services
         /// that are currently available in the system.</returns>
         public async Task<List<VideoDevice>> GetVideoDevicesAsync()
         {
-            return await Task.Run(() => 
-            {
-                List<VideoDevice> devices = new List<VideoDevice>();
-                VideoDevice[] src = new VideoDevice[0];
-                int size = 0;
-
-                Native.CheckException(Native.GetVideoDevices(ref size, out src));
-                
-                for (int i = 0; i < size; i++)
-                {
-                    devices.Add(src[i]);
-                }
-
-                return devices;
-            }).ConfigureAwait(false);
+            return await Completion.Run((done, cookie) => Native.GetVideoDevicesAsync(done, cookie),
+                (value, count) => new List<VideoDevice>(Completion.ToArray<VideoDevice>(value, count))).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -248,12 +214,8 @@ namespace DolbyIO.Comms.Services
         /// that is currently used by the system.</returns>
         public async Task<VideoDevice> GetCurrentVideoDeviceAsync()
         {
-            return await Task.Run(() => 
-            {
-                VideoDevice device;
-                Native.CheckException(Native.GetCurrentVideoDevice(out device));
-                return device;
-            }).ConfigureAwait(false);
+            return await Completion.Run((done, cookie) => Native.GetCurrentVideoDeviceAsync(done, cookie),
+                (value, count) => Completion.ToStructure<VideoDevice>(value)).ConfigureAwait(false);
         }
         
         /// <summary>
@@ -263,21 +225,8 @@ namespace DolbyIO.Comms.Services
         /// <returns>The <xref href="System.Threading.Tasks.Task`1.Result"/> property returns the <see cref="ScreenShareSource">screen share source</see> list.</returns>
         public async Task<List<ScreenShareSource>> GetScreenShareSourcesAsync()
         {
-            return await Task.Run(() => 
-            {
-                List<ScreenShareSource> sources = new List<ScreenShareSource>();
-                ScreenShareSource[] src = new ScreenShareSource[0];
-                int size = 0;
-
-                Native.CheckException(Native.GetScreenShareSources(ref size, out src));
-                
-                for (int i = 0; i < size; i++)
-                {
-                    sources.Add(src[i]);
-                }
-
-                return sources;
-            }).ConfigureAwait(false);
+            return await Completion.Run((done, cookie) => Native.GetScreenShareSourcesAsync(done, cookie),
+                (value, count) => new List<ScreenShareSource>(Completion.ToArray<ScreenShareSource>(value, count))).ConfigureAwait(false);
         }
     }
 }
\ No newline at end of file
@@ -51,14 +51,11 @@ namespace DolbyIO.Comms.Services
         /// representing the participant who opened the session.</returns>
         public async Task<UserInfo> OpenAsync(UserInfo user)
         {
-            return await Task.Run(() => 
-            {
-                UserInfo res = new UserInfo();
-                Native.CheckException(Native.Open(user, res));
-                User = res;
-                _isOpen = true;
-                return res;
-            }).ConfigureAwait(false);
+            UserInfo res = await Completion.Run((done, cookie) => Native.OpenAsync(user, done, cookie),
+                (value, count) => Completion.ToStructure<UserInfo>(value)).ConfigureAwait(false);
+            User = res;
+            _isOpen = true;
+            return res;
         }
 
         /// <summary>
@@ -67,12 +64,9 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task CloseAsync()
         {
-            await Task.Run(() =>
-            {
-                Native.CheckException(Native.Close());
-                User = null;
-                _isOpen = false;
-            }).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.CloseAsync(done, cookie)).ConfigureAwait(false);
+            User = null;
+            _isOpen = false;
         }
     }
 }
\ No newline at end of file
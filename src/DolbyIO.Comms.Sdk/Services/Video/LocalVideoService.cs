@@ -43,7 +43,7 @@ namespace DolbyIO.Comms.Services
             VideoDevice input = device ?? new VideoDevice("", "");
             VideoFrameHandler inputHandler = handler ?? new VideoFrameHandler(new VideoFrameHandlerHandle());
             
-            await Task.Run(() => Native.CheckException(Native.StartVideo(input, inputHandler.Handle))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.StartVideoAsync(input, inputHandler.Handle, done, cookie)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -52,7 +52,7 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task StopAsync()
         {
-            await Task.Run(() => Native.CheckException(Native.StopVideo())).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.StopVideoAsync(done, cookie)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -75,7 +75,7 @@ namespace DolbyIO.Comms.Services
         public async Task StartScreenShareAsync(ScreenShareSource source, VideoFrameHandler? handler = null)
         {
             VideoFrameHandler inputHandler = handler ?? new VideoFrameHandler(new VideoFrameHandlerHandle());
-            await Task.Run(() => Native.CheckException(Native.StartScreenShare(source, inputHandler.Handle))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.StartScreenShareAsync(source, inputHandler.Handle, done, cookie)).ConfigureAwait(false);
         }
 
         /// <summary>
@@ -84,7 +84,7 @@ namespace DolbyIO.Comms.Services
         /// <returns>A <xref href="System.Threading.Tasks.Task"/> that represents the asynchronous operation.</returns>
         public async Task StopScreenShareAsync()
         {
-            await Task.Run(() => Native.CheckException(Native.StopScreenShare())).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.StopScreenShareAsync(done, cookie)).ConfigureAwait(false);
         }
     }
 }
\ No newline at end of file
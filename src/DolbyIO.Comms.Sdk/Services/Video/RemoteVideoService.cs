@@ -21,7 +21,7 @@ namespace DolbyIO.Comms.Services
         {
 
             VideoSinkHandle handle = sink != null ? sink.Handle : new VideoSinkHandle();
-            await Task.Run(() => Native.CheckException(Native.SetVideoSink(track, handle))).ConfigureAwait(false);
+            await Completion.Run((done, cookie) => Native.SetVideoSinkAsync(track, handle, done, cookie)).ConfigureAwait(false);
         
         }
     }
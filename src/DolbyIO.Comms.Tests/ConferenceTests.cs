@@ -104,6 +104,230 @@ namespace DolbyIO.Comms.Tests
             Assert.True(dest.IsAudibleLocally);
         }
 
+        [Fact]
+        public void Test_Participant_ShouldMarshallThroughEventArena()
+        {
+            var received = new List<Participant>();
+            ParticipantUpdatedEventHandler handler = (Participant participant) => received.Add(participant);
+
+            Assert.Equal(0, NativeTests.EventScopeTest(handler, 100));
+            GC.KeepAlive(handler);
+
+            Assert.Equal(100, received.Count);
+            Assert.All(received, participant =>
+            {
+                Assert.Equal("userId", participant.Id);
+                Assert.Equal("Anonymous", participant.Info.Name);
+                Assert.Equal("http://avatar.url", participant.Info.AvatarURL);
+            });
+        }
+
+        [Theory]
+        [InlineData(0)]
+        [InlineData(20)]
+        public void Test_ParticipantsBatch_CoalescesUpdates(int waitWindowMs)
+        {
+            var batches = new List<Participant[]>();
+            ParticipantsBatchHandler handler = (IntPtr participants, int count) =>
+                batches.Add(DolbyIO.Comms.Services.ConferenceService.ToParticipants(participants, count));
+
+            NativeTests.ParticipantBatchTest(handler, 50, 8, waitWindowMs);
+            GC.KeepAlive(handler);
+
+            Assert.Single(batches);
+            Assert.Equal(50, batches[0].Length);
+            for (int i = 0; i < 50; i++)
+            {
+                Assert.Equal("user" + i, batches[0][i].Id);
+                Assert.Equal("name" + i, batches[0][i].Info.Name);
+                Assert.Equal((ParticipantStatus)(7 % 5), batches[0][i].Status);
+            }
+        }
+
+        [Fact]
+        public void Test_ParticipantBatcher_DropsParticipantsOnceStopped()
+        {
+            Assert.Equal(0, NativeTests.ParticipantBatchStopTest(20));
+        }
+
+        [Fact]
+        public void Test_ParticipantRoster_ReturnsOnlyChanges()
+        {
+            var queries = new List<ParticipantsChanges>();
+            ParticipantsChangesHandler handler = (ulong version, int snapshot, IntPtr changed, int changedCount, IntPtr removed, int removedCount) =>
+                queries.Add(DolbyIO.Comms.Services.ConferenceService.ToParticipantsChanges(version, snapshot, changed, changedCount, removed, removedCount));
+
+            NativeTests.ParticipantRosterTest(handler, 50, 10);
+            GC.KeepAlive(handler);
+
+            Assert.Equal(4, queries.Count);
+
+            Assert.True(queries[0].IsSnapshot);
+            Assert.Equal(50UL, queries[0].Version);
+            Assert.Equal(50, queries[0].Changed.Length);
+            Assert.Empty(queries[0].Removed);
+
+            Assert.False(queries[1].IsSnapshot);
+            Assert.Equal(60UL, queries[1].Version);
+            Assert.Equal(10, queries[1].Changed.Length);
+            for (int i = 0; i < 10; i++)
+            {
+                Assert.Equal("user" + i, queries[1].Changed[i].Id);
+                Assert.Equal((ParticipantStatus)2, queries[1].Changed[i].Status);
+            }
+
+            Assert.Equal(60UL, queries[2].Version);
+            Assert.Empty(queries[2].Changed);
+            Assert.Empty(queries[2].Removed);
+
+            Assert.Empty(queries[3].Changed);
+            Assert.Equal(50, queries[3].Removed.Length);
+            Assert.Contains("user49", queries[3].Removed);
+        }
+
+        [Fact]
+        public void Test_SpatialAudioBatch_KeepsLatestPositionPerParticipant()
+        {
+            var batch = new SpatialAudioBatch();
+            for (int i = 0; i < 40; i++)
+            {
+                batch.SetPosition("user" + (i % 20), new System.Numerics.Vector3(i, 0, 0));
+            }
+
+            Assert.Equal(20, batch.Count);
+            Assert.Equal("user19", batch.Ids[19]);
+            Assert.Equal(39f, batch.Positions[19].X);
+
+            batch.Clear();
+            Assert.Equal(0, batch.Count);
+            Assert.Null(batch.Direction);
+        }
+
+        [Fact]
+        public async void Test_Conference_CanCallUpdateSpatialAudio()
+        {
+            var batch = new SpatialAudioBatch();
+            batch.SetDirection(new System.Numerics.Vector3(0, 0, 1));
+            batch.SetPosition("user0", new System.Numerics.Vector3(1, 0, 1));
+
+            await _fixture.Sdk.Conference.UpdateSpatialAudioAsync(batch);
+        }
+
+        [Fact]
+        public void Test_SpatialFilter_ElidesSmallAndSupersededMoves()
+        {
+            SpatialFilterStatistics statistics;
+            int forwarded = NativeTests.SpatialFilterTest(out statistics);
+
+            Assert.Equal(4, forwarded);
+            Assert.Equal(7ul, statistics.Submitted);
+            Assert.Equal(4ul, statistics.Forwarded);
+            Assert.Equal(3ul, statistics.Elided);
+            Assert.Equal(2ul, statistics.Deferred);
+        }
+
+        [Fact]
+        public void Test_SpatialFilter_SendsTrailingChanges()
+        {
+            Assert.Equal(0, NativeTests.SpatialFilterFlushTest());
+        }
+
+        [Fact]
+        public void Test_SpatialFilter_SendsNothingOnceStopped()
+        {
+            Assert.Equal(0, NativeTests.SpatialFilterStopTest());
+        }
+
+        [Fact]
+        public async void Test_Conference_CanFlushSpatialAudio()
+        {
+            _fixture.Sdk.Conference.ConfigureSpatialFilter(new System.Numerics.Vector3(0.1f), new System.Numerics.Vector3(0.05f), 30);
+            await _fixture.Sdk.Conference.FlushSpatialAudioAsync();
+            _fixture.Sdk.Conference.DisableSpatialFilter();
+        }
+
+        [Fact]
+        public void Test_Conference_CanConfigureSpatialFilter()
+        {
+            _fixture.Sdk.Conference.ConfigureSpatialFilter(new System.Numerics.Vector3(0.1f), new System.Numerics.Vector3(0.05f), 30);
+            _fixture.Sdk.Conference.DisableSpatialFilter();
+        }
+
+        [Fact]
+        public void Test_LastError_IsPerThread()
+        {
+            Assert.Equal(0, NativeTests.LastErrorTest(8));
+
+            // The calling thread failed last with a message longer than the error buffer
+            var e = Native.LastError();
+            Assert.Equal(ErrorCode.InvalidArgument, e.Code);
+            Assert.Equal(1023, e.Message.Length);
+        }
+
+        [Fact]
+        public void Test_MessageBatcher_SplitsFramesInOrder()
+        {
+            var received = new List<string>();
+            int frames = NativeTests.MessageBatcherTest((int count, string[] messages) => received.AddRange(messages), 20, 64);
+
+            Assert.Equal(7, frames);
+            Assert.Equal(20, received.Count);
+            Assert.Equal("12:0#dolbyio.frame/1#", received[0]);
+            Assert.Equal("message19", received[19]);
+        }
+
+        [Fact]
+        public void Test_MessageBatcher_SendsEverythingBeforeStopReturns()
+        {
+            Assert.Equal(0, NativeTests.MessageBatcherStopTest());
+        }
+
+        [Fact]
+        public async void Test_Conference_CanQueueMessages()
+        {
+            _fixture.Sdk.Conference.ConfigureMessageBatching(1024, TimeSpan.FromMilliseconds(10));
+            _fixture.Sdk.Conference.QueueMessage("test");
+            await _fixture.Sdk.Conference.FlushMessagesAsync();
+            _fixture.Sdk.Conference.DisableMessageBatching();
+        }
+
+        [Fact]
+        public void Test_BinaryMessage_RoundTrips()
+        {
+            var random = new Random(1);
+            byte[] noise = new byte[1000];
+            random.NextBytes(noise);
+
+            byte[] snapshot = new byte[4096];
+            for (int i = 0; i < snapshot.Length; i++)
+                snapshot[i] = (byte)(i % 16 == 0 ? random.Next(256) : 0);
+
+            foreach (byte[] data in new[] { noise, snapshot })
+            {
+                byte[] output = new byte[data.Length];
+                int length = NativeTests.BinaryMessageTest(data, data.Length, 256, output);
+
+                Assert.NotEqual(-1, length);
+                Assert.Equal(data, output);
+                Assert.True(length < data.Length * 5 / 4 + 32);
+            }
+
+            Assert.True(NativeTests.BinaryMessageTest(snapshot, snapshot.Length, 256, new byte[snapshot.Length]) < snapshot.Length / 2);
+        }
+
+        [Fact]
+        public void Test_BinaryMessage_RejectsOversizedPayloads()
+        {
+            Assert.Equal(0, NativeTests.BinaryMessageLimitTest());
+        }
+
+        [Fact]
+        public async void Test_Conference_CanSendBinaryMessage()
+        {
+            await _fixture.Sdk.Conference.SendBinaryMessageAsync(new byte[] { 0, 1, 2, 3 });
+            _fixture.Sdk.Conference.QueueBinaryMessage(new byte[] { 4, 5, 6 });
+        }
+
         [Fact]
         public async void Test_Conference_CanCallSendMessage()
         {
@@ -38,5 +38,39 @@ namespace DolbyIO.Comms.Tests
             Assert.Throws<DolbyIOException>(() => _sdk.InvalidTokenError += delegate { });
             Assert.Throws<DolbyIOException>(() => _sdk.SignalingChannelError += delegate { });
         }
+
+        [Fact]
+        public void Test_HandlerRegistry_SupportsConcurrentAddAndRemove()
+        {
+            Assert.Equal(0, NativeTests.HandlerRegistryTest(8, 64));
+        }
+
+        [Fact]
+        public void Test_HandlerRegistry_DiscardsRefusedHandlers()
+        {
+            Assert.Equal(0, NativeTests.HandlerDiscardTest());
+        }
+
+        [Fact]
+        public async Task Test_Completion_CompletesFromSdkThread()
+        {
+            var participants = await Completion.Run((done, cookie) => NativeTests.AsyncCallTest(3, false, done, cookie),
+                (value, count) => Completion.ToArray<Participant>(value, count));
+
+            Assert.Equal(3, participants.Length);
+            for (int i = 0; i < 3; i++)
+            {
+                Assert.Equal("user" + i, participants[i].Id);
+                Assert.Equal("name" + i, participants[i].Info.Name);
+            }
+        }
+
+        [Fact]
+        public async Task Test_Completion_FaultsWithSdkError()
+        {
+            var e = await Assert.ThrowsAsync<DolbyIOException>(() => Completion.Run((done, cookie) => NativeTests.AsyncCallTest(0, true, done, cookie)));
+            Assert.Equal("Async failure", e.Message);
+            Assert.Equal(ErrorCode.Unknown, e.Code);
+        }
     }
 }
\ No newline at end of file
@@ -27,10 +27,123 @@ namespace DolbyIO.Comms.Tests
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         public static extern void ParticipantTest([Out] Participant dest);
 
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int HandlerRegistryTest(int threads, int handlers);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int HandlerDiscardTest();
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int AsyncCallTest(int participants, bool fail, CompletionHandler done, IntPtr cookie);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int EventScopeTest(ParticipantUpdatedEventHandler handler, int events);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern void ParticipantBatchTest(ParticipantsBatchHandler handler, int participants, int rounds, int waitWindowMs);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int ParticipantBatchStopTest(int participants);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern void ParticipantRosterTest(ParticipantsChangesHandler handler, int participants, int updated);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int SpatialFilterTest(out SpatialFilterStatistics statistics);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int SpatialFilterFlushTest();
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int SpatialFilterStopTest();
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int LastErrorTest(int threads);
+
+        public delegate void MessagesTestHandler(int count, [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr, SizeParamIndex = 0)] string[] messages);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int MessageBatcherTest(MessagesTestHandler handler, int messages, int maxFrameSize);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int MessageBatcherStopTest();
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int BinaryMessageTest(byte[] data, int size, int compressThreshold, [Out] byte[] output);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int BinaryMessageLimitTest();
+
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         public static extern void AudioDeviceTest(out AudioDevice dest);
 
         [DllImport(LibName, CharSet = CharSet.Ansi)]
         public static extern void VideoDeviceTest(out VideoDevice dest);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int DeviceCacheTest(int devices, [MarshalAs(UnmanagedType.U1)] out bool staleFilled, out int renamedIndex, [MarshalAs(UnmanagedType.U1)] out bool unpluggedFound);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int DeviceHandlesTest(int storm, [MarshalAs(UnmanagedType.U1)] out bool stable, [MarshalAs(UnmanagedType.U1)] out bool keptOnRemoval, [MarshalAs(UnmanagedType.U1)] out bool reclaimed);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int DeviceHandlesReplugTest();
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int YuvToRgbaSimdTest(int layout, int width, int height, int padding, int type);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int YuvToRgbaOrderTest(int order, int layout, int width, int height);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int RgbaToYuvSimdTest(int layout, int order, int width, int height, int padding, int type);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int RgbaToYuvRoundTripTest(int layout, int order, int width, int height, int type);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern void FrameBufferPoolTest(int depth, out VideoSinkPoolStatistics stats);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int RowBandConversionTest(int threads, int width, int height);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int PixelFormatHelpersTest();
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int ScaleConvertTest(int layout, int srcWidth, int srcHeight, int maxWidth, int maxHeight, out int width, out int height);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int FrameRateLimiterTest(double maxFps, double inputFps, int frames, int jitterUs);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int DeliveryQueueTest(int depth, int policy, int items, int consumerDelayUs, out int delivered, out int dropped);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int DropIfBusyTest(bool async, int frames, out VideoSinkStatistics stats);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int DeleteSinkFromDelegateTest();
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int SharedMemoryRingTest(int slotCount, int frames, out int validated);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int SharedMemoryRecreateTest();
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int SharedMemoryBoundsTest();
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int VideoSinkStructSizeTest(int which);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int VideoSourceTest(VideoPixelFormat format, int width, int height, byte[] data, int stride, int frames, [Out] byte[] i420, out VideoSourceStatistics stats, out VideoSinkPoolStatistics poolStats);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        internal static extern int PreviewTapTest(bool enabled, VideoPixelFormat format, int width, int height, double maxFps, int frames, out NativeVideoFrame last, out int delivered, out VideoSinkStatistics stats);
+
+        [DllImport(LibName, CharSet = CharSet.Ansi)]
+        public static extern int PooledFrameRecycleTest();
     }
 }
\ No newline at end of file
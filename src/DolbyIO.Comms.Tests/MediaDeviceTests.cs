@@ -32,6 +32,48 @@ namespace DolbyIO.Comms.Tests
             Assert.Equal("dummy device", dest.Name);
         }
 
+        [Theory]
+        [InlineData(1)]
+        [InlineData(10)]
+        public void Test_DeviceCache_FollowsDeviceEvents(int devices)
+        {
+            int count = NativeTests.DeviceCacheTest(devices, out bool staleFilled, out int renamedIndex, out bool unpluggedFound);
+
+            Assert.False(staleFilled);
+            Assert.Equal(devices, count);
+            Assert.Equal(0, renamedIndex);
+            Assert.False(unpluggedFound);
+        }
+
+        [Theory]
+        [InlineData(10, 12, false)]
+        [InlineData(1000, 66, true)]
+        public void Test_DeviceHandles_SurviveHotPlugStorms(int storm, int size, bool reclaimed)
+        {
+            Assert.Equal(size, NativeTests.DeviceHandlesTest(storm, out bool stable, out bool keptOnRemoval, out bool firstReclaimed));
+            Assert.True(stable);
+            Assert.True(keptOnRemoval);
+            Assert.Equal(reclaimed, firstReclaimed);
+        }
+
+        [Fact]
+        public void Test_DeviceHandles_KeepRepluggedDevicesOnce()
+        {
+            Assert.Equal(0, NativeTests.DeviceHandlesReplugTest());
+        }
+
+        [Fact]
+        public void Test_DeviceIdentity_ComparesHandles()
+        {
+            var a = new DeviceIdentity(1);
+            var b = new DeviceIdentity(2);
+
+            Assert.True(a == new DeviceIdentity(1));
+            Assert.True(a != b);
+            Assert.False(new DeviceIdentity().IsValid);
+            Assert.Equal(a.GetHashCode(), new DeviceIdentity(1).GetHashCode());
+        }
+
         [Fact]
         public async void Test_MediaDevice_CanCallAudioMethods()
         {
@@ -1,3 +1,4 @@
+using System.Runtime.InteropServices;
 using DolbyIO.Comms;
 
 namespace DolbyIO.Comms.Tests
@@ -20,5 +21,333 @@ namespace DolbyIO.Comms.Tests
             await _fixture.Sdk.Video.Local.StartScreenShareAsync(source, null);
             await _fixture.Sdk.Video.Local.StopScreenShareAsync();
         }
+
+        public static IEnumerable<object[]> YuvToRgbaCases()
+        {
+            int[][] sizes = { new[] { 2, 2 }, new[] { 17, 3 }, new[] { 33, 5 }, new[] { 320, 180 }, new[] { 641, 361 }, new[] { 1920, 1080 } };
+
+            for (int layout = 0; layout < 3; layout++)
+            {
+                for (int type = 0; type < 6; type++)
+                {
+                    foreach (var size in sizes)
+                    {
+                        yield return new object[] { layout, size[0], size[1], 0, type };
+                        yield return new object[] { layout, size[0], size[1], 13, type };
+                    }
+                }
+            }
+        }
+
+        [Theory]
+        [MemberData(nameof(YuvToRgbaCases))]
+        public void Test_YuvToRgba_SimdMatchesScalar(int layout, int width, int height, int padding, int type)
+        {
+            Assert.Equal(0, NativeTests.YuvToRgbaSimdTest(layout, width, height, padding, type));
+        }
+
+        [Theory]
+        [InlineData(1, 0, 37, 6)]
+        [InlineData(1, 1, 64, 4)]
+        [InlineData(2, 0, 64, 4)]
+        [InlineData(2, 2, 37, 6)]
+        public void Test_YuvToRgba_WritesByteOrder(int order, int layout, int width, int height)
+        {
+            Assert.Equal(0, NativeTests.YuvToRgbaOrderTest(order, layout, width, height));
+        }
+
+        public static IEnumerable<object[]> RgbaToYuvCases()
+        {
+            int[][] sizes = { new[] { 1, 1 }, new[] { 2, 2 }, new[] { 17, 3 }, new[] { 33, 5 }, new[] { 63, 7 }, new[] { 641, 361 }, new[] { 1920, 1080 } };
+
+            for (int layout = 0; layout < 3; layout++)
+            {
+                for (int order = 0; order < 3; order++)
+                {
+                    for (int type = 0; type < 6; type++)
+                    {
+                        foreach (var size in sizes)
+                        {
+                            yield return new object[] { layout, order, size[0], size[1], 0, type };
+                            yield return new object[] { layout, order, size[0], size[1], 13, type };
+                        }
+                    }
+                }
+            }
+        }
+
+        [Theory]
+        [MemberData(nameof(RgbaToYuvCases))]
+        public void Test_RgbaToYuv_SimdMatchesScalar(int layout, int order, int width, int height, int padding, int type)
+        {
+            Assert.Equal(0, NativeTests.RgbaToYuvSimdTest(layout, order, width, height, padding, type));
+        }
+
+        [Theory]
+        [InlineData(0, 1, 0, 640, 360)]
+        [InlineData(1, 2, 1, 640, 360)]
+        [InlineData(2, 0, 2, 640, 360)]
+        [InlineData(0, 2, 3, 640, 360)]
+        [InlineData(1, 1, 4, 640, 360)]
+        [InlineData(2, 2, 5, 640, 360)]
+        [InlineData(0, 0, 0, 641, 361)]
+        [InlineData(1, 0, 1, 33, 17)]
+        public void Test_RgbaToYuv_RoundTrips(int layout, int order, int type, int width, int height)
+        {
+            // Both directions round to 8 bits, the decoder working with 6 bit chroma factors
+            Assert.True(NativeTests.RgbaToYuvRoundTripTest(layout, order, width, height, type) <= 4);
+        }
+
+        [Theory]
+        [InlineData(0, 0ul, 6ul, 0)]
+        [InlineData(2, 2ul, 4ul, 2)]
+        [InlineData(4, 3ul, 3ul, 2)]
+        public void Test_FrameBufferPool_ReusesBuffers(int depth, ulong hits, ulong misses, int idle)
+        {
+            NativeTests.FrameBufferPoolTest(depth, out VideoSinkPoolStatistics stats);
+
+            Assert.Equal(hits, stats.Hits);
+            Assert.Equal(misses, stats.Misses);
+            Assert.Equal(1, stats.Outstanding);
+            Assert.Equal(idle, stats.Idle);
+        }
+
+        [Theory]
+        [InlineData(0, 3840, 2160)]
+        [InlineData(1, 1920, 1080)]
+        [InlineData(3, 3840, 2160)]
+        [InlineData(4, 1921, 1081)]
+        [InlineData(7, 17, 33)]
+        public void Test_RowBandConversion_MatchesSinglePass(int threads, int width, int height)
+        {
+            Assert.Equal(0, NativeTests.RowBandConversionTest(threads, width, height));
+        }
+
+        [Fact]
+        public void Test_PixelFormatHelpers()
+        {
+            Assert.Equal(0, NativeTests.PixelFormatHelpersTest());
+        }
+
+        [Theory]
+        [InlineData(0, 1920, 1080, 320, 180, 320, 180)]
+        [InlineData(1, 1280, 720, 320, 180, 320, 180)]
+        [InlineData(0, 640, 480, 320, 180, 240, 180)]
+        [InlineData(1, 1281, 721, 321, 181, 320, 180)]
+        [InlineData(0, 320, 180, 640, 360, 320, 180)]
+        [InlineData(1, 1280, 720, 0, 0, 1280, 720)]
+        public void Test_ScaleConvert_MatchesScaleThenConvert(int layout, int srcWidth, int srcHeight, int maxWidth, int maxHeight, int expectedWidth, int expectedHeight)
+        {
+            Assert.Equal(0, NativeTests.ScaleConvertTest(layout, srcWidth, srcHeight, maxWidth, maxHeight, out int width, out int height));
+            Assert.Equal(expectedWidth, width);
+            Assert.Equal(expectedHeight, height);
+        }
+
+        [Theory]
+        [InlineData(0, 30, 300, 2000, 300)]
+        [InlineData(15, 30, 300, 0, 150)]
+        [InlineData(15, 30, 300, 2000, 150)]
+        [InlineData(10, 30, 300, 2000, 100)]
+        [InlineData(24, 60, 600, 1000, 240)]
+        [InlineData(30, 30, 300, 3000, 300)]
+        public void Test_FrameRateLimiter(double maxFps, double inputFps, int frames, int jitterUs, int expected)
+        {
+            Assert.Equal(expected, NativeTests.FrameRateLimiterTest(maxFps, inputFps, frames, jitterUs));
+        }
+
+        [Theory]
+        [InlineData(1, 0, 10000, 0)]
+        [InlineData(4, 0, 10000, 0)]
+        [InlineData(4, 1, 10000, 0)]
+        [InlineData(2, 0, 200, 500)]
+        [InlineData(2, 1, 200, 500)]
+        public void Test_DeliveryQueue_DeliversInOrderOrDiscards(int depth, int policy, int items, int consumerDelayUs)
+        {
+            Assert.Equal(0, NativeTests.DeliveryQueueTest(depth, policy, items, consumerDelayUs, out int delivered, out int dropped));
+            Assert.True(delivered > 0);
+            Assert.True(delivered + dropped <= items);
+        }
+
+        [Theory]
+        [InlineData(false, 5)]
+        [InlineData(true, 5)]
+        public void Test_VideoSink_DropsFramesWhileDelegateRuns(bool async, int frames)
+        {
+            Assert.Equal(0, NativeTests.DropIfBusyTest(async, frames, out VideoSinkStatistics stats));
+            Assert.Equal(1ul, stats.Delivered);
+            Assert.Equal((ulong)(frames - 1), stats.DroppedWhileBusy);
+        }
+
+        [Fact]
+        public void Test_VideoSink_CanBeDisposedFromDelegate()
+        {
+            Assert.Equal(0, NativeTests.DeleteSinkFromDelegateTest());
+        }
+
+        [Theory]
+        [InlineData(1, 2000)]
+        [InlineData(3, 2000)]
+        public void Test_SharedMemoryRing_NeverValidatesTornFrames(int slotCount, int frames)
+        {
+            Assert.Equal(0, NativeTests.SharedMemoryRingTest(slotCount, frames, out int validated));
+            Assert.True(validated > 0);
+        }
+
+        [Fact]
+        public void Test_SharedMemoryRing_SurvivesReplacedRing()
+        {
+            Assert.Equal(0, NativeTests.SharedMemoryRecreateTest());
+        }
+
+        [Fact]
+        public void Test_SharedMemoryRing_SkipsFramesOutsideTheirSlot()
+        {
+            Assert.Equal(0, NativeTests.SharedMemoryBoundsTest());
+        }
+
+        [Fact]
+        public void Test_VideoSink_StructLayoutsMatchNative()
+        {
+            Assert.Equal(Marshal.SizeOf<NativeVideoFrame>(), NativeTests.VideoSinkStructSizeTest(0));
+            Assert.Equal(Marshal.SizeOf<VideoFrameMetadata>(), NativeTests.VideoSinkStructSizeTest(1));
+            Assert.Equal(Marshal.SizeOf<VideoSinkStatistics>(), NativeTests.VideoSinkStructSizeTest(2));
+            Assert.Equal(Marshal.SizeOf<VideoFrameRingInfo>(), NativeTests.VideoSinkStructSizeTest(3));
+        }
+
+        [Theory]
+        [InlineData(VideoPixelFormat.Argb8888, 4, 4)]
+        [InlineData(VideoPixelFormat.Rgba8888, 4, 4)]
+        [InlineData(VideoPixelFormat.Bgra8888, 5, 3)]
+        public void Test_VideoSource_ConvertsRgbToI420(VideoPixelFormat format, int width, int height)
+        {
+            // Pure red, with padding at the end of the rows
+            int stride = width * 4 + 8;
+            int red = format == VideoPixelFormat.Bgra8888 ? 2 : (format == VideoPixelFormat.Rgba8888 ? 0 : 1);
+            byte[] data = new byte[VideoSource.GetFrameSize(format, width, height, stride)];
+            for (int y = 0; y < height; y++)
+                for (int x = 0; x < width; x++)
+                    data[y * stride + 4 * x + red] = 255;
+
+            int lumaSize = width * height;
+            int chromaSize = ((width + 1) / 2) * ((height + 1) / 2);
+            byte[] i420 = new byte[lumaSize + 2 * chromaSize];
+
+            Assert.Equal(0, NativeTests.VideoSourceTest(format, width, height, data, stride, 5, i420, out VideoSourceStatistics stats, out VideoSinkPoolStatistics poolStats));
+
+            Assert.All(i420.Take(lumaSize), b => Assert.Equal(81, b));
+            Assert.All(i420.Skip(lumaSize).Take(chromaSize), b => Assert.Equal(90, b));
+            Assert.All(i420.Skip(lumaSize + chromaSize), b => Assert.Equal(240, b));
+
+            Assert.Equal(6ul, stats.Pushed);
+            Assert.Equal(5ul, stats.Delivered);
+            Assert.Equal(1ul, stats.Dropped);
+            Assert.Equal(4ul, poolStats.Hits);
+            Assert.Equal(1ul, poolStats.Misses);
+            Assert.Equal(0, poolStats.Outstanding);
+        }
+
+        [Fact]
+        public void Test_VideoSource_RecyclesFrames()
+        {
+            Assert.Equal(0, NativeTests.PooledFrameRecycleTest());
+        }
+
+        [Theory]
+        [InlineData(VideoPixelFormat.I420)]
+        [InlineData(VideoPixelFormat.Nv12)]
+        public void Test_VideoSource_CopiesPlanarFrames(VideoPixelFormat format)
+        {
+            // 5x3 frame with a luma stride of 7
+            byte[] data = new byte[VideoSource.GetFrameSize(format, 5, 3, 7)];
+            for (int i = 0; i < data.Length; i++)
+                data[i] = (byte)i;
+
+            byte[] i420 = new byte[15 + 2 * 6];
+            Assert.Equal(0, NativeTests.VideoSourceTest(format, 5, 3, data, 7, 2, i420, out VideoSourceStatistics stats, out VideoSinkPoolStatistics poolStats));
+
+            byte[] chroma = format == VideoPixelFormat.I420
+                ? new byte[] { 21, 22, 23, 25, 26, 27, 29, 30, 31, 33, 34, 35 }
+                : new byte[] { 21, 23, 25, 28, 30, 32, 22, 24, 26, 29, 31, 33 };
+
+            Assert.Equal(new byte[] { 0, 1, 2, 3, 4, 7, 8, 9, 10, 11, 14, 15, 16, 17, 18 }.Concat(chroma), i420);
+            Assert.Equal(2ul, stats.Delivered);
+        }
+
+        [Theory]
+        [InlineData(false, VideoPixelFormat.I420, 320, 180, 0.0, 3, 1280, 720, VideoPixelFormat.Argb8888, 3)]
+        [InlineData(true, VideoPixelFormat.I420, 320, 180, 0.0, 3, 320, 180, VideoPixelFormat.I420, 3)]
+        [InlineData(true, VideoPixelFormat.Argb8888, 320, 180, 0.0, 3, 320, 180, VideoPixelFormat.Argb8888, 3)]
+        [InlineData(true, VideoPixelFormat.Y8, 640, 360, 1.0, 5, 640, 360, VideoPixelFormat.Y8, 1)]
+        [InlineData(true, VideoPixelFormat.Nv12, 0, 0, 0.0, 2, 1280, 720, VideoPixelFormat.Nv12, 2)]
+        public void Test_PreviewPolicy_ShapesOnlyThePreview(bool enabled, VideoPixelFormat format, int width, int height, double maxFps, int frames,
+            int expectedWidth, int expectedHeight, VideoPixelFormat expectedFormat, int expectedDelivered)
+        {
+            Assert.Equal(0, NativeTests.PreviewTapTest(enabled, format, width, height, maxFps, frames, out NativeVideoFrame last, out int delivered, out VideoSinkStatistics stats));
+
+            Assert.Equal(expectedWidth, last.Width);
+            Assert.Equal(expectedHeight, last.Height);
+            Assert.Equal(expectedFormat, last.Format);
+            Assert.Equal(expectedDelivered, delivered);
+            Assert.Equal((ulong)(frames - expectedDelivered), stats.DroppedByRate);
+        }
+
+        [Theory]
+        [InlineData(VideoPixelFormat.Rgba8888, 4, 2, 16, 32L)]
+        [InlineData(VideoPixelFormat.I420, 5, 3, 7, 37L)]
+        [InlineData(VideoPixelFormat.Nv12, 5, 3, 7, 35L)]
+        public void Test_VideoSource_GetFrameSize(VideoPixelFormat format, int width, int height, int stride, long expected)
+        {
+            Assert.Equal(expected, VideoSource.GetFrameSize(format, width, height, stride));
+        }
+
+        [Theory]
+        [InlineData(VideoPixelFormat.Y8, 4, 4, 4)]
+        [InlineData(VideoPixelFormat.Bgra8888, 4, 4, 15)]
+        [InlineData(VideoPixelFormat.Nv12, 5, 3, 5)]
+        [InlineData(VideoPixelFormat.I420, 0, 3, 5)]
+        public void Test_VideoSource_RejectsInvalidFrames(VideoPixelFormat format, int width, int height, int stride)
+        {
+            Assert.Throws<ArgumentOutOfRangeException>(() => VideoSource.GetFrameSize(format, width, height, stride));
+        }
+
+        [Fact]
+        public void Test_VideoFrame_GetBufferPacksPlanes()
+        {
+            // 3x2 I420 frame, luma stride 4 and chroma stride 3
+            byte[] y = { 1, 2, 3, 0, 4, 5, 6, 0 };
+            byte[] u = { 7, 8, 0 };
+            byte[] v = { 9, 10, 0 };
+
+            GCHandle[] pins = { GCHandle.Alloc(y, GCHandleType.Pinned), GCHandle.Alloc(u, GCHandleType.Pinned), GCHandle.Alloc(v, GCHandleType.Pinned) };
+            try
+            {
+                NativeVideoFrame native = new NativeVideoFrame
+                {
+                    Width = 3,
+                    Height = 2,
+                    Format = VideoPixelFormat.I420,
+                    PlaneCount = 3,
+                    Plane0 = pins[0].AddrOfPinnedObject(),
+                    Plane1 = pins[1].AddrOfPinnedObject(),
+                    Plane2 = pins[2].AddrOfPinnedObject(),
+                    Stride0 = 4,
+                    Stride1 = 3,
+                    Stride2 = 3,
+                };
+
+                using (VideoFrame frame = new VideoFrame(ref native))
+                {
+                    Assert.True(frame.IsTransient);
+                    Assert.Equal(3, frame.GetStride(1));
+                    Assert.Equal(new byte[] { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }, frame.GetBuffer());
+                    Assert.Throws<ArgumentOutOfRangeException>(() => frame.GetPlane(3));
+                }
+            }
+            finally
+            {
+                foreach (GCHandle pin in pins)
+                    pin.Free();
+            }
+        }
     }
 }
\ No newline at end of file